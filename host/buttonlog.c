@@ -0,0 +1,196 @@
+//
+// Created on 2026/10/18.
+//
+
+// checks source/buttonlog.c on scripted button edges
+// covers the packed events, the ring wrapping, bounce filtering, press durations and buttonLog_lastInterPress,
+// including timestamps that wrap partway through
+// build with "make host", then run "./gtsbuttonlog"
+// exits with 1 if any of the results don't match what the script did
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../source/buttonlog.h"
+
+// bit indexes in the PAD_BUTTON_* masks
+#define BUTTON_A 8
+#define BUTTON_B 9
+#define BUTTON_X 10
+
+// how many single edges the overflow check writes, more than the ring holds
+#define OVERFLOW_EDGES (BUTTONLOG_LEN + 477)
+
+static bool failed = false;
+
+static void check(bool ok, const char *what) {
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAIL");
+	failed |= !ok;
+}
+
+static ButtonLog buttonLog;
+static uint16_t held;
+
+static void press(uint8_t button, uint32_t timeUs) {
+	held |= (1 << button);
+	buttonLog_record(&buttonLog, held, timeUs);
+}
+
+static void release(uint8_t button, uint32_t timeUs) {
+	held &= ~(1 << button);
+	buttonLog_record(&buttonLog, held, timeUs);
+}
+
+static void start() {
+	held = 0;
+	buttonLog_reset(&buttonLog, held);
+}
+
+static void checkPacking() {
+	printf("packed events\n");
+	bool roundTrip = true;
+	const uint32_t times[] = { 0, 1, 16667, BUTTONLOG_TIME_MASK - 1, BUTTONLOG_TIME_MASK };
+	for (uint8_t button = 0; button < BUTTONLOG_BUTTONS; button++) {
+		for (int edge = 0; edge < 2; edge++) {
+			for (int i = 0; i < sizeof(times) / sizeof(times[0]); i++) {
+				ButtonEvent event = buttonLog_encode(button, edge, times[i]);
+				roundTrip &= buttonLog_button(event) == button && buttonLog_isPress(event) == edge &&
+				             buttonLog_time(event) == times[i];
+			}
+		}
+	}
+	check(roundTrip, "button, edge and time decode");
+
+	// the callback's clock is 64 bits, only the low bits are kept
+	ButtonEvent truncated = buttonLog_encode(BUTTON_A, true, BUTTONLOG_TIME_MASK + 11);
+	check(buttonLog_time(truncated) == 10 && buttonLog_button(truncated) == BUTTON_A && buttonLog_isPress(truncated),
+	      "times past the mask wrap without touching the rest");
+
+	ButtonEvent before = buttonLog_encode(BUTTON_A, true, BUTTONLOG_TIME_MASK - 100);
+	ButtonEvent after = buttonLog_encode(BUTTON_A, false, 50);
+	check(buttonLog_timeDiff(before, after) == 151, "time difference across the wrap");
+	check(buttonLog_timeDiff(after, after) == 0, "time difference to itself");
+}
+
+static void checkOverflow() {
+	printf("ring overflow\n");
+	start();
+	// every call flips A, so every call is one event, at time = its index
+	for (uint32_t i = 0; i < OVERFLOW_EDGES; i++) {
+		if (i % 2 == 0) {
+			press(BUTTON_A, i);
+		} else {
+			release(BUTTON_A, i);
+		}
+	}
+	check(buttonLog.writeCount == OVERFLOW_EDGES, "every event counted");
+	check(buttonLog_count(&buttonLog) == BUTTONLOG_LEN, "count stops at the ring size");
+	bool ordered = true;
+	for (uint32_t i = 0; i < BUTTONLOG_LEN; i++) {
+		uint32_t expected = OVERFLOW_EDGES - BUTTONLOG_LEN + i;
+		ButtonEvent event = buttonLog_get(&buttonLog, i);
+		ordered &= buttonLog_time(event) == expected && buttonLog_isPress(event) == (expected % 2 == 0);
+	}
+	check(ordered, "oldest surviving event first, newest last");
+
+	// the oldest event left is a release, its press was overwritten and shouldn't count
+	// the newest is a press that's still held
+	ButtonStats stats[BUTTONLOG_BUTTONS];
+	buttonLog_analyze(&buttonLog, 0, stats);
+	printf("    %u presses, %u completed\n", stats[BUTTON_A].presses, stats[BUTTON_A].completedPresses);
+	check(!buttonLog_isPress(buttonLog_get(&buttonLog, 0)) && stats[BUTTON_A].presses == BUTTONLOG_LEN / 2 &&
+	      stats[BUTTON_A].completedPresses == BUTTONLOG_LEN / 2 - 1, "release without its press is skipped");
+	check(stats[BUTTON_A].minPressUs == 1 && stats[BUTTON_A].maxPressUs == 1, "one microsecond presses");
+}
+
+static void checkBounce() {
+	printf("bounce filtering and press durations\n");
+	start();
+	// a 200ms press that bounces 2ms into a release at 100ms
+	press(BUTTON_A, 1000);
+	release(BUTTON_A, 100000);
+	press(BUTTON_A, 102000);
+	release(BUTTON_A, 201000);
+	// a clean 50ms press
+	press(BUTTON_A, 300000);
+	release(BUTTON_A, 350000);
+	// two B presses with a 6ms gap, which is outside the window
+	press(BUTTON_B, 400000);
+	release(BUTTON_B, 420000);
+	press(BUTTON_B, 426000);
+	release(BUTTON_B, 436000);
+	// X still held at the end
+	press(BUTTON_X, 500000);
+
+	ButtonStats stats[BUTTONLOG_BUTTONS];
+	buttonLog_analyze(&buttonLog, BUTTONLOG_BOUNCE_WINDOW_US, stats);
+	ButtonStats *a = &stats[BUTTON_A], *b = &stats[BUTTON_B], *x = &stats[BUTTON_X];
+	printf("    A: %u presses, %u bounces, %u-%u us\n", a->presses, a->bounces, a->minPressUs, a->maxPressUs);
+	check(a->presses == 2 && a->bounces == 1, "bounce inside the window merges two presses");
+	check(a->completedPresses == 2 && a->minPressUs == 50000 && a->maxPressUs == 200000 &&
+	      a->totalPressUs == 250000, "merged press lasts until the final release");
+	check(b->presses == 2 && b->bounces == 0 && b->minPressUs == 10000 && b->maxPressUs == 20000,
+	      "gap outside the window is two presses");
+	check(x->presses == 1 && x->completedPresses == 0 && x->minPressUs == 0, "held button has no duration yet");
+
+	// the same log with filtering off counts every press
+	buttonLog_analyze(&buttonLog, 0, stats);
+	check(stats[BUTTON_A].presses == 3 && stats[BUTTON_A].bounces == 0, "window of 0 doesn't filter");
+
+	// a press that spans the timestamp wrapping
+	start();
+	press(BUTTON_A, BUTTONLOG_TIME_MASK - 1000);
+	release(BUTTON_A, BUTTONLOG_TIME_MASK + 1001);
+	buttonLog_analyze(&buttonLog, BUTTONLOG_BOUNCE_WINDOW_US, stats);
+	check(stats[BUTTON_A].completedPresses == 1 && stats[BUTTON_A].maxPressUs == 2001, "press across the wrap");
+}
+
+static void checkInterPress() {
+	printf("last inter-press\n");
+	uint8_t first = 0, second = 0;
+	uint32_t timeUs = 0;
+
+	start();
+	press(BUTTON_A, 1000);
+	release(BUTTON_A, 5000);
+	press(BUTTON_A, 20000);
+	check(!buttonLog_lastInterPress(&buttonLog, &first, &second, &timeUs), "presses of only one button");
+
+	// jump, then airdodge, then the same airdodge again
+	start();
+	press(BUTTON_X, 1000);
+	press(BUTTON_B, 9000);
+	release(BUTTON_X, 30000);
+	press(BUTTON_A, 40000);
+	release(BUTTON_A, 45000);
+	press(BUTTON_A, 60000);
+	bool found = buttonLog_lastInterPress(&buttonLog, &first, &second, &timeUs);
+	printf("    %u -> %u, %u us\n", first, second, timeUs);
+	check(found && first == BUTTON_B && second == BUTTON_A && timeUs == 51000,
+	      "newest press against the last other button");
+
+	// two buttons on the same poll share a timestamp
+	start();
+	held = (1 << BUTTON_A) | (1 << BUTTON_B);
+	buttonLog_record(&buttonLog, held, BUTTONLOG_TIME_MASK - 5);
+	found = buttonLog_lastInterPress(&buttonLog, &first, &second, &timeUs);
+	check(found && first == BUTTON_A && second == BUTTON_B && timeUs == 0, "same poll is written in button order");
+
+	start();
+	press(BUTTON_X, BUTTONLOG_TIME_MASK - 5);
+	press(BUTTON_A, 10);
+	found = buttonLog_lastInterPress(&buttonLog, &first, &second, &timeUs);
+	check(found && timeUs == 16, "time across the wrap");
+}
+
+int main(int argc, char **argv) {
+	checkPacking();
+	checkOverflow();
+	checkBounce();
+	checkInterPress();
+	if (failed) {
+		printf("\nFAILED\n");
+		return 1;
+	}
+	return 0;
+}
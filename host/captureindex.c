@@ -0,0 +1,190 @@
+//
+// Created on 2026/10/18.
+//
+
+// checks source/file/captureindex.c against a real file in a temporary directory
+// covers records reading back, a write cut off mid-record, replacing and removing captures,
+// and compaction, including one that stopped after the old index was deleted
+// build with "make host", then run "./gtscaptureindex"
+// exits with 1 if the loaded index doesn't match what was written
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "../source/file/captureindex.h"
+
+// how many bytes of a record make it to the file before the write is cut off
+#define TORN_BYTES 20
+// replacements written before compaction, enough for index_needsCompaction
+#define REPLACEMENTS 80
+
+static bool failed = false;
+
+static void check(bool ok, const char *what) {
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAIL");
+	failed |= !ok;
+}
+
+static char path[64], tmpPath[64];
+static CaptureIndex captureIndex;
+
+// a different summary for every n, with negative values and every field in use
+static CaptureSummary summaryFor(int n, uint32_t samples) {
+	CaptureSummary summary;
+	memset(&summary, 0, sizeof(summary));
+	snprintf(summary.name, INDEX_NAME_LEN, "2026-10-18_12-00-%02d.csv", n);
+	summary.samples = samples;
+	summary.durationUs = samples * 500 + n;
+	summary.exportTime = 1792324800u + n;
+	summary.testType = (n % 2 == 0) ? -1 : (int8_t) n;
+	summary.flags = (n % 3 == 0) ? INDEX_FLAG_PIVOT : 0;
+	summary.minX = (int8_t) (-100 + n);
+	summary.maxX = (int8_t) (100 - n);
+	summary.minY = (int8_t) (-90 + n);
+	summary.maxY = (int8_t) (90 - n);
+	summary.pivotUs = 0x89ABCDEFu + n;
+	return summary;
+}
+
+static bool matches(int n, uint32_t samples) {
+	CaptureSummary expected = summaryFor(n, samples);
+	int i = index_find(&captureIndex, expected.name);
+	if (i == -1) {
+		return false;
+	}
+	CaptureSummary *entry = &captureIndex.entries[i];
+	return strcmp(entry->name, expected.name) == 0 && entry->samples == expected.samples &&
+	       entry->durationUs == expected.durationUs && entry->exportTime == expected.exportTime &&
+	       entry->testType == expected.testType && entry->flags == expected.flags &&
+	       entry->minX == expected.minX && entry->maxX == expected.maxX &&
+	       entry->minY == expected.minY && entry->maxY == expected.maxY && entry->pivotUs == expected.pivotUs;
+}
+
+static bool isMissing(int n) {
+	CaptureSummary summary = summaryFor(n, 0);
+	return index_find(&captureIndex, summary.name) == -1;
+}
+
+static long fileSize(const char *file) {
+	FILE *fptr = fopen(file, "rb");
+	if (fptr == NULL) {
+		return -1;
+	}
+	fseek(fptr, 0, SEEK_END);
+	long size = ftell(fptr);
+	fclose(fptr);
+	return size;
+}
+
+static bool append(int n, uint32_t samples) {
+	CaptureSummary summary = summaryFor(n, samples);
+	return index_append(path, &summary) == 0;
+}
+
+static void checkAppend() {
+	printf("appending\n");
+	check(index_load(path, tmpPath, &captureIndex) == 0 && captureIndex.count == 0, "missing index loads empty");
+	bool appended = true;
+	for (int n = 0; n < 3; n++) {
+		appended &= append(n, 1000 + n);
+	}
+	check(appended, "records appended");
+	check(index_load(path, tmpPath, &captureIndex) == 0 && captureIndex.count == 3 && captureIndex.records == 3,
+	      "three records load");
+	check(matches(0, 1000) && matches(1, 1001) && matches(2, 1002), "every field reads back");
+	check(fileSize(path) == INDEX_HEADER_BYTES + (3 * INDEX_RECORD_BYTES), "header and three records on disk");
+}
+
+static void checkTorn() {
+	printf("write cut off mid-record\n");
+	append(3, 1003);
+	long size = fileSize(path);
+	check(truncate(path, size - INDEX_RECORD_BYTES + TORN_BYTES) == 0, "record cut short");
+	check(append(4, 1004), "next record appended");
+	check(fileSize(path) == INDEX_HEADER_BYTES + (5 * INDEX_RECORD_BYTES), "torn record padded to a full one");
+	check(index_load(path, tmpPath, &captureIndex) == 0 && captureIndex.records == 5 && captureIndex.count == 4,
+	      "torn record counted but skipped");
+	check(isMissing(3), "torn record isn't an entry");
+	check(matches(4, 1004), "record after it stays aligned");
+	append(5, 1005);
+	check(index_load(path, tmpPath, &captureIndex) == 0 && matches(5, 1005), "and so do later ones");
+}
+
+static void checkReplace() {
+	printf("replacing and removing\n");
+	append(1, 2001);
+	check(index_remove(path, summaryFor(0, 0).name) == 0, "capture removed");
+	check(index_remove(path, "not-a-capture.csv") == 0, "unknown capture removed");
+	check(index_load(path, tmpPath, &captureIndex) == 0 && captureIndex.count == 4 && captureIndex.records == 9,
+	      "entries after replace and remove");
+	check(matches(1, 2001), "newest record for a name wins");
+	check(isMissing(0), "removed capture is gone");
+	check(matches(2, 1002) && matches(4, 1004) && matches(5, 1005), "other captures untouched");
+	// added again after being removed
+	append(0, 3000);
+	check(index_load(path, tmpPath, &captureIndex) == 0 && matches(0, 3000), "removed capture added back");
+}
+
+static void checkCompaction() {
+	printf("compaction\n");
+	check(!index_needsCompaction(&captureIndex), "not needed with few dead records");
+	for (int i = 0; i < REPLACEMENTS; i++) {
+		append(2, 4000 + i);
+	}
+	index_load(path, tmpPath, &captureIndex);
+	uint32_t count = captureIndex.count;
+	printf("    %u entries in %u records\n", captureIndex.count, captureIndex.records);
+	check(index_needsCompaction(&captureIndex), "needed once most records are dead");
+	check(index_compact(path, tmpPath, &captureIndex) == 0 && captureIndex.records == count, "compacted");
+	check(fileSize(path) == INDEX_HEADER_BYTES + (count * INDEX_RECORD_BYTES) && fileSize(tmpPath) == -1,
+	      "only live records left, temporary file swapped in");
+	check(index_load(path, tmpPath, &captureIndex) == 0 && captureIndex.count == count &&
+	      captureIndex.records == count, "compacted index loads");
+	check(matches(0, 3000) && matches(1, 2001) && matches(2, 4000 + REPLACEMENTS - 1) && matches(4, 1004) &&
+	      matches(5, 1005), "same entries as before");
+
+	// compaction stopped after the old index was deleted, before the rename
+	index_compact(path, tmpPath, &captureIndex);
+	rename(path, tmpPath);
+	check(fileSize(path) == -1 && fileSize(tmpPath) > 0, "only the temporary file left");
+	check(index_load(path, tmpPath, &captureIndex) == 0 && captureIndex.count == count,
+	      "loads from the temporary file");
+	check(matches(2, 4000 + REPLACEMENTS - 1) && fileSize(path) > 0 && fileSize(tmpPath) == -1,
+	      "temporary file renamed into place");
+	check(append(6, 1006) && index_load(path, tmpPath, &captureIndex) == 0 && matches(6, 1006),
+	      "appending works after recovering");
+}
+
+static void checkNotAnIndex() {
+	printf("other files\n");
+	FILE *fptr = fopen(path, "wb");
+	fputs("Stick X,Stick Y\n", fptr);
+	fclose(fptr);
+	check(index_load(path, tmpPath, &captureIndex) == 1 && captureIndex.count == 0, "rejected");
+}
+
+int main(int argc, char **argv) {
+	char dir[] = "/tmp/gtsindexXXXXXX";
+	if (mkdtemp(dir) == NULL) {
+		printf("couldn't make a temporary directory\n");
+		return 1;
+	}
+	snprintf(path, sizeof(path), "%s/index.bin", dir);
+	snprintf(tmpPath, sizeof(tmpPath), "%s/index.tmp", dir);
+
+	checkAppend();
+	checkTorn();
+	checkReplace();
+	checkCompaction();
+	checkNotAnIndex();
+
+	remove(path);
+	remove(tmpPath);
+	rmdir(dir);
+	if (failed) {
+		printf("\nFAILED\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,323 @@
+//
+// Created on 2026/10/18.
+//
+
+// checks the fixed point analyzers in source/analysis against the float versions they replaced, then times both
+// build with "make host", then run "./gtsfixed [-n iterations]"
+// exits with 1 if the integer square root is ever wrong, or anything else is outside the limits below
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "../source/analysis/analysis.h"
+#include "../source/analysis/fixed.h"
+
+// the float version rounds before truncating, so it can land one stick unit off (0.0125, 125 in melee units)
+#define MAX_COORD_ERROR 125
+#define MAX_PERCENT_ERROR 0.01
+#define MAX_MS_ERROR 0.001
+
+static uint64_t nowNs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec * 1000000000ull) + ts.tv_nsec;
+}
+
+// the float versions, as they were before the fixed point ones
+static const float FLOAT_FRAME_TIME_MS = (1000/60.0);
+
+static WaveformDatapoint floatConvert(WaveformDatapoint *data) {
+	WaveformDatapoint retData = *data;
+	float floatStickX = retData.ax, floatStickY = retData.ay;
+	float floatCStickX = retData.cx, floatCStickY = retData.cy;
+	float stickMagnitude = sqrt((retData.ax * retData.ax) + (retData.ay * retData.ay));
+	float cStickMagnitude = sqrt((retData.cx * retData.cx) + (retData.cy * retData.cy));
+	if (stickMagnitude > 80) {
+		floatStickX = (floatStickX / stickMagnitude) * 80;
+		floatStickY = (floatStickY / stickMagnitude) * 80;
+	}
+	if (cStickMagnitude > 80) {
+		floatCStickX = (floatCStickX / cStickMagnitude) * 80;
+		floatCStickY = (floatCStickY / cStickMagnitude) * 80;
+	}
+	retData.ax = (int) floatStickX, retData.ay = (int) floatStickY;
+	retData.cx = (int) floatCStickX, retData.cy = (int) floatCStickY;
+	retData.ax = (((float) retData.ax) * 0.0125) * 10000;
+	retData.ay = (((float) retData.ay) * 0.0125) * 10000;
+	retData.cx = (((float) retData.cx) * 0.0125) * 10000;
+	retData.cy = (((float) retData.cy) * 0.0125) * 10000;
+	retData.ax = abs(retData.ax), retData.ay = abs(retData.ay);
+	retData.cx = abs(retData.cx), retData.cy = abs(retData.cy);
+	return retData;
+}
+
+// the percentages from the time analysis_pivot found
+static void floatPivot(uint64_t timeInRangeUs, PivotResult *result) {
+	result->noTurnPercent = 0;
+	result->pivotPercent = 0;
+	result->dashbackPercent = 0;
+	result->timeInRangeMs = (timeInRangeUs / 1000.0);
+	float diffFrameTimePoll = FLOAT_FRAME_TIME_MS - result->timeInRangeMs;
+	if (diffFrameTimePoll < 0) {
+		result->dashbackPercent = ((diffFrameTimePoll * -1) / FLOAT_FRAME_TIME_MS) * 100;
+		if (result->dashbackPercent > 100) {
+			result->dashbackPercent = 100;
+		}
+		result->pivotPercent = 100 - result->dashbackPercent;
+	} else {
+		result->noTurnPercent = (diffFrameTimePoll / FLOAT_FRAME_TIME_MS) * 100;
+		if (result->noTurnPercent > 100) {
+			result->noTurnPercent = 100;
+		}
+		result->pivotPercent = 100 - result->noTurnPercent;
+	}
+}
+
+static void floatDashback(const WaveformData *data, DashbackResult *result) {
+	int dashbackStartIndex = -1, dashbackEndIndex = -1;
+	uint64_t timeInRange = 0;
+	for (int i = 0; i < data->endPoint; i++) {
+		if ((data->data[i].ax >= 23 && data->data[i].ax < 64) || (data->data[i].ax <= -23 && data->data[i].ax > -64)) {
+			timeInRange += data->data[i].timeDiffUs;
+			if (dashbackStartIndex == -1) {
+				dashbackStartIndex = i;
+			}
+		} else if (dashbackStartIndex != -1) {
+			dashbackEndIndex = i - 1;
+			break;
+		}
+	}
+	if (dashbackEndIndex == -1) {
+		*result = (DashbackResult) { 0 };
+		return;
+	}
+	float timeInRangeMs = (timeInRange / 1000.0);
+	result->timeInRangeMs = timeInRangeMs;
+	result->vanillaPercent = (1.0 - (timeInRangeMs / FLOAT_FRAME_TIME_MS)) * 100;
+	uint64_t ucfTimeInRange = timeInRange;
+	for (int i = dashbackStartIndex; i <= dashbackEndIndex; i++) {
+		uint64_t usFromPoll = 0;
+		int nextPollIndex = i;
+		while (usFromPoll < 16666 && nextPollIndex < data->endPoint - 1) {
+			nextPollIndex++;
+			usFromPoll += data->data[nextPollIndex].timeDiffUs;
+		}
+		if (data->data[i].ax + data->data[nextPollIndex].ax > 75 ||
+				data->data[i].ax + data->data[nextPollIndex].ax < -75) {
+			ucfTimeInRange -= data->data[i].timeDiffUs;
+		}
+	}
+	float ucfTimeInRangeMs = ucfTimeInRange / 1000.0;
+	if (ucfTimeInRangeMs <= 0) {
+		result->ucfPercent = 100;
+	} else {
+		result->ucfPercent = (1.0 - (ucfTimeInRangeMs / FLOAT_FRAME_TIME_MS)) * 100;
+	}
+	result->vanillaPercent = fmaxf(0, fminf(100, result->vanillaPercent));
+	result->ucfPercent = fmaxf(0, fminf(100, result->ucfPercent));
+}
+
+// appends count polls at value, stepUs apart give or take some jitter
+static void addPolls(WaveformData *data, int value, int count, int stepUs) {
+	for (int i = 0; i < count && data->endPoint < WAVEFORM_SAMPLES; i++) {
+		data->data[data->endPoint].ax = value;
+		data->data[data->endPoint].timeDiffUs = data->endPoint == 0 ? 0 : stepUs + (rand() % 100);
+		data->endPoint++;
+	}
+}
+
+static bool checkIsqrt() {
+	int wrong = 0;
+	for (uint64_t v = 0; v < (1 << 24); v++) {
+		uint64_t r = fixed_isqrt(v);
+		wrong += (r * r > v) || ((r + 1) * (r + 1) <= v);
+	}
+	for (int i = 0; i < 1000000; i++) {
+		uint64_t v = (((uint32_t) rand() << 16) ^ rand()) & 0xffffffff;
+		// around perfect squares too, that's where an off by one shows
+		if (i & 1) {
+			uint64_t root = v >> 16;
+			v = (root * root) - (i & 2 && root != 0 ? 1 : 0);
+		}
+		uint64_t r = fixed_isqrt(v);
+		wrong += (r * r > v) || ((r + 1) * (r + 1) <= v);
+	}
+	uint64_t r = fixed_isqrt(UINT32_MAX);
+	wrong += (r * r > UINT32_MAX) || ((r + 1) * (r + 1) <= UINT32_MAX);
+	printf("isqrt: %d wrong\n", wrong);
+	return wrong == 0;
+}
+
+static bool checkConvert() {
+	int differ = 0, maxError = 0;
+	for (int y = -128; y < 128; y++) {
+		for (int x = -128; x < 128; x++) {
+			WaveformDatapoint raw = { .ax = x, .ay = y, .cx = y, .cy = x };
+			WaveformDatapoint fixed = convertStickValues(&raw);
+			WaveformDatapoint reference = floatConvert(&raw);
+			int errors[4] = { abs(fixed.ax - reference.ax), abs(fixed.ay - reference.ay),
+			                  abs(fixed.cx - reference.cx), abs(fixed.cy - reference.cy) };
+			for (int i = 0; i < 4; i++) {
+				differ += errors[i] != 0;
+				if (errors[i] > maxError) {
+					maxError = errors[i];
+				}
+			}
+		}
+	}
+	printf("convertStickValues: %d of %d values differ, max %d melee units\n", differ, 256 * 256 * 4, maxError);
+	return maxError <= MAX_COORD_ERROR;
+}
+
+static double maxDiff(double current, double a, double b) {
+	return fmax(current, fabs(a - b));
+}
+
+static bool checkPivot(WaveformData *data) {
+	int found = 0;
+	double msError = 0, percentError = 0;
+	// second sides from a fraction of a frame to two frames
+	for (int polls = 1; polls <= 120; polls++) {
+		memset(data, 0, sizeof(WaveformData));
+		addPolls(data, 0, 5, 250);
+		addPolls(data, 80, 40, 250);
+		addPolls(data, 0, 1, 250);
+		addPolls(data, -80, polls, 250);
+		addPolls(data, 0, 20, 250);
+		PivotResult fixed, reference;
+		if (!analysis_pivot(data, &fixed)) {
+			continue;
+		}
+		found++;
+		floatPivot(fixed.timeInRangeUs, &reference);
+		msError = maxDiff(msError, fixed.timeInRangeMs, reference.timeInRangeMs);
+		percentError = maxDiff(percentError, fixed.noTurnPercent, reference.noTurnPercent);
+		percentError = maxDiff(percentError, fixed.pivotPercent, reference.pivotPercent);
+		percentError = maxDiff(percentError, fixed.dashbackPercent, reference.dashbackPercent);
+	}
+	printf("pivot: %d captures, max error %.5f ms, %.5f%%\n", found, msError, percentError);
+	return found != 0 && msError <= MAX_MS_ERROR && percentError <= MAX_PERCENT_ERROR;
+}
+
+static bool checkDashback(WaveformData *data) {
+	int count = 0;
+	double msError = 0, percentError = 0;
+	const int values[] = { 30, 40, 50, 60 };
+	for (int v = 0; v < 4; v++) {
+		for (int polls = 1; polls <= 120; polls++) {
+			memset(data, 0, sizeof(WaveformData));
+			addPolls(data, 0, 5, 250);
+			addPolls(data, values[v], polls, 250);
+			addPolls(data, 80, 40, 250);
+			addPolls(data, 0, 20, 250);
+			DashbackResult fixed, reference;
+			analysis_dashback(data, &fixed);
+			floatDashback(data, &reference);
+			count++;
+			msError = maxDiff(msError, fixed.timeInRangeMs, reference.timeInRangeMs);
+			percentError = maxDiff(percentError, fixed.vanillaPercent, reference.vanillaPercent);
+			percentError = maxDiff(percentError, fixed.ucfPercent, reference.ucfPercent);
+		}
+	}
+	printf("dashback: %d captures, max error %.5f ms, %.5f%%\n", count, msError, percentError);
+	return msError <= MAX_MS_ERROR && percentError <= MAX_PERCENT_ERROR;
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "usage: %s [-n iterations]\n", name);
+}
+
+int main(int argc, char **argv) {
+	int iterations = 200;
+	int opt;
+	while ((opt = getopt(argc, argv, "n:h")) != -1) {
+		switch (opt) {
+			case 'n':
+				iterations = atoi(optarg);
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (iterations < 1) {
+		iterations = 1;
+	}
+	srand(1);
+	bool failed = false;
+	static WaveformData data;
+
+	printf("fixed point against the float versions\n");
+	failed |= !checkIsqrt();
+	failed |= !checkConvert();
+	failed |= !checkPivot(&data);
+	failed |= !checkDashback(&data);
+
+	printf("\ntiming, %d runs\n", iterations);
+	// keeps the compiler from dropping the loops
+	volatile int sink = 0;
+	uint64_t start = nowNs();
+	for (int i = 0; i < iterations; i++) {
+		for (int p = 0; p < 256 * 256; p++) {
+			WaveformDatapoint raw = { .ax = (p & 0xff) - 128, .ay = (p >> 8) - 128 };
+			sink += convertStickValues(&raw).ax;
+		}
+	}
+	uint64_t fixedNs = nowNs() - start;
+	start = nowNs();
+	for (int i = 0; i < iterations; i++) {
+		for (int p = 0; p < 256 * 256; p++) {
+			WaveformDatapoint raw = { .ax = (p & 0xff) - 128, .ay = (p >> 8) - 128 };
+			sink += floatConvert(&raw).ax;
+		}
+	}
+	uint64_t floatNs = nowNs() - start;
+	printf("  convert   fixed %8.2f ns  float %8.2f ns  (per position)\n",
+	       fixedNs / (iterations * 65536.0), floatNs / (iterations * 65536.0));
+
+	memset(&data, 0, sizeof(WaveformData));
+	addPolls(&data, 0, 5, 250);
+	addPolls(&data, 40, 20, 250);
+	addPolls(&data, 80, 40, 250);
+	addPolls(&data, 0, 20, 250);
+	DashbackResult dashback;
+	start = nowNs();
+	for (int i = 0; i < iterations * 100; i++) {
+		analysis_dashback(&data, &dashback);
+		sink += dashback.ucfPercent;
+	}
+	fixedNs = nowNs() - start;
+	start = nowNs();
+	for (int i = 0; i < iterations * 100; i++) {
+		floatDashback(&data, &dashback);
+		sink += dashback.ucfPercent;
+	}
+	floatNs = nowNs() - start;
+	printf("  dashback  fixed %8.2f us  float %8.2f us  (%d polls)\n",
+	       fixedNs / (iterations * 100000.0), floatNs / (iterations * 100000.0), data.endPoint);
+
+	memset(&data, 0, sizeof(WaveformData));
+	addPolls(&data, 0, 5, 250);
+	addPolls(&data, 80, 40, 250);
+	addPolls(&data, 0, 1, 250);
+	addPolls(&data, -80, 40, 250);
+	addPolls(&data, 0, 20, 250);
+	PivotResult pivot;
+	start = nowNs();
+	for (int i = 0; i < iterations * 1000; i++) {
+		analysis_pivot(&data, &pivot);
+		sink += pivot.pivotPercent;
+	}
+	fixedNs = nowNs() - start;
+	printf("  pivot     fixed %8.2f ns  (%d polls, search and odds)\n", fixedNs / (iterations * 1000.0), data.endPoint);
+	printf("  this cpu has a hardware square root, the console's doesn't\n");
+
+	if (failed) {
+		printf("\nFAILED\n");
+		return 1;
+	}
+	return 0;
+}
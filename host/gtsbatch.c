@@ -0,0 +1,343 @@
+//
+// Created on 2026/10/18.
+//
+
+// re-scores a directory of captures from exportData with the same analysis code the console runs
+// build with "make host", then run "./gtsbatch [-j threads] <directory>"
+// per-file results go to stdout as csv, the aggregate goes to stderr
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "../source/waveform.h"
+#include "../source/file/csv.h"
+#include "../source/analysis/analysis.h"
+#include "../source/analysis/notch.h"
+
+typedef struct FileResult {
+	// 0 ok, 1 malformed, 2 couldn't open
+	int status;
+	unsigned int samples;
+	uint64_t durationUs;
+	// which test the capture looks like
+	enum MOTION_TYPE motion;
+	StickRange range;
+	bool pivotFound;
+	PivotResult pivot;
+	DashbackResult dashback;
+	// analog stick notches found, and how far the gate is from the ideal octagon
+	int notches;
+	GateFit gate;
+} FileResult;
+
+// each worker owns one of these, and takes from the back of its own
+// once it runs out, it steals from the front of the others
+// a lock per queue is plenty, a file takes far longer to parse than the lock does
+typedef struct WorkQueue {
+	pthread_mutex_t lock;
+	int *items;
+	int head;
+	int tail;
+} WorkQueue;
+
+typedef struct Worker {
+	pthread_t thread;
+	int id;
+	WaveformData *capture;
+	NotchTracker notches;
+	// for the summary
+	int processed;
+	int stolen;
+} Worker;
+
+static const char *dirPath;
+static char **names;
+static int nameCount = 0;
+static FileResult *results;
+
+static WorkQueue *queues;
+static Worker *workers;
+static int workerCount = 0;
+
+static bool takeOwn(WorkQueue *queue, int *item) {
+	pthread_mutex_lock(&queue->lock);
+	bool found = queue->head < queue->tail;
+	if (found) {
+		queue->tail--;
+		*item = queue->items[queue->tail];
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return found;
+}
+
+static bool steal(WorkQueue *queue, int *item) {
+	pthread_mutex_lock(&queue->lock);
+	bool found = queue->head < queue->tail;
+	if (found) {
+		*item = queue->items[queue->head];
+		queue->head++;
+	}
+	pthread_mutex_unlock(&queue->lock);
+	return found;
+}
+
+static void analyzeFile(Worker *worker, int index) {
+	FileResult *result = &results[index];
+	char path[4096];
+	snprintf(path, sizeof(path), "%s/%s", dirPath, names[index]);
+
+	FILE *fptr = fopen(path, "r");
+	if (fptr == NULL) {
+		result->status = 2;
+		return;
+	}
+	setvbuf(fptr, NULL, _IOFBF, 64 * 1024);
+	int ret = csv_readWaveform(fptr, worker->capture);
+	fclose(fptr);
+	if (ret != 0) {
+		result->status = 1;
+		return;
+	}
+
+	WaveformData *data = worker->capture;
+	result->status = 0;
+	result->samples = data->endPoint;
+	result->durationUs = data->totalTimeUs;
+	result->motion = analysis_classify(data, false, NULL);
+	analysis_stickRange(data, 0, data->endPoint, false, &result->range);
+	result->pivotFound = analysis_pivot(data, &result->pivot);
+	analysis_dashback(data, &result->dashback);
+
+	notch_reset(&worker->notches);
+	for (unsigned int i = 0; i < data->endPoint; i++) {
+		notch_add(&worker->notches, data->data[i].ax, data->data[i].ay);
+	}
+	notch_flush(&worker->notches);
+	NotchResult notchResults[NOTCH_MAX_CLUSTERS];
+	result->notches = notch_results(&worker->notches, notchResults, NOTCH_MAX_CLUSTERS);
+	notch_fitGate(&worker->notches, &result->gate);
+}
+
+static void *workerMain(void *arg) {
+	Worker *worker = arg;
+	int item;
+	while (true) {
+		if (takeOwn(&queues[worker->id], &item)) {
+			analyzeFile(worker, item);
+			worker->processed++;
+			continue;
+		}
+		// nothing left here, look through the others starting with the next one
+		// no new work is ever added, so once every queue is empty we're done
+		bool found = false;
+		for (int i = 1; i < workerCount && !found; i++) {
+			found = steal(&queues[(worker->id + i) % workerCount], &item);
+		}
+		if (!found) {
+			break;
+		}
+		analyzeFile(worker, item);
+		worker->processed++;
+		worker->stolen++;
+	}
+	return NULL;
+}
+
+static int compareNames(const void *a, const void *b) {
+	return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+// same rules as listCaptures on the console
+static int readDirectory() {
+	DIR *dir = opendir(dirPath);
+	if (dir == NULL) {
+		return -1;
+	}
+	int capacity = 1024;
+	names = malloc(capacity * sizeof(char *));
+	struct dirent *entry;
+	while ((entry = readdir(dir)) != NULL) {
+		if (!csv_isCaptureName(entry->d_name)) {
+			continue;
+		}
+		if (nameCount == capacity) {
+			capacity *= 2;
+			names = realloc(names, capacity * sizeof(char *));
+		}
+		names[nameCount] = strdup(entry->d_name);
+		nameCount++;
+	}
+	closedir(dir);
+	qsort(names, nameCount, sizeof(char *), compareNames);
+	return nameCount;
+}
+
+static const char *MOTION_NAMES[] = { "snapback", "pivot", "dashback", "none" };
+
+static void printResults() {
+	printf("file,samples,duration_ms,motion,min_x,max_x,min_y,max_y,"
+	       "pivot_ms,no_turn_pct,pivot_pct,pivot_dashback_pct,dashback_vanilla_pct,dashback_ucf_pct,"
+	       "notches,gate_mean_err,gate_max_err,error\n");
+	for (int i = 0; i < nameCount; i++) {
+		FileResult *r = &results[i];
+		if (r->status != 0) {
+			printf("%s,,,,,,,,,,,,,,,,,%s\n", names[i], r->status == 1 ? "malformed" : "open failed");
+			continue;
+		}
+		printf("%s,%u,%0.3f,%s,%d,%d,%d,%d,", names[i], r->samples, r->durationUs / 1000.0, MOTION_NAMES[r->motion],
+		       r->range.minX, r->range.maxX, r->range.minY, r->range.maxY);
+		if (r->pivotFound) {
+			printf("%0.3f,%0.1f,%0.1f,%0.1f,", r->pivot.timeInRangeMs, r->pivot.noTurnPercent,
+			       r->pivot.pivotPercent, r->pivot.dashbackPercent);
+		} else {
+			printf(",,,,");
+		}
+		printf("%0.1f,%0.1f,%d,", r->dashback.vanillaPercent, r->dashback.ucfPercent, r->notches);
+		if (r->gate.binsUsed != 0) {
+			printf("%0.2f,%0.2f,\n", r->gate.meanError, r->gate.maxError);
+		} else {
+			printf(",,\n");
+		}
+	}
+}
+
+static void printSummary(double seconds) {
+	int ok = 0, pivots = 0;
+	int motions[MOTION_NONE + 1] = { 0 };
+	double pivotMsTotal = 0, pivotPctTotal = 0;
+	float pivotMsMin = 0, pivotMsMax = 0;
+	double vanillaTotal = 0, ucfTotal = 0;
+	double rangeXTotal = 0, rangeYTotal = 0;
+	unsigned long long samplesTotal = 0;
+
+	for (int i = 0; i < nameCount; i++) {
+		FileResult *r = &results[i];
+		if (r->status != 0) {
+			continue;
+		}
+		ok++;
+		motions[r->motion]++;
+		samplesTotal += r->samples;
+		rangeXTotal += r->range.maxX - r->range.minX;
+		rangeYTotal += r->range.maxY - r->range.minY;
+		vanillaTotal += r->dashback.vanillaPercent;
+		ucfTotal += r->dashback.ucfPercent;
+		if (r->pivotFound) {
+			if (pivots == 0 || r->pivot.timeInRangeMs < pivotMsMin) {
+				pivotMsMin = r->pivot.timeInRangeMs;
+			}
+			if (pivots == 0 || r->pivot.timeInRangeMs > pivotMsMax) {
+				pivotMsMax = r->pivot.timeInRangeMs;
+			}
+			pivots++;
+			pivotMsTotal += r->pivot.timeInRangeMs;
+			pivotPctTotal += r->pivot.pivotPercent;
+		}
+	}
+
+	fprintf(stderr, "Files: %d | Analyzed: %d | Failed: %d | Samples: %llu\n", nameCount, ok, nameCount - ok, samplesTotal);
+	fprintf(stderr, "Time: %0.3f s | %0.1f files/s | %d threads\n", seconds, seconds > 0 ? nameCount / seconds : 0.0, workerCount);
+	for (int i = 0; i < workerCount; i++) {
+		fprintf(stderr, "  thread %d: %d files, %d stolen\n", i, workers[i].processed, workers[i].stolen);
+	}
+	if (ok == 0) {
+		return;
+	}
+	fprintf(stderr, "Looks like: %d snapback | %d pivot | %d dashback | %d none\n", motions[MOTION_SNAPBACK],
+	        motions[MOTION_PIVOT], motions[MOTION_DASHBACK], motions[MOTION_NONE]);
+	fprintf(stderr, "Mean stick range: X %0.1f | Y %0.1f\n", rangeXTotal / ok, rangeYTotal / ok);
+	fprintf(stderr, "Mean dashback success: Vanilla %0.1f%% | UCF %0.1f%%\n", vanillaTotal / ok, ucfTotal / ok);
+	if (pivots != 0) {
+		fprintf(stderr, "Pivots: %d | MS mean %0.3f, min %0.3f, max %0.3f | Mean pivot chance %0.1f%%\n",
+		        pivots, pivotMsTotal / pivots, pivotMsMin, pivotMsMax, pivotPctTotal / pivots);
+	} else {
+		fprintf(stderr, "Pivots: 0\n");
+	}
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "usage: %s [-j threads] <capture directory>\n", name);
+}
+
+int main(int argc, char **argv) {
+	workerCount = sysconf(_SC_NPROCESSORS_ONLN);
+	int opt;
+	while ((opt = getopt(argc, argv, "j:h")) != -1) {
+		switch (opt) {
+			case 'j':
+				workerCount = atoi(optarg);
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (optind != argc - 1) {
+		usage(argv[0]);
+		return 1;
+	}
+	if (workerCount < 1) {
+		workerCount = 1;
+	}
+	dirPath = argv[optind];
+
+	if (readDirectory() == -1) {
+		fprintf(stderr, "Couldn't open %s\n", dirPath);
+		return 1;
+	}
+	if (nameCount == 0) {
+		fprintf(stderr, "No captures found in %s\n", dirPath);
+		return 1;
+	}
+	if (workerCount > nameCount) {
+		workerCount = nameCount;
+	}
+
+	results = calloc(nameCount, sizeof(FileResult));
+	queues = calloc(workerCount, sizeof(WorkQueue));
+	workers = calloc(workerCount, sizeof(Worker));
+
+	// deal the files out round robin, stealing evens out whatever this gets wrong
+	for (int i = 0; i < workerCount; i++) {
+		pthread_mutex_init(&queues[i].lock, NULL);
+		queues[i].items = malloc(((nameCount / workerCount) + 1) * sizeof(int));
+	}
+	for (int i = 0; i < nameCount; i++) {
+		WorkQueue *queue = &queues[i % workerCount];
+		queue->items[queue->tail] = i;
+		queue->tail++;
+	}
+
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (int i = 0; i < workerCount; i++) {
+		workers[i].id = i;
+		workers[i].capture = malloc(sizeof(WaveformData));
+		pthread_create(&workers[i].thread, NULL, workerMain, &workers[i]);
+	}
+	for (int i = 0; i < workerCount; i++) {
+		pthread_join(workers[i].thread, NULL);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	printResults();
+	printSummary((end.tv_sec - start.tv_sec) + ((end.tv_nsec - start.tv_nsec) / 1e9));
+
+	for (int i = 0; i < workerCount; i++) {
+		free(workers[i].capture);
+		free(queues[i].items);
+		pthread_mutex_destroy(&queues[i].lock);
+	}
+	for (int i = 0; i < nameCount; i++) {
+		free(names[i]);
+	}
+	free(names);
+	free(results);
+	free(queues);
+	free(workers);
+	return 0;
+}
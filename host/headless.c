@@ -0,0 +1,691 @@
+//
+// Created on 2026/10/18.
+//
+
+// runs the menus without a console, drawing into an in-memory framebuffer
+// build with "make host", then run "./gtsheadless [options] <script>"
+//
+// the script is plain text, one entry per line, # starts a comment:
+//   <frame> <buttons> [stickX stickY [cStickX cStickY [triggerL triggerR]]] [~]
+//     pad state from that frame on, buttons are names joined with + (A+B, START, UP...), or - for none
+//     ~ moves the sticks and triggers smoothly from the previous entry instead of jumping
+//   unplug <frame>        controller disconnected until the next pad entry
+//   snap <frame> <name>   check the frame against the golden <name>.xfb, or save it with -u
+//   end <frame>           stop after this frame, defaults to a second after the last entry
+//
+// with -s, input comes from a session recorded on the console (make session) instead of a script
+// -R writes a script run out as a session, so replays can be checked without a console
+//
+// per-menu frame times are printed at the end, these are real time on this machine, not the console's
+// -D times the draw primitives in each scan mode instead of running anything
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <time.h>
+#include <unistd.h>
+#include <gccore.h>
+#include "shim/shim.h"
+#include "png.h"
+#include "../source/menu.h"
+#include "../source/draw.h"
+#include "../source/polling.h"
+#include "../source/input.h"
+#include "../source/print.h"
+#include "../source/frametime.h"
+#include "../source/session.h"
+#include "../source/profiler.h"
+#include "../source/logging.h"
+
+#define XFB_WORDS ((SHIM_XFB_WIDTH * SHIM_XFB_HEIGHT) / 2)
+#define MAX_NAME_LEN 64
+
+typedef struct PadEntry {
+	u32 frame;
+	ShimPadState state;
+	bool ramp;
+} PadEntry;
+
+typedef struct Snap {
+	u32 frame;
+	char name[MAX_NAME_LEN];
+	bool taken;
+} Snap;
+
+static PadEntry *entries = NULL;
+static u32 entryCount = 0;
+static Snap *snaps = NULL;
+static u32 snapCount = 0;
+static u32 endFrame = 0;
+
+static FrameTimeStats menuTimes[ERR + 1];
+
+static Session session;
+
+static const char *goldenDir = NULL;
+static const char *outDir = ".";
+static bool updateGoldens = false;
+static bool dumpSnaps = false;
+
+static const struct {
+	const char *name;
+	u16 mask;
+} BUTTON_NAMES[] = {
+	{ "A", PAD_BUTTON_A }, { "B", PAD_BUTTON_B }, { "X", PAD_BUTTON_X }, { "Y", PAD_BUTTON_Y },
+	{ "Z", PAD_TRIGGER_Z }, { "L", PAD_TRIGGER_L }, { "R", PAD_TRIGGER_R }, { "START", PAD_BUTTON_START },
+	{ "UP", PAD_BUTTON_UP }, { "DOWN", PAD_BUTTON_DOWN }, { "LEFT", PAD_BUTTON_LEFT }, { "RIGHT", PAD_BUTTON_RIGHT },
+};
+
+static bool parseButtons(char *str, u16 *buttons) {
+	*buttons = 0;
+	if (strcmp(str, "-") == 0) {
+		return true;
+	}
+	for (char *name = strtok(str, "+"); name != NULL; name = strtok(NULL, "+")) {
+		bool found = false;
+		for (int i = 0; i < sizeof(BUTTON_NAMES) / sizeof(BUTTON_NAMES[0]); i++) {
+			if (strcasecmp(name, BUTTON_NAMES[i].name) == 0) {
+				*buttons |= BUTTON_NAMES[i].mask;
+				found = true;
+			}
+		}
+		if (!found) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static int readScript(const char *path) {
+	FILE *fptr = fopen(path, "r");
+	if (fptr == NULL) {
+		fprintf(stderr, "Couldn't open %s\n", path);
+		return 1;
+	}
+	u32 entryCapacity = 0, snapCapacity = 0;
+	char line[256];
+	int lineNumber = 0;
+	bool endSet = false;
+	while (fgets(line, sizeof(line), fptr) != NULL) {
+		lineNumber++;
+		char *comment = strchr(line, '#');
+		if (comment != NULL) {
+			*comment = '\0';
+		}
+		char *tokens[12];
+		int count = 0;
+		for (char *tok = strtok(line, " \t\r\n"); tok != NULL && count < 12; tok = strtok(NULL, " \t\r\n")) {
+			tokens[count++] = tok;
+		}
+		if (count == 0) {
+			continue;
+		}
+
+		if (strcmp(tokens[0], "snap") == 0 && count == 3) {
+			if (snapCount == snapCapacity) {
+				snapCapacity = snapCapacity == 0 ? 16 : snapCapacity * 2;
+				snaps = realloc(snaps, snapCapacity * sizeof(Snap));
+			}
+			snaps[snapCount].frame = strtoul(tokens[1], NULL, 10);
+			snprintf(snaps[snapCount].name, MAX_NAME_LEN, "%s", tokens[2]);
+			snaps[snapCount].taken = false;
+			snapCount++;
+			continue;
+		}
+		if (strcmp(tokens[0], "end") == 0 && count == 2) {
+			endFrame = strtoul(tokens[1], NULL, 10);
+			endSet = true;
+			continue;
+		}
+
+		PadEntry entry;
+		memset(&entry, 0, sizeof(entry));
+		if (strcmp(tokens[0], "unplug") == 0 && count == 2) {
+			entry.frame = strtoul(tokens[1], NULL, 10);
+			entry.state.connected = false;
+		} else if (isdigit((unsigned char) tokens[0][0]) && count >= 2) {
+			entry.frame = strtoul(tokens[0], NULL, 10);
+			entry.state.connected = true;
+			if (count > 2 && strcmp(tokens[count - 1], "~") == 0) {
+				entry.ramp = true;
+				count--;
+			}
+			if (!parseButtons(tokens[1], &entry.state.buttons) || (count != 2 && count != 4 && count != 6 && count != 8)) {
+				fprintf(stderr, "%s:%d: couldn't read pad entry\n", path, lineNumber);
+				fclose(fptr);
+				return 1;
+			}
+			s8 *sticks[4] = { &entry.state.stickX, &entry.state.stickY, &entry.state.substickX, &entry.state.substickY };
+			for (int i = 2; i < count && i < 6; i++) {
+				*sticks[i - 2] = atoi(tokens[i]);
+			}
+			if (count == 8) {
+				entry.state.triggerL = atoi(tokens[6]);
+				entry.state.triggerR = atoi(tokens[7]);
+			}
+		} else {
+			fprintf(stderr, "%s:%d: unknown entry \"%s\"\n", path, lineNumber, tokens[0]);
+			fclose(fptr);
+			return 1;
+		}
+
+		if (entryCount != 0 && entry.frame < entries[entryCount - 1].frame) {
+			fprintf(stderr, "%s:%d: entries need to be in frame order\n", path, lineNumber);
+			fclose(fptr);
+			return 1;
+		}
+		if (entryCount == entryCapacity) {
+			entryCapacity = entryCapacity == 0 ? 64 : entryCapacity * 2;
+			entries = realloc(entries, entryCapacity * sizeof(PadEntry));
+		}
+		entries[entryCount++] = entry;
+	}
+	fclose(fptr);
+
+	if (!endSet) {
+		endFrame = entryCount == 0 ? 60 : entries[entryCount - 1].frame + 60;
+		for (u32 i = 0; i < snapCount; i++) {
+			if (snaps[i].frame + 1 > endFrame) {
+				endFrame = snaps[i].frame + 1;
+			}
+		}
+	}
+	return 0;
+}
+
+static u32 lastEntry = 0;
+
+static void scriptPadSource(u64 timeUs, ShimPadState *state) {
+	// the centered, connected controller before the first entry
+	if (entryCount == 0 || timeUs < (u64) entries[0].frame * SHIM_FRAME_US) {
+		memset(state, 0, sizeof(ShimPadState));
+		state->connected = true;
+		return;
+	}
+	// time only moves forward, so pick up the search where it left off
+	while (lastEntry + 1 < entryCount && timeUs >= (u64) entries[lastEntry + 1].frame * SHIM_FRAME_US) {
+		lastEntry++;
+	}
+	*state = entries[lastEntry].state;
+	if (lastEntry + 1 == entryCount || !entries[lastEntry + 1].ramp) {
+		return;
+	}
+
+	const PadEntry *from = &entries[lastEntry], *to = &entries[lastEntry + 1];
+	u64 startUs = (u64) from->frame * SHIM_FRAME_US;
+	u64 lenUs = (u64) (to->frame - from->frame) * SHIM_FRAME_US;
+	if (lenUs == 0) {
+		return;
+	}
+	// in 1/1000ths of the way there
+	int progress = ((timeUs - startUs) * 1000) / lenUs;
+	state->stickX = from->state.stickX + ((to->state.stickX - from->state.stickX) * progress) / 1000;
+	state->stickY = from->state.stickY + ((to->state.stickY - from->state.stickY) * progress) / 1000;
+	state->substickX = from->state.substickX + ((to->state.substickX - from->state.substickX) * progress) / 1000;
+	state->substickY = from->state.substickY + ((to->state.substickY - from->state.substickY) * progress) / 1000;
+	state->triggerL = from->state.triggerL + ((to->state.triggerL - from->state.triggerL) * progress) / 1000;
+	state->triggerR = from->state.triggerR + ((to->state.triggerR - from->state.triggerR) * progress) / 1000;
+}
+
+static int readSession(const char *path) {
+	FILE *fptr = fopen(path, "rb");
+	if (fptr == NULL) {
+		fprintf(stderr, "Couldn't open %s\n", path);
+		return 1;
+	}
+	fseek(fptr, 0, SEEK_END);
+	long size = ftell(fptr);
+	rewind(fptr);
+	u32 capacity = size > SESSION_HEADER_BYTES ? (size - SESSION_HEADER_BYTES) / SESSION_ENTRY_BYTES : 0;
+	session.entries = malloc((capacity + 1) * sizeof(SessionEntry));
+	session.capacity = capacity;
+	int ret = session_read(fptr, &session);
+	fclose(fptr);
+	if (ret != 0) {
+		fprintf(stderr, "%s isn't a session\n", path);
+		return 1;
+	}
+	endFrame = session.frames;
+	shim_setScanMode(session.scanMode);
+	ShimPadState origin = { true, 0, session.origin.stickX, session.origin.stickY, session.origin.substickX,
+	                        session.origin.substickY, session.origin.triggerL, session.origin.triggerR };
+	shim_setOrigin(&origin);
+	return 0;
+}
+
+// the console counts session frames from its retrace callback, here they're on the frame boundaries
+static void sessionPadSource(u64 timeUs, ShimPadState *state) {
+	const SessionEntry *entry = session_replay(&session, timeUs / SHIM_FRAME_US, timeUs % SHIM_FRAME_US);
+	memset(state, 0, sizeof(ShimPadState));
+	if (entry == NULL) {
+		state->connected = true;
+		return;
+	}
+	state->connected = entry->connected;
+	state->buttons = entry->buttons;
+	state->stickX = entry->stickX;
+	state->stickY = entry->stickY;
+	state->substickX = entry->substickX;
+	state->substickY = entry->substickY;
+	state->triggerL = entry->triggerL;
+	state->triggerR = entry->triggerR;
+}
+
+// a script run logged the same way the console logs it
+#define HOST_SESSION_MAX_ENTRIES (1 << 20)
+
+static void recordingPadSource(u64 timeUs, ShimPadState *state) {
+	scriptPadSource(timeUs, state);
+	SessionEntry entry = { .frame = timeUs / SHIM_FRAME_US, .offsetUs = timeUs % SHIM_FRAME_US,
+	                       .buttons = state->buttons, .stickX = state->stickX, .stickY = state->stickY,
+	                       .substickX = state->substickX, .substickY = state->substickY,
+	                       .triggerL = state->triggerL, .triggerR = state->triggerR, .connected = state->connected };
+	session_record(&session, &entry);
+}
+
+static bool writeSession(const char *path) {
+	FILE *fptr = fopen(path, "wb");
+	if (fptr == NULL) {
+		return false;
+	}
+	bool written = session_write(fptr, &session) == 0;
+	return fclose(fptr) == 0 && written;
+}
+
+static void writePng(const char *name, const char *suffix, const uint8_t *rgb) {
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/%s%s.png", outDir, name, suffix);
+	if (!png_write(path, rgb, SHIM_XFB_WIDTH, SHIM_XFB_HEIGHT)) {
+		fprintf(stderr, "Couldn't write %s\n", path);
+	}
+}
+
+// goldens are stored big endian, the same bytes the console would have in memory
+static bool saveGolden(const char *path, const u32 *xfb) {
+	FILE *fptr = fopen(path, "wb");
+	if (fptr == NULL) {
+		return false;
+	}
+	for (int i = 0; i < XFB_WORDS; i++) {
+		u8 bytes[4] = { xfb[i] >> 24, xfb[i] >> 16, xfb[i] >> 8, xfb[i] };
+		fwrite(bytes, 1, 4, fptr);
+	}
+	return fclose(fptr) == 0;
+}
+
+static bool loadGolden(const char *path, u32 *xfb) {
+	FILE *fptr = fopen(path, "rb");
+	if (fptr == NULL) {
+		return false;
+	}
+	u8 bytes[4];
+	for (int i = 0; i < XFB_WORDS; i++) {
+		if (fread(bytes, 1, 4, fptr) != 4) {
+			fclose(fptr);
+			return false;
+		}
+		xfb[i] = ((u32) bytes[0] << 24) | ((u32) bytes[1] << 16) | ((u32) bytes[2] << 8) | bytes[3];
+	}
+	fclose(fptr);
+	return true;
+}
+
+// returns false if the frame didn't match its golden
+static bool handleSnap(Snap *snap, const u32 *xfb) {
+	static uint8_t rgb[SHIM_XFB_WIDTH * SHIM_XFB_HEIGHT * 3];
+	static u32 golden[XFB_WORDS];
+	snap->taken = true;
+
+	if (dumpSnaps) {
+		png_xfbToRgb(xfb, SHIM_XFB_WIDTH, SHIM_XFB_HEIGHT, rgb);
+		writePng(snap->name, "", rgb);
+	}
+	if (goldenDir == NULL) {
+		return true;
+	}
+
+	char path[1024];
+	snprintf(path, sizeof(path), "%s/%s.xfb", goldenDir, snap->name);
+	if (updateGoldens) {
+		if (!saveGolden(path, xfb)) {
+			fprintf(stderr, "Couldn't write %s\n", path);
+			return false;
+		}
+		return true;
+	}
+	if (!loadGolden(path, golden)) {
+		fprintf(stderr, "snap %s (frame %u): no golden at %s, run with -u to create it\n", snap->name, snap->frame, path);
+		return false;
+	}
+
+	u32 mismatched = 0;
+	for (int i = 0; i < XFB_WORDS; i++) {
+		if (golden[i] != xfb[i]) {
+			mismatched++;
+		}
+	}
+	if (mismatched == 0) {
+		return true;
+	}
+
+	fprintf(stderr, "snap %s (frame %u): %u of %u pixel pairs differ\n", snap->name, snap->frame, mismatched, XFB_WORDS);
+	png_xfbToRgb(xfb, SHIM_XFB_WIDTH, SHIM_XFB_HEIGHT, rgb);
+	writePng(snap->name, ".actual", rgb);
+	png_xfbToRgb(golden, SHIM_XFB_WIDTH, SHIM_XFB_HEIGHT, rgb);
+	writePng(snap->name, ".expected", rgb);
+	// expected dimmed, with differences in red
+	for (int i = 0; i < XFB_WORDS; i++) {
+		for (int half = 0; half < 2; half++) {
+			uint8_t *pixel = rgb + (i * 6) + (half * 3);
+			if (golden[i] != xfb[i]) {
+				pixel[0] = 255, pixel[1] = 0, pixel[2] = 0;
+			} else {
+				pixel[0] /= 4, pixel[1] /= 4, pixel[2] /= 4;
+			}
+		}
+	}
+	writePng(snap->name, ".diff", rgb);
+	return false;
+}
+
+static double menuMean(const FrameTimeStats *times) {
+	return frameTime_meanNs(times) / 1000.0;
+}
+
+// same report the console shows after a replay
+static void printTimes(FILE *out) {
+	char line[128];
+	frameTime_formatHeader(line, sizeof(line));
+	fputs(line, out);
+	for (int i = 0; i <= ERR; i++) {
+		if (menuTimes[i].count != 0) {
+			frameTime_formatRow(line, sizeof(line), menu_getMenuName(i), &menuTimes[i]);
+			fputs(line, out);
+		}
+	}
+}
+
+static bool writeBaseline(const char *path) {
+	FILE *fptr = fopen(path, "w");
+	if (fptr == NULL) {
+		return false;
+	}
+	for (int i = 0; i <= ERR; i++) {
+		if (menuTimes[i].count != 0) {
+			fprintf(fptr, "%s %0.1f\n", menu_getMenuName(i), menuMean(&menuTimes[i]));
+		}
+	}
+	return fclose(fptr) == 0;
+}
+
+// returns false if any menu got slower than the baseline by more than tolerance percent
+static bool checkBaseline(const char *path, double tolerance) {
+	FILE *fptr = fopen(path, "r");
+	if (fptr == NULL) {
+		fprintf(stderr, "Couldn't open baseline %s\n", path);
+		return false;
+	}
+	bool ok = true;
+	char name[MAX_NAME_LEN];
+	double baseline;
+	while (fscanf(fptr, "%63s %lf", name, &baseline) == 2) {
+		for (int i = 0; i <= ERR; i++) {
+			if (strcmp(name, menu_getMenuName(i)) != 0 || menuTimes[i].count == 0) {
+				continue;
+			}
+			double mean = menuMean(&menuTimes[i]);
+			if (mean > baseline * (1 + (tolerance / 100))) {
+				fprintf(stderr, "%s: %0.1f us per frame, baseline is %0.1f us (+%0.0f%%)\n", name, mean, baseline,
+				        ((mean / baseline) - 1) * 100);
+				ok = false;
+			}
+		}
+	}
+	fclose(fptr);
+	return ok;
+}
+
+static void retraceCallback(u32 retraceCount) {
+	setSamplingRate();
+}
+
+static u64 nowNs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((u64) ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+// what each primitive is timed on, the shapes are about the size the menus draw
+static void benchDot(void *xfb) {
+	for (int y = 112; y < 368; y++) {
+		for (int x = 70; x < 326; x++) {
+			DrawDot(x, y, COLOR_WHITE, xfb);
+		}
+	}
+}
+
+static void benchVLine(void *xfb) {
+	for (int x = 70; x < 326; x++) {
+		DrawVLine(x, 112, 367, COLOR_WHITE, xfb);
+	}
+}
+
+static void benchFilledBox(void *xfb) {
+	DrawFilledBox(70, 112, 325, 367, COLOR_WHITE, xfb);
+}
+
+static void benchLine(void *xfb) {
+	for (int i = 0; i < 256; i += 4) {
+		DrawLine(320, 240, 192 + i, 112, COLOR_WHITE, xfb);
+		DrawLine(320, 240, 192 + i, 367, COLOR_WHITE, xfb);
+	}
+}
+
+static void benchCircle(void *xfb) {
+	for (int r = 1; r <= 160; r++) {
+		DrawCircle(400, 240, r, COLOR_WHITE, xfb);
+	}
+}
+
+static void benchmarkDraw() {
+	static u32 xfb[XFB_WORDS];
+	const char *names[] = { "dot", "vline", "filled box", "line", "circle" };
+	const char *shapes[] = { "256x256 dots", "256 lines of 256", "256x256", "128 lines from the center",
+	                         "radius 1 to 160" };
+	void (*benches[])(void *) = { benchDot, benchVLine, benchFilledBox, benchLine, benchCircle };
+	const int iterations = 200;
+	printf("draw (us)     interlaced progressive\n");
+	for (int b = 0; b < 5; b++) {
+		double us[2];
+		for (int mode = 0; mode < 2; mode++) {
+			setInterlaced(mode == 0);
+			memset(xfb, 0, sizeof(xfb));
+			u64 start = nowNs();
+			for (int i = 0; i < iterations; i++) {
+				benches[b](xfb);
+			}
+			us[mode] = (nowNs() - start) / (iterations * 1000.0);
+		}
+		printf("%-12s %11.1f %11.1f  %s\n", names[b], us[0], us[1], shapes[b]);
+	}
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "usage: %s [-p] [-g golden dir [-u]] [-o png dir] [-d] [-B baseline [-t percent]] [-W baseline] [-R session] "
+	                "<script>\n"
+	                "       %s [-B baseline [-t percent]] [-W baseline] -s <session>\n"
+	                "       %s -D\n"
+	                "  -p  progressive scan instead of interlaced\n"
+	                "  -g  compare snaps against <dir>/<name>.xfb, -u writes them instead\n"
+	                "  -o  where pngs go, default is the current directory\n"
+	                "  -d  write a png of every snap\n"
+	                "  -B  fail if a menu's mean frame time is over the baseline by more than -t percent (default 25)\n"
+	                "  -W  write this run's frame times as a baseline\n"
+	                "  -s  replay a session recorded on the console, in the scan mode it was recorded in\n"
+	                "  -R  write the script's input out as a session\n"
+	                "  -D  time each draw primitive in both scan modes\n", name, name, name);
+}
+
+int main(int argc, char **argv) {
+	const char *baselinePath = NULL, *writeBaselinePath = NULL, *sessionPath = NULL, *recordPath = NULL;
+	double tolerance = 25;
+	int opt;
+	while ((opt = getopt(argc, argv, "pg:uo:dB:t:W:s:R:Dh")) != -1) {
+		switch (opt) {
+			case 'p':
+				shim_setScanMode(VI_PROGRESSIVE);
+				break;
+			case 'g':
+				goldenDir = optarg;
+				break;
+			case 'u':
+				updateGoldens = true;
+				break;
+			case 'o':
+				outDir = optarg;
+				break;
+			case 'd':
+				dumpSnaps = true;
+				break;
+			case 'B':
+				baselinePath = optarg;
+				break;
+			case 't':
+				tolerance = atof(optarg);
+				break;
+			case 'W':
+				writeBaselinePath = optarg;
+				break;
+			case 's':
+				sessionPath = optarg;
+				break;
+			case 'R':
+				recordPath = optarg;
+				break;
+			case 'D':
+				benchmarkDraw();
+				return 0;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (sessionPath != NULL) {
+		if (optind != argc) {
+			usage(argv[0]);
+			return 1;
+		}
+		if (readSession(sessionPath) != 0) {
+			return 1;
+		}
+		shim_setPadSource(sessionPadSource);
+	} else {
+		if (optind != argc - 1) {
+			usage(argv[0]);
+			return 1;
+		}
+		if (readScript(argv[optind]) != 0) {
+			return 1;
+		}
+		shim_setPadSource(scriptPadSource);
+		if (recordPath != NULL) {
+			ShimPadState origin = { 0 };
+			SessionEntry originEntry = { .connected = true };
+			session_init(&session, malloc(HOST_SESSION_MAX_ENTRIES * sizeof(SessionEntry)), HOST_SESSION_MAX_ENTRIES,
+			             VIDEO_GetScanMode(), &originEntry);
+			shim_setOrigin(&origin);
+			shim_setPadSource(recordingPadSource);
+		}
+	}
+	// a menu stuck waiting for input gets ten seconds past the end
+	shim_setTimeLimitUs(((u64) endFrame * SHIM_FRAME_US) + 10000000);
+
+	#ifdef DEBUGLOG
+	log_addSink(log_stdoutSink, NULL, NULL, LOG_LEVEL_DEBUG);
+	#endif
+
+	// same setup as main.c
+	VIDEO_Init();
+	PAD_Init();
+	PAD_ScanPads();
+	input_reset();
+	GXRModeObj *rmode = VIDEO_GetPreferredMode(NULL);
+	void *xfb1 = SYS_AllocateFramebuffer(rmode);
+	void *xfb2 = SYS_AllocateFramebuffer(rmode);
+	VIDEO_SetPostRetraceCallback(retraceCallback);
+	setSamplingRateNormal();
+
+	bool xfbSwitch = false;
+	bool matched = true;
+	u32 framesRun = 0;
+	while (shim_frame() < endFrame) {
+		void *currXfb = xfbSwitch ? xfb1 : xfb2;
+		VIDEO_ClearFrameBuffer(rmode, currXfb, COLOR_BLACK);
+		u32 frame = shim_frame();
+		enum CURRENT_MENU menu = menu_getCurrentMenu();
+
+		u64 start = nowNs();
+		PROFILE_BEGIN(PROFILE_MENU);
+		bool shouldExit = menu_runMenu(currXfb);
+		PROFILE_END(PROFILE_MENU);
+		frameTime_add(&menuTimes[menu], nowNs() - start);
+		#ifdef PROFILE
+		// zone times are virtual console time, not real time like the table at the end
+		profile_endFrame();
+		profile_drawOverlay(currXfb);
+		#endif
+		framesRun++;
+
+		VIDEO_SetNextFramebuffer(currXfb);
+		xfbSwitch = !xfbSwitch;
+
+		// a menu that blocked skips frames, so take anything that was due
+		for (u32 i = 0; i < snapCount; i++) {
+			if (!snaps[i].taken && snaps[i].frame <= frame) {
+				matched &= handleSnap(&snaps[i], currXfb);
+			}
+		}
+		#ifdef DEBUGLOG
+		log_drain();
+		#endif
+		if (shouldExit) {
+			break;
+		}
+		VIDEO_WaitVSync();
+	}
+	for (u32 i = 0; i < snapCount; i++) {
+		if (!snaps[i].taken) {
+			fprintf(stderr, "snap %s (frame %u): never reached\n", snaps[i].name, snaps[i].frame);
+			matched = false;
+		}
+	}
+
+	#ifdef DEBUGLOG
+	log_drain();
+	#endif
+	printf("%u frames, %0.1f s of console time\n", framesRun, shim_timeUs() / 1e6);
+	if (recordPath != NULL) {
+		session_markFrame(&session, endFrame - 1);
+		if (!writeSession(recordPath)) {
+			fprintf(stderr, "Couldn't write %s\n", recordPath);
+		}
+	}
+	printTimes(stdout);
+	#ifdef PROFILE
+	char profilePath[1024];
+	snprintf(profilePath, sizeof(profilePath), "%s/profile.csv", outDir);
+	if (profile_dump(profilePath) != 0) {
+		fprintf(stderr, "Couldn't write %s\n", profilePath);
+	}
+	#endif
+	bool fastEnough = true;
+	if (writeBaselinePath != NULL && !writeBaseline(writeBaselinePath)) {
+		fprintf(stderr, "Couldn't write %s\n", writeBaselinePath);
+	}
+	if (baselinePath != NULL) {
+		fastEnough = checkBaseline(baselinePath, tolerance);
+	}
+	return (matched && fastEnough) ? 0 : 1;
+}
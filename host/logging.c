@@ -0,0 +1,249 @@
+//
+// Created on 2026/10/18.
+//
+
+// checks the log ring in source/logging.c, through log_stdoutSink with stdout sent to a temporary file
+// covers messages draining in the order they were claimed, the formatting log_write does itself,
+// long messages being cut off at LOG_MSG_LEN, and drops being counted and reported once the ring is full
+// then a few threads log as fast as they can while another drains, like the sampling interrupt and the menus do
+// build with "make host", then run "./gtslogging"
+// exits with 1 if a line isn't what was logged, or a message is lost without being counted as dropped
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include "../source/logging.h"
+
+#define WRITER_THREADS 4
+#define WRITER_MESSAGES 200000
+
+static bool failed = false;
+
+static void check(bool ok, const char *what) {
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAIL");
+	failed |= !ok;
+}
+
+// stdout goes here while the stdout sink is writing
+static FILE *captured = NULL;
+static int savedStdout = -1;
+
+static void captureStart() {
+	fflush(stdout);
+	captured = tmpfile();
+	savedStdout = dup(STDOUT_FILENO);
+	dup2(fileno(captured), STDOUT_FILENO);
+}
+
+// puts stdout back, and reads what was written into lines
+static int captureEnd(char lines[][LOG_MSG_LEN + 8], int maxLines) {
+	fflush(stdout);
+	dup2(savedStdout, STDOUT_FILENO);
+	close(savedStdout);
+	rewind(captured);
+	int count = 0;
+	char line[LOG_MSG_LEN * 2];
+	while (fgets(line, sizeof(line), captured) != NULL) {
+		line[strcspn(line, "\n")] = '\0';
+		if (count < maxLines) {
+			snprintf(lines[count], LOG_MSG_LEN + 8, "%.*s", LOG_MSG_LEN + 7, line);
+		}
+		count++;
+	}
+	fclose(captured);
+	return count;
+}
+
+static char lines[LOG_SLOTS * 2][LOG_MSG_LEN + 8];
+
+static void checkOrder() {
+	printf("claim and drain order\n");
+	static const enum LOG_LEVEL LEVELS[4] = { LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARN, LOG_LEVEL_ERROR };
+	static const char LEVEL_CHARS[4] = { 'D', 'I', 'W', 'E' };
+	captureStart();
+	bool written = true;
+	for (int i = 0; i < 10; i++) {
+		written &= log_write(LEVELS[i % 4], "message %d", i);
+	}
+	uint32_t drained = log_drain();
+	// nothing new, so nothing should be written
+	uint32_t drainedAgain = log_drain();
+	int count = captureEnd(lines, LOG_SLOTS * 2);
+
+	check(written && drained == 10 && drainedAgain == 0 && count == 10, "every message drained once");
+	bool ordered = true;
+	for (int i = 0; i < 10 && i < count; i++) {
+		char expected[32];
+		snprintf(expected, sizeof(expected), "[%c] message %d", LEVEL_CHARS[i % 4], i);
+		ordered &= strcmp(lines[i], expected) == 0;
+	}
+	check(ordered, "in the order they were written, with their levels");
+}
+
+static void checkFormat() {
+	printf("formatting\n");
+	captureStart();
+	log_write(LOG_LEVEL_INFO, "%d %i %u %x %X %c %s %%", -42, 7, 4000000000u, 0xbeef, 0xbeef, 'z', "str");
+	log_write(LOG_LEVEL_INFO, "[%5d] [%-5d] [%05d] [%-4s] [%3s]", 42, 42, -42, "ab", "abcd");
+	log_write(LOG_LEVEL_INFO, "%lld %llu %ld %zu %hhd", (long long) INT64_MIN, (unsigned long long) UINT64_MAX, -1L,
+	          (size_t) 12, 5);
+	log_write(LOG_LEVEL_INFO, "%p", (void *) 0x1234);
+	// floats aren't formatted, but what comes after them still is
+	log_write(LOG_LEVEL_INFO, "%0.2f ms, %d polls", 16.67, 3);
+	// not a literal, so the compiler doesn't warn about it
+	const char *trailing = "trailing %";
+	log_write(LOG_LEVEL_INFO, trailing);
+	log_drain();
+	int count = captureEnd(lines, LOG_SLOTS * 2);
+
+	const char *expected[] = {
+		"[I] -42 7 4000000000 beef BEEF z str %",
+		"[I] [   42] [42   ] [-0042] [ab  ] [abcd]",
+		"[I] -9223372036854775808 18446744073709551615 -1 12 5",
+		"[I] 0x1234",
+		"[I] %0.2f ms, 3 polls",
+		"[I] trailing %",
+	};
+	int expectedCount = sizeof(expected) / sizeof(expected[0]);
+	bool matched = count == expectedCount;
+	for (int i = 0; i < expectedCount && i < count; i++) {
+		if (strcmp(lines[i], expected[i]) != 0) {
+			printf("    got \"%s\"\n", lines[i]);
+			matched = false;
+		}
+	}
+	check(matched, "integers, strings, widths and floats left as written");
+}
+
+static void checkTruncation() {
+	printf("long messages\n");
+	char longMsg[LOG_MSG_LEN * 3];
+	for (int i = 0; i < sizeof(longMsg) - 1; i++) {
+		longMsg[i] = 'a' + (i % 26);
+	}
+	longMsg[sizeof(longMsg) - 1] = '\0';
+	captureStart();
+	log_write(LOG_LEVEL_WARN, "%s", longMsg);
+	log_write(LOG_LEVEL_WARN, "%s%d", longMsg, 5);
+	log_write(LOG_LEVEL_WARN, "after");
+	log_drain();
+	int count = captureEnd(lines, LOG_SLOTS * 2);
+
+	// the sink's prefix is 4 characters
+	bool cut = count == 3;
+	for (int i = 0; i < 2 && i < count; i++) {
+		cut &= strlen(lines[i]) == 4 + LOG_MSG_LEN - 1 && strncmp(lines[i] + 4, longMsg, LOG_MSG_LEN - 1) == 0;
+	}
+	check(cut, "cut off at LOG_MSG_LEN");
+	check(count == 3 && strcmp(lines[2], "[W] after") == 0, "next message is whole");
+}
+
+static void checkDropped() {
+	printf("full ring\n");
+	uint32_t droppedBefore = log_droppedTotal();
+	captureStart();
+	int accepted = 0;
+	for (int i = 0; i < LOG_SLOTS + 5; i++) {
+		accepted += log_write(LOG_LEVEL_INFO, "fill %d", i);
+	}
+	log_drain();
+	// the report is only made once
+	log_drain();
+	int count = captureEnd(lines, LOG_SLOTS * 2);
+
+	check(accepted == LOG_SLOTS && log_droppedTotal() - droppedBefore == 5, "writes fail once the ring is full");
+	char expected[32];
+	snprintf(expected, sizeof(expected), "[I] fill %d", LOG_SLOTS - 1);
+	check(count == LOG_SLOTS + 1 && strcmp(lines[LOG_SLOTS - 1], expected) == 0, "messages that fit are kept");
+	check(count == LOG_SLOTS + 1 && strcmp(lines[LOG_SLOTS], "[W] 5 messages dropped, log ring was full") == 0,
+	      "drops reported once on the next drain");
+}
+
+// counts what gets drained for each writer, and checks each one's messages arrive in order
+static atomic_bool writersDone = false;
+static uint32_t received[WRITER_THREADS];
+static uint32_t outOfOrder = 0;
+static int lastSeen[WRITER_THREADS];
+
+static void countingSink(void *ctx, enum LOG_LEVEL level, const char *msg, uint32_t len) {
+	int writer, seq;
+	if (sscanf(msg, "writer %d seq %d", &writer, &seq) != 2 || writer < 0 || writer >= WRITER_THREADS) {
+		return;
+	}
+	outOfOrder += seq <= lastSeen[writer];
+	lastSeen[writer] = seq;
+	received[writer]++;
+}
+
+static void *writerThread(void *arg) {
+	int writer = (int) (intptr_t) arg;
+	for (int i = 0; i < WRITER_MESSAGES; i++) {
+		log_write(LOG_LEVEL_DEBUG, "writer %d seq %d", writer, i);
+		// give the drain a chance, otherwise nearly everything is dropped
+		if (i % 16 == 0) {
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void *drainThread(void *arg) {
+	while (!atomic_load(&writersDone)) {
+		log_drain();
+	}
+	log_drain();
+	return NULL;
+}
+
+static void checkThreads() {
+	printf("%d writers and a drain running at once\n", WRITER_THREADS);
+	log_removeSinks();
+	log_addSink(countingSink, NULL, NULL, LOG_LEVEL_DEBUG);
+	for (int i = 0; i < WRITER_THREADS; i++) {
+		lastSeen[i] = -1;
+	}
+	uint32_t droppedBefore = log_droppedTotal();
+
+	pthread_t drain, writers[WRITER_THREADS];
+	pthread_create(&drain, NULL, drainThread, NULL);
+	for (int i = 0; i < WRITER_THREADS; i++) {
+		pthread_create(&writers[i], NULL, writerThread, (void *) (intptr_t) i);
+	}
+	for (int i = 0; i < WRITER_THREADS; i++) {
+		pthread_join(writers[i], NULL);
+	}
+	atomic_store(&writersDone, true);
+	pthread_join(drain, NULL);
+
+	uint32_t total = 0;
+	for (int i = 0; i < WRITER_THREADS; i++) {
+		total += received[i];
+	}
+	uint32_t dropped = log_droppedTotal() - droppedBefore;
+	printf("    %u drained, %u dropped\n", total, dropped);
+	check(total + dropped == WRITER_THREADS * WRITER_MESSAGES, "every message drained or counted as dropped");
+	check(outOfOrder == 0, "each writer's messages in order");
+}
+
+int main(int argc, char **argv) {
+	// nothing is formatted or kept without a sink
+	check(log_write(LOG_LEVEL_ERROR, "nobody is listening") && log_drain() == 0, "no sinks, nothing kept");
+
+	log_addSink(log_stdoutSink, NULL, NULL, LOG_LEVEL_DEBUG);
+	checkOrder();
+	checkFormat();
+	checkTruncation();
+	checkDropped();
+	checkThreads();
+
+	if (failed) {
+		printf("\nFAILED\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,184 @@
+//
+// Created on 2026/10/18.
+//
+
+// checks the notch and gate detection in source/analysis/notch.c on synthetic stick movement
+// build with "make host", then run "./gtsnotch"
+// exits with 1 if a notch is missed, lands in the wrong place, or a gate fit is outside the limits below
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../source/analysis/notch.h"
+#include "../source/analysis/analysis.h"
+#include "../source/analysis/coordinates.h"
+
+// a notch's center can be off by this much in raw units, from the jitter in the rests
+#define MAX_NOTCH_ERROR 0.5
+#define MAX_ANGLE_ERROR 1.0
+// the octagon's outline is swept at whole stick values, so it can't match exactly
+#define MAX_OCTAGON_MEAN_ERROR 1.0
+#define MAX_OCTAGON_ERROR 2.5
+// a round gate should come out clearly worse than an octagonal one
+#define MIN_ROUND_MEAN_ERROR 5.0
+
+static bool failed = false;
+
+static void check(bool ok, const char *what) {
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAIL");
+	failed |= !ok;
+}
+
+// holds the stick at a spot for some samples, moving by up to a unit like a real stick does
+static void rest(NotchTracker *tracker, int x, int y, int samples) {
+	for (int i = 0; i < samples; i++) {
+		notch_add(tracker, x + (rand() % 3) - 1, y + (rand() % 3) - 1);
+	}
+	// back to the center, which ends the rest
+	notch_add(tracker, 0, 0);
+}
+
+// goes around the outline of a gate once, a degree at a time
+static void sweep(NotchTracker *tracker, float (*radius)(float angle)) {
+	for (int degree = 0; degree < 360; degree++) {
+		float theta = degree * ((float) M_PI / 180.0f);
+		float r = radius((float) degree);
+		notch_add(tracker, (int) lroundf(r * cosf(theta)), (int) lroundf(r * sinf(theta)));
+	}
+	notch_add(tracker, 0, 0);
+}
+
+static float roundGate(float angle) {
+	return 90.0f;
+}
+
+// the corners DrawOctagonalGate draws, cardinals 100 out and diagonals 74 on both axes
+static const int OCTAGON[8][2] = { { 100, 0 }, { 74, 74 }, { 0, 100 }, { -74, 74 },
+                                   { -100, 0 }, { -74, -74 }, { 0, -100 }, { 74, -74 } };
+
+static void checkOctagon() {
+	printf("octagonal gate, two rests in every notch\n");
+	static NotchTracker tracker;
+	notch_reset(&tracker);
+	sweep(&tracker, notch_idealRadius);
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < 8; i++) {
+			rest(&tracker, OCTAGON[i][0], OCTAGON[i][1], NOTCH_DWELL_SAMPLES * 2);
+		}
+	}
+	notch_flush(&tracker);
+
+	NotchResult results[NOTCH_MAX_CLUSTERS];
+	int count = notch_results(&tracker, results, NOTCH_MAX_CLUSTERS);
+	check(count == 8, "eight notches");
+	bool placed = true, melee = true, angles = true;
+	for (int i = 0; i < count && i < 8; i++) {
+		// sorted by angle, which is the same order as the corners
+		placed &= fabs(results[i].x - OCTAGON[i][0]) <= MAX_NOTCH_ERROR &&
+		          fabs(results[i].y - OCTAGON[i][1]) <= MAX_NOTCH_ERROR;
+		WaveformDatapoint raw = { .ax = OCTAGON[i][0], .ay = OCTAGON[i][1] };
+		WaveformDatapoint expected = convertStickValues(&raw);
+		melee &= results[i].meleeX == (expected.isAXNegative ? -expected.ax : expected.ax) &&
+		         results[i].meleeY == (expected.isAYNegative ? -expected.ay : expected.ay);
+		angles &= fabs(results[i].angle - (i * 45.0)) <= MAX_ANGLE_ERROR &&
+		          fabs(results[i].octagonError) <= MAX_ANGLE_ERROR;
+		printf("    %7.2f %7.2f  %6d %6d  %6.2f deg\n", results[i].x, results[i].y, results[i].meleeX,
+		       results[i].meleeY, results[i].angle);
+	}
+	check(placed, "notch centers on the corners");
+	check(melee, "melee coordinates match convertStickValues");
+	check(angles, "angles on multiples of 45");
+
+	GateFit fit;
+	notch_fitGate(&tracker, &fit);
+	printf("    gate error mean %.2f max %.2f over %d bins\n", fit.meanError, fit.maxError, fit.binsUsed);
+	check(fit.binsUsed == NOTCH_GATE_BINS, "every direction out to the gate");
+	check(fit.meanError <= MAX_OCTAGON_MEAN_ERROR && fit.maxError <= MAX_OCTAGON_ERROR, "gate matches the octagon");
+	bool vertices = true;
+	for (int i = 0; i < NOTCH_GATE_VERTICES; i++) {
+		float diff = fabsf(fit.vertices[i].angle - (i * 45.0f));
+		if (diff > 180.0f) {
+			diff = 360.0f - diff;
+		}
+		vertices &= fit.vertices[i].found && diff <= 22.5f;
+	}
+	check(vertices, "each gate vertex near its corner");
+}
+
+static void checkRoundGate() {
+	printf("round gate\n");
+	static NotchTracker tracker;
+	notch_reset(&tracker);
+	sweep(&tracker, roundGate);
+	notch_flush(&tracker);
+	GateFit fit;
+	notch_fitGate(&tracker, &fit);
+	printf("    gate error mean %.2f max %.2f over %d bins\n", fit.meanError, fit.maxError, fit.binsUsed);
+	check(fit.meanError >= MIN_ROUND_MEAN_ERROR, "round gate is far from the octagon");
+}
+
+static void checkRejected() {
+	printf("rests that aren't notches\n");
+	static NotchTracker tracker;
+	NotchResult results[NOTCH_MAX_CLUSTERS];
+
+	notch_reset(&tracker);
+	rest(&tracker, 100, 0, NOTCH_DWELL_SAMPLES / 2);
+	rest(&tracker, 100, 0, NOTCH_DWELL_SAMPLES / 2);
+	notch_flush(&tracker);
+	check(notch_results(&tracker, results, NOTCH_MAX_CLUSTERS) == 0, "rests shorter than the dwell time");
+
+	notch_reset(&tracker);
+	rest(&tracker, 30, 30, NOTCH_DWELL_SAMPLES * 2);
+	rest(&tracker, 30, 30, NOTCH_DWELL_SAMPLES * 2);
+	notch_flush(&tracker);
+	check(notch_results(&tracker, results, NOTCH_MAX_CLUSTERS) == 0, "rests inside the minimum radius");
+
+	notch_reset(&tracker);
+	rest(&tracker, 100, 0, NOTCH_DWELL_SAMPLES * 2);
+	notch_flush(&tracker);
+	check(notch_results(&tracker, results, NOTCH_MAX_CLUSTERS) == 0, "a notch rested in once");
+}
+
+static void checkStickmap() {
+	printf("firefox / wavedash result\n");
+	// the first raw position that converts to a safe coordinate, rested in with no jitter
+	int safeX = 0, safeY = 0;
+	for (int y = 1; y < 128 && safeX == 0; y++) {
+		for (int x = 1; x < 128; x++) {
+			WaveformDatapoint raw = { .ax = x, .ay = y };
+			if (x * x + y * y >= NOTCH_MIN_RADIUS * NOTCH_MIN_RADIUS &&
+			    isCoordValid(FF_WD, convertStickValues(&raw)) == FF_WD_SAFE) {
+				safeX = x, safeY = y;
+				break;
+			}
+		}
+	}
+	static NotchTracker tracker;
+	notch_reset(&tracker);
+	for (int pass = 0; pass < 2; pass++) {
+		for (int i = 0; i < NOTCH_DWELL_SAMPLES * 2; i++) {
+			notch_add(&tracker, safeX, safeY);
+		}
+		notch_add(&tracker, 0, 0);
+	}
+	notch_flush(&tracker);
+	NotchResult results[NOTCH_MAX_CLUSTERS];
+	int count = notch_results(&tracker, results, NOTCH_MAX_CLUSTERS);
+	printf("    raw %d, %d\n", safeX, safeY);
+	check(safeX != 0 && count == 1 && results[0].ffwd == FF_WD_SAFE, "notch on a safe coordinate is safe");
+}
+
+int main(int argc, char **argv) {
+	srand(1);
+	checkOctagon();
+	checkRoundGate();
+	checkRejected();
+	checkStickmap();
+	if (failed) {
+		printf("\nFAILED\n");
+		return 1;
+	}
+	return 0;
+}
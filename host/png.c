@@ -0,0 +1,129 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "png.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// biggest block deflate can store uncompressed
+#define STORED_BLOCK_MAX 65535
+
+static uint32_t crcTable[256];
+static bool crcTableReady = false;
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t *buf, size_t len) {
+	if (!crcTableReady) {
+		for (uint32_t n = 0; n < 256; n++) {
+			uint32_t c = n;
+			for (int k = 0; k < 8; k++) {
+				c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+			}
+			crcTable[n] = c;
+		}
+		crcTableReady = true;
+	}
+	for (size_t i = 0; i < len; i++) {
+		crc = crcTable[(crc ^ buf[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return crc;
+}
+
+static void putU32BE(uint8_t *buf, uint32_t value) {
+	buf[0] = (value >> 24) & 0xFF;
+	buf[1] = (value >> 16) & 0xFF;
+	buf[2] = (value >> 8) & 0xFF;
+	buf[3] = value & 0xFF;
+}
+
+static bool writeChunk(FILE *fptr, const char *type, const uint8_t *data, uint32_t len) {
+	uint8_t header[8];
+	putU32BE(header, len);
+	memcpy(header + 4, type, 4);
+	uint32_t crc = crc32Update(0xFFFFFFFFu, header + 4, 4);
+	crc = crc32Update(crc, data, len) ^ 0xFFFFFFFFu;
+	uint8_t footer[4];
+	putU32BE(footer, crc);
+	return fwrite(header, 1, 8, fptr) == 8 && fwrite(data, 1, len, fptr) == len && fwrite(footer, 1, 4, fptr) == 4;
+}
+
+static uint8_t clamp(int value) {
+	return value < 0 ? 0 : (value > 255 ? 255 : value);
+}
+
+void png_xfbToRgb(const uint32_t *xfb, int width, int height, uint8_t *rgb) {
+	for (int i = 0; i < (width * height) / 2; i++) {
+		int y1 = (xfb[i] >> 24) & 0xFF;
+		int cb = ((xfb[i] >> 16) & 0xFF) - 128;
+		int y2 = (xfb[i] >> 8) & 0xFF;
+		int cr = (xfb[i] & 0xFF) - 128;
+		// bt.601, in 1/1000ths
+		int r = (1402 * cr) / 1000;
+		int g = (-344 * cb - 714 * cr) / 1000;
+		int b = (1772 * cb) / 1000;
+		uint8_t *out = rgb + (i * 6);
+		out[0] = clamp(y1 + r), out[1] = clamp(y1 + g), out[2] = clamp(y1 + b);
+		out[3] = clamp(y2 + r), out[4] = clamp(y2 + g), out[5] = clamp(y2 + b);
+	}
+}
+
+bool png_write(const char *path, const uint8_t *rgb, int width, int height) {
+	// raw scanlines, each with a filter byte of 0
+	size_t rowLen = (size_t) width * 3 + 1;
+	size_t rawLen = rowLen * height;
+	uint8_t *raw = malloc(rawLen);
+	if (raw == NULL) {
+		return false;
+	}
+	for (int y = 0; y < height; y++) {
+		raw[y * rowLen] = 0;
+		memcpy(raw + (y * rowLen) + 1, rgb + ((size_t) y * width * 3), (size_t) width * 3);
+	}
+
+	// zlib stream made of stored deflate blocks
+	size_t blocks = (rawLen + STORED_BLOCK_MAX - 1) / STORED_BLOCK_MAX;
+	size_t zlen = 2 + rawLen + (blocks * 5) + 4;
+	uint8_t *z = malloc(zlen);
+	if (z == NULL) {
+		free(raw);
+		return false;
+	}
+	size_t pos = 0;
+	z[pos++] = 0x78;
+	z[pos++] = 0x01;
+	uint32_t adlerA = 1, adlerB = 0;
+	for (size_t offset = 0; offset < rawLen; offset += STORED_BLOCK_MAX) {
+		size_t len = rawLen - offset > STORED_BLOCK_MAX ? STORED_BLOCK_MAX : rawLen - offset;
+		z[pos++] = (offset + len == rawLen) ? 1 : 0;
+		z[pos++] = len & 0xFF;
+		z[pos++] = (len >> 8) & 0xFF;
+		z[pos++] = ~len & 0xFF;
+		z[pos++] = (~len >> 8) & 0xFF;
+		memcpy(z + pos, raw + offset, len);
+		pos += len;
+		for (size_t i = 0; i < len; i++) {
+			adlerA = (adlerA + raw[offset + i]) % 65521;
+			adlerB = (adlerB + adlerA) % 65521;
+		}
+	}
+	putU32BE(z + pos, (adlerB << 16) | adlerA);
+	pos += 4;
+	free(raw);
+
+	FILE *fptr = fopen(path, "wb");
+	if (fptr == NULL) {
+		free(z);
+		return false;
+	}
+	static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	uint8_t ihdr[13];
+	putU32BE(ihdr, width);
+	putU32BE(ihdr + 4, height);
+	// 8 bits, rgb, deflate, no filtering beyond per-row, not interlaced
+	ihdr[8] = 8, ihdr[9] = 2, ihdr[10] = 0, ihdr[11] = 0, ihdr[12] = 0;
+	bool ok = fwrite(signature, 1, 8, fptr) == 8 && writeChunk(fptr, "IHDR", ihdr, 13) &&
+	          writeChunk(fptr, "IDAT", z, pos) && writeChunk(fptr, "IEND", NULL, 0);
+	free(z);
+	return fclose(fptr) == 0 && ok;
+}
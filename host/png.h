@@ -0,0 +1,19 @@
+//
+// Created on 2026/10/18.
+//
+
+// just enough png writing to look at framebuffers, no compression and no dependencies
+
+#ifndef GTS_HOST_PNG_H
+#define GTS_HOST_PNG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// convert a YUYV framebuffer (two pixels per word, Y1 Cb Y2 Cr from the high byte down) to 8-bit rgb
+void png_xfbToRgb(const uint32_t *xfb, int width, int height, uint8_t *rgb);
+
+// write 8-bit rgb, 3 bytes a pixel
+bool png_write(const char *path, const uint8_t *rgb, int width, int height);
+
+#endif //GTS_HOST_PNG_H
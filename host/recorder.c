@@ -0,0 +1,162 @@
+//
+// Created on 2026/10/18.
+//
+
+// round trip for source/recorder.c, the block handoff and the .gtsr format, with a temporary file for the sd card
+// samples go through push, flushPartial, nextFull, release and writeBlock like the recorder menu does,
+// with the writer stalled part of the way so blocks get dropped, then the file is read back and compared
+// build with "make host", then run "./gtsrecorder"
+// exits with 1 if anything read back doesn't match what went in
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../source/recorder.h"
+
+// more than fits in the ring, so pushes fail while the writer is stalled
+#define STALLED_PUSHES ((RECORDER_BLOCKS * RECORDER_BLOCK_SAMPLES) + 100)
+#define MAX_SAMPLES (RECORDER_BLOCK_SAMPLES * 16)
+
+static bool failed = false;
+
+static void check(bool ok, const char *what) {
+	printf("  %-56s %s\n", what, ok ? "ok" : "FAIL");
+	failed |= !ok;
+}
+
+// a different sample for every n, with the sign bits and both bytes of the u16s in use
+static RecordSample sampleFor(uint32_t n) {
+	return (RecordSample) {
+		.ax = (int8_t) (n * 7), .ay = (int8_t) (n >> 8), .cx = (int8_t) -(n & 0x7F), .cy = (int8_t) (n * 5),
+		.tl = (uint8_t) n, .tr = (uint8_t) (n * 3),
+		.buttons = (uint16_t) (0x1234 ^ n), .intervalUs = (uint16_t) (0xABCD ^ (n * 13))
+	};
+}
+
+static Recorder recorder;
+// which n each sample that got in was made from, in order
+static uint32_t accepted[MAX_SAMPLES];
+static uint32_t acceptedCount = 0;
+static uint32_t nextSample = 0;
+static uint32_t blocksWritten = 0;
+
+static void push(uint32_t count) {
+	for (uint32_t i = 0; i < count; i++) {
+		RecordSample sample = sampleFor(nextSample);
+		if (recorder_push(&recorder, &sample, nextSample * 700) && acceptedCount < MAX_SAMPLES) {
+			accepted[acceptedCount++] = nextSample;
+		}
+		nextSample++;
+	}
+}
+
+// the writer thread's loop, until nothing is waiting
+static bool drain(FILE *fptr) {
+	RecorderBlock *block;
+	while ((block = recorder_nextFull(&recorder)) != NULL) {
+		uint32_t len = recorder_writeBlock(fptr, block);
+		if (len != RECORDER_BLOCK_HEADER_BYTES + (block->count * RECORDER_SAMPLE_BYTES)) {
+			return false;
+		}
+		recorder_release(&recorder);
+		blocksWritten++;
+	}
+	return true;
+}
+
+static void checkLayout(FILE *fptr) {
+	uint8_t bytes[RECORDER_FILE_HEADER_BYTES + RECORDER_BLOCK_HEADER_BYTES + RECORDER_SAMPLE_BYTES];
+	rewind(fptr);
+	bool read = fread(bytes, 1, sizeof(bytes), fptr) == sizeof(bytes);
+	const uint8_t header[RECORDER_FILE_HEADER_BYTES] = { 'G', 'T', 'S', 'R', RECORDER_VERSION, 0, RECORDER_SAMPLE_BYTES, 0,
+	                                                     RECORDER_BLOCK_SAMPLES & 0xFF, (RECORDER_BLOCK_SAMPLES >> 8) & 0xFF,
+	                                                     (RECORDER_BLOCK_SAMPLES >> 16) & 0xFF, 0, 0, 0, 0, 0 };
+	check(read && memcmp(bytes, header, sizeof(header)) == 0, "file header bytes");
+	// first block: sequence 0, a full block, nothing dropped, time 0
+	const uint8_t *block = bytes + RECORDER_FILE_HEADER_BYTES;
+	const uint8_t blockHeader[RECORDER_BLOCK_HEADER_BYTES] = { 0, 0, 0, 0, RECORDER_BLOCK_SAMPLES & 0xFF,
+	                                                           (RECORDER_BLOCK_SAMPLES >> 8) & 0xFF, 0, 0,
+	                                                           0, 0, 0, 0, 0, 0, 0, 0 };
+	check(read && memcmp(block, blockHeader, sizeof(blockHeader)) == 0, "block header bytes, little endian");
+	// sample 0 is all zeros apart from the u16s, which are 0x1234 and 0xabcd
+	const uint8_t sample[RECORDER_SAMPLE_BYTES] = { 0, 0, 0, 0, 0, 0, 0x34, 0x12, 0xCD, 0xAB };
+	check(read && memcmp(block + RECORDER_BLOCK_HEADER_BYTES, sample, sizeof(sample)) == 0,
+	      "sample bytes, little endian");
+}
+
+static void checkReadBack(FILE *fptr, uint32_t droppedExpected, uint32_t droppedBlock) {
+	rewind(fptr);
+	RecorderFileHeader header;
+	check(recorder_readHeader(fptr, &header) && header.samplesPerBlock == RECORDER_BLOCK_SAMPLES,
+	      "header reads back");
+
+	static RecorderBlock block;
+	uint32_t blocks = 0, samples = 0, dropped = 0, mismatched = 0;
+	bool inOrder = true, droppedWhere = true;
+	while (recorder_readBlock(fptr, &block)) {
+		inOrder &= block.sequence == blocks;
+		// drops are put on the first block the producer starts after them
+		droppedWhere &= block.dropped == (blocks == droppedBlock ? droppedExpected : 0);
+		dropped += block.dropped;
+		for (uint32_t i = 0; i < block.count; i++) {
+			RecordSample expected = sampleFor(samples < acceptedCount ? accepted[samples] : 0);
+			mismatched += samples >= acceptedCount || memcmp(&expected, &block.samples[i], sizeof(RecordSample)) != 0;
+			samples++;
+		}
+		blocks++;
+	}
+	printf("    %u blocks, %u samples, %u dropped\n", blocks, samples, dropped);
+	check(blocks == blocksWritten, "every block written reads back");
+	check(inOrder, "sequence numbers count up from 0");
+	check(samples == acceptedCount && samples == recorder.samplesTotal && mismatched == 0,
+	      "samples match what was pushed");
+	check(dropped == droppedExpected && dropped == recorder.droppedTotal && droppedWhere,
+	      "dropped samples counted on the right block");
+	check(feof(fptr), "nothing left after the last block");
+}
+
+int main(int argc, char **argv) {
+	FILE *fptr = tmpfile();
+	if (fptr == NULL) {
+		printf("couldn't make a temporary file\n");
+		return 1;
+	}
+	recorder_init(&recorder);
+	printf("recording\n");
+	check(recorder_writeHeader(fptr), "header written");
+
+	// a writer that keeps up
+	bool written = true;
+	for (int i = 0; i < 5; i++) {
+		push(RECORDER_BLOCK_SAMPLES / 2);
+		written &= drain(fptr);
+	}
+
+	// a writer that stalls, the ring fills and the rest are dropped
+	push(STALLED_PUSHES);
+	uint32_t stalledBlocks = blocksWritten + RECORDER_BLOCKS;
+	check(recorder_pending(&recorder) == RECORDER_BLOCKS, "ring full while the writer is stalled");
+	uint32_t dropped = recorder.droppedTotal;
+	printf("    %u samples dropped\n", dropped);
+	check(dropped != 0, "pushes fail when the ring is full");
+	written &= drain(fptr);
+
+	// then catches up, and the recording stops partway through a block
+	push(RECORDER_BLOCK_SAMPLES + 123);
+	recorder_flushPartial(&recorder);
+	written &= drain(fptr);
+	check(written, "every block written in full");
+	check(recorder_pending(&recorder) == 0 && recorder_nextFull(&recorder) == NULL, "nothing left waiting");
+	fflush(fptr);
+
+	printf("reading back\n");
+	checkLayout(fptr);
+	checkReadBack(fptr, dropped, stalledBlocks);
+	fclose(fptr);
+
+	if (failed) {
+		printf("\nFAILED\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,13 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_DEBUG_H
+#define GTS_SHIM_DEBUG_H
+
+#define GDBSTUB_DEVICE_USB 0
+
+void DEBUG_Init(int device, int channel);
+void _break(void);
+
+#endif //GTS_SHIM_DEBUG_H
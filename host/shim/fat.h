@@ -0,0 +1,13 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_FAT_H
+#define GTS_SHIM_FAT_H
+
+#include <stdbool.h>
+
+// always fails, runs should never depend on (or write to) /GTS on the host
+bool fatInitDefault(void);
+
+#endif //GTS_SHIM_FAT_H
@@ -0,0 +1,18 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_GCCORE_H
+#define GTS_SHIM_GCCORE_H
+
+#include <stdio.h>
+#include "gctypes.h"
+#include "ogc/color.h"
+#include "ogc/pad.h"
+#include "ogc/video.h"
+#include "ogc/system.h"
+#include "ogc/irq.h"
+#include "ogc/lwp.h"
+#include "ogc/lwp_watchdog.h"
+
+#endif //GTS_SHIM_GCCORE_H
@@ -0,0 +1,28 @@
+//
+// Created on 2026/10/18.
+//
+
+// stand-in for libogc's headers, so the menus can be built and run on a normal pc
+// only what GTS actually uses is here, see shim.c for how it behaves
+
+#ifndef GTS_SHIM_GCTYPES_H
+#define GTS_SHIM_GCTYPES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+// same as the console, so %llu works for both
+typedef unsigned long long u64;
+typedef int8_t s8;
+typedef int16_t s16;
+typedef int32_t s32;
+typedef long long s64;
+typedef float f32;
+
+#define TRUE 1
+#define FALSE 0
+
+#endif //GTS_SHIM_GCTYPES_H
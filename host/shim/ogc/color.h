@@ -0,0 +1,28 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_COLOR_H
+#define GTS_SHIM_COLOR_H
+
+// two pixels in YUYV, Y1 Cb Y2 Cr from the high byte down, same as the console
+#define COLOR_BLACK 0x00800080
+#define COLOR_MAROON 0x264B26A5
+#define COLOR_GREEN 0x4B554B4A
+#define COLOR_OLIVE 0x71287194
+#define COLOR_NAVY 0x0EC00E75
+#define COLOR_PURPLE 0x34AA34AA
+#define COLOR_TEAL 0x6B4A6B2D
+#define COLOR_GRAY 0x80808080
+#define COLOR_SILVER 0xC080C080
+#define COLOR_RED 0x4C544CFF
+#define COLOR_LIME 0x952B9515
+#define COLOR_YELLOW 0xE100E194
+#define COLOR_BLUE 0x1DFF1D6B
+#define COLOR_FUCHSIA 0x69D469EB
+#define COLOR_AQUA 0xB2AAB200
+#define COLOR_WHITE 0xFF80FF80
+#define COLOR_MEDGRAY 0x80808080
+#define COLOR_ORANGE 0xAD1EAD99
+
+#endif //GTS_SHIM_COLOR_H
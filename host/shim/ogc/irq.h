@@ -0,0 +1,14 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_IRQ_H
+#define GTS_SHIM_IRQ_H
+
+#include "../gctypes.h"
+
+// holds off the sampling callback until the matching restore, returns the previous state
+u32 IRQ_Disable(void);
+void IRQ_Restore(u32 level);
+
+#endif //GTS_SHIM_IRQ_H
@@ -0,0 +1,25 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_LWP_H
+#define GTS_SHIM_LWP_H
+
+#include "../gctypes.h"
+
+typedef u32 lwp_t;
+typedef u32 lwpq_t;
+
+#define LWP_THREAD_NULL 0xffffffff
+#define LWP_TQUEUE_NULL 0xffffffff
+
+s32 LWP_CreateThread(lwp_t *thethread, void *(*entry)(void *), void *arg, void *stackbase, u32 stack_size, u8 prio);
+s32 LWP_JoinThread(lwp_t thethread, void **value_ptr);
+void LWP_YieldThread(void);
+s32 LWP_InitQueue(lwpq_t *thequeue);
+void LWP_CloseQueue(lwpq_t thequeue);
+s32 LWP_ThreadSleep(lwpq_t thequeue);
+void LWP_ThreadSignal(lwpq_t thequeue);
+void LWP_ThreadBroadcast(lwpq_t thequeue);
+
+#endif //GTS_SHIM_LWP_H
@@ -0,0 +1,24 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_LWP_WATCHDOG_H
+#define GTS_SHIM_LWP_WATCHDOG_H
+
+#include "../gctypes.h"
+
+// same timebase as the gamecube, so tick math in the menus works unchanged
+#define TB_TIMER_CLOCK 40500
+
+#define ticks_to_secs(ticks) (((u64) (ticks) / (u64) (TB_TIMER_CLOCK * 1000)))
+#define ticks_to_millisecs(ticks) (((u64) (ticks) / (u64) (TB_TIMER_CLOCK)))
+#define ticks_to_microsecs(ticks) ((((u64) (ticks) * 8) / (u64) (TB_TIMER_CLOCK / 125)))
+#define ticks_to_nanosecs(ticks) ((((u64) (ticks) * 8000) / (u64) (TB_TIMER_CLOCK / 125)))
+#define secs_to_ticks(sec) ((u64) (sec) * (TB_TIMER_CLOCK * 1000))
+#define millisecs_to_ticks(msec) ((u64) (msec) * (TB_TIMER_CLOCK))
+#define microsecs_to_ticks(usec) (((u64) (usec) * (TB_TIMER_CLOCK / 125)) / 8)
+
+u64 gettime(void);
+u32 diff_usec(u64 start, u64 end);
+
+#endif //GTS_SHIM_LWP_WATCHDOG_H
@@ -0,0 +1,60 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_PAD_H
+#define GTS_SHIM_PAD_H
+
+#include "../gctypes.h"
+
+#define PAD_CHANMAX 4
+
+#define PAD_BUTTON_LEFT 0x0001
+#define PAD_BUTTON_RIGHT 0x0002
+#define PAD_BUTTON_DOWN 0x0004
+#define PAD_BUTTON_UP 0x0008
+#define PAD_TRIGGER_Z 0x0010
+#define PAD_TRIGGER_R 0x0020
+#define PAD_TRIGGER_L 0x0040
+#define PAD_BUTTON_A 0x0100
+#define PAD_BUTTON_B 0x0200
+#define PAD_BUTTON_X 0x0400
+#define PAD_BUTTON_Y 0x0800
+#define PAD_BUTTON_MENU 0x1000
+#define PAD_BUTTON_START 0x1000
+
+#define PAD_MOTOR_STOP 0
+#define PAD_MOTOR_RUMBLE 1
+
+typedef struct _padstatus {
+	u16 button;
+	s8 stickX;
+	s8 stickY;
+	s8 substickX;
+	s8 substickY;
+	u8 triggerL;
+	u8 triggerR;
+	u8 analogA;
+	u8 analogB;
+	s8 err;
+} PADStatus;
+
+typedef void (*sampling_callback)(void);
+
+u32 PAD_Init(void);
+u32 PAD_ScanPads(void);
+u32 PAD_Read(PADStatus *status);
+void PAD_GetOrigin(PADStatus *origin);
+u16 PAD_ButtonsUp(int pad);
+u16 PAD_ButtonsDown(int pad);
+u16 PAD_ButtonsHeld(int pad);
+s8 PAD_StickX(int pad);
+s8 PAD_StickY(int pad);
+s8 PAD_SubStickX(int pad);
+s8 PAD_SubStickY(int pad);
+u8 PAD_TriggerL(int pad);
+u8 PAD_TriggerR(int pad);
+u32 PAD_ControlMotor(s32 chan, u32 cmd);
+sampling_callback PAD_SetSamplingCallback(sampling_callback cb);
+
+#endif //GTS_SHIM_PAD_H
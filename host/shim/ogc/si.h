@@ -0,0 +1,13 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_SI_H
+#define GTS_SHIM_SI_H
+
+#include "../gctypes.h"
+
+// lines between polls, and polls per field, this sets the sampling callback rate in shim.c
+void SI_SetXY(u16 line, u8 cnt);
+
+#endif //GTS_SHIM_SI_H
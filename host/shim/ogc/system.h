@@ -0,0 +1,21 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_SYSTEM_H
+#define GTS_SHIM_SYSTEM_H
+
+#include "../gctypes.h"
+#include "video.h"
+
+#define SYS_POWEROFF 4
+
+// the framebuffer is already uncached here
+#define MEM_K0_TO_K1(x) (x)
+
+void *SYS_AllocateFramebuffer(GXRModeObj *rmode);
+u32 SYS_ResetButtonDown(void);
+void SYS_ResetSystem(s32 reset, u32 resetCode, s32 forceMenu);
+void SYS_SetPowerCallback(void (*callback)(void));
+
+#endif //GTS_SHIM_SYSTEM_H
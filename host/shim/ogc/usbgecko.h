@@ -0,0 +1,19 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_USBGECKO_H
+#define GTS_SHIM_USBGECKO_H
+
+#include "../gctypes.h"
+
+#define EXI_CHANNEL_0 0
+#define EXI_CHANNEL_1 1
+
+// there's never a gecko attached, messages are dropped
+int usb_isgeckoalive(s32 chn);
+void usb_flush(s32 chn);
+int usb_sendbuffer(s32 chn, const void *buffer, int size);
+int usb_sendbuffer_safe(s32 chn, const void *buffer, int size);
+
+#endif //GTS_SHIM_USBGECKO_H
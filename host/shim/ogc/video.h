@@ -0,0 +1,32 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_VIDEO_H
+#define GTS_SHIM_VIDEO_H
+
+#include "../gctypes.h"
+#include "video_types.h"
+
+typedef struct _gx_rmodeobj {
+	u32 viTVMode;
+	u16 fbWidth;
+	u16 efbHeight;
+	u16 xfbHeight;
+} GXRModeObj;
+
+typedef void (*VIRetraceCallback)(u32 retraceCnt);
+
+void VIDEO_Init(void);
+GXRModeObj *VIDEO_GetPreferredMode(GXRModeObj *mode);
+void VIDEO_Configure(GXRModeObj *rmode);
+void VIDEO_ClearFrameBuffer(GXRModeObj *rmode, void *fb, u32 color);
+void VIDEO_SetNextFramebuffer(void *fb);
+void VIDEO_SetBlack(bool black);
+void VIDEO_Flush(void);
+void VIDEO_WaitVSync(void);
+u32 VIDEO_GetScanMode(void);
+u32 VIDEO_GetCurrentTvMode(void);
+VIRetraceCallback VIDEO_SetPostRetraceCallback(VIRetraceCallback callback);
+
+#endif //GTS_SHIM_VIDEO_H
@@ -0,0 +1,19 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SHIM_VIDEO_TYPES_H
+#define GTS_SHIM_VIDEO_TYPES_H
+
+#define VI_DISPLAY_PIX_SZ 2
+
+#define VI_INTERLACE 0
+#define VI_NON_INTERLACE 1
+#define VI_PROGRESSIVE 2
+
+#define VI_NTSC 0
+#define VI_PAL 1
+#define VI_MPAL 2
+#define VI_EURGB60 5
+
+#endif //GTS_SHIM_VIDEO_TYPES_H
@@ -0,0 +1,410 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "shim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <gccore.h>
+#include <fat.h>
+#include <debug.h>
+#include <ogc/irq.h>
+#include <ogc/si.h>
+#include <ogc/usbgecko.h>
+
+#define FRAME_TICKS microsecs_to_ticks(SHIM_FRAME_US)
+// every gettime() call takes this long
+#define GETTIME_STEP_TICKS microsecs_to_ticks(1)
+// time for one video line, in 1/100 microseconds
+#define LINE_TIME_INTERLACED 6356
+#define LINE_TIME_PROGRESSIVE 3178
+
+static u64 now = 0;
+static u64 timeLimitTicks = 0;
+static u32 scanMode = VI_INTERLACE;
+
+static GXRModeObj mode = { VI_NTSC, SHIM_XFB_WIDTH, SHIM_XFB_HEIGHT, SHIM_XFB_HEIGHT };
+static void *shownXfb = NULL;
+static VIRetraceCallback retraceCallback = NULL;
+static u32 retraceCount = 0;
+
+static sampling_callback samplingCallback = NULL;
+static bool inSamplingCallback = false;
+// polls that come due while this is set wait for IRQ_Restore
+static bool irqDisabled = false;
+// two polls a frame until SI_SetXY says otherwise, same as the console's default
+static u64 pollIntervalTicks = 0;
+static u64 nextPollTick = 0;
+
+static ShimPadSource padSource = NULL;
+static ShimPadState pad;
+static ShimPadState padOrigin;
+static u16 prevButtons = 0;
+
+void shim_setPadSource(ShimPadSource source) {
+	padSource = source;
+}
+
+void shim_setOrigin(const ShimPadState *origin) {
+	padOrigin = *origin;
+}
+
+void shim_setScanMode(u32 mode) {
+	scanMode = mode;
+}
+
+void shim_setTimeLimitUs(u64 limitUs) {
+	timeLimitTicks = microsecs_to_ticks(limitUs);
+}
+
+u64 shim_timeUs() {
+	return ticks_to_microsecs(now);
+}
+
+u32 shim_frame() {
+	return now / FRAME_TICKS;
+}
+
+void *shim_shownFramebuffer() {
+	return shownXfb;
+}
+
+// run the sampling callback if a poll is due
+// time only moves a microsecond per gettime(), so this is never more than that late
+static void runPolls() {
+	if (samplingCallback == NULL || inSamplingCallback || irqDisabled) {
+		return;
+	}
+	while (nextPollTick <= now) {
+		nextPollTick += pollIntervalTicks;
+		inSamplingCallback = true;
+		samplingCallback();
+		inSamplingCallback = false;
+	}
+}
+
+u64 gettime(void) {
+	now += GETTIME_STEP_TICKS;
+	if (timeLimitTicks != 0 && now > timeLimitTicks) {
+		fprintf(stderr, "shim: passed the time limit at frame %u, is a menu waiting on input the script never sends?\n",
+		        shim_frame());
+		exit(2);
+	}
+	runPolls();
+	return now;
+}
+
+u32 diff_usec(u64 start, u64 end) {
+	return ticks_to_microsecs(end - start);
+}
+
+// pad
+
+u32 PAD_Init(void) {
+	memset(&pad, 0, sizeof(pad));
+	prevButtons = 0;
+	return 1;
+}
+
+u32 PAD_ScanPads(void) {
+	prevButtons = pad.buttons;
+	if (padSource != NULL) {
+		padSource(shim_timeUs(), &pad);
+	}
+	if (!pad.connected) {
+		memset(&pad, 0, sizeof(pad));
+		return 0;
+	}
+	return 1;
+}
+
+u32 PAD_Read(PADStatus *status) {
+	PAD_ScanPads();
+	memset(status, 0, sizeof(PADStatus) * PAD_CHANMAX);
+	status[0].button = pad.buttons;
+	status[0].stickX = pad.stickX;
+	status[0].stickY = pad.stickY;
+	status[0].substickX = pad.substickX;
+	status[0].substickY = pad.substickY;
+	status[0].triggerL = pad.triggerL;
+	status[0].triggerR = pad.triggerR;
+	status[0].err = pad.connected ? 0 : -1;
+	return pad.connected ? 1 : 0;
+}
+
+void PAD_GetOrigin(PADStatus *origin) {
+	// scripts are written relative to a perfectly centered controller, sessions bring their own
+	memset(origin, 0, sizeof(PADStatus) * PAD_CHANMAX);
+	origin[0].button = padOrigin.buttons;
+	origin[0].stickX = padOrigin.stickX;
+	origin[0].stickY = padOrigin.stickY;
+	origin[0].substickX = padOrigin.substickX;
+	origin[0].substickY = padOrigin.substickY;
+	origin[0].triggerL = padOrigin.triggerL;
+	origin[0].triggerR = padOrigin.triggerR;
+}
+
+u16 PAD_ButtonsUp(int chan) {
+	return chan == 0 ? (prevButtons & ~pad.buttons) : 0;
+}
+
+u16 PAD_ButtonsDown(int chan) {
+	return chan == 0 ? (pad.buttons & ~prevButtons) : 0;
+}
+
+u16 PAD_ButtonsHeld(int chan) {
+	return chan == 0 ? pad.buttons : 0;
+}
+
+s8 PAD_StickX(int chan) {
+	return chan == 0 ? pad.stickX : 0;
+}
+
+s8 PAD_StickY(int chan) {
+	return chan == 0 ? pad.stickY : 0;
+}
+
+s8 PAD_SubStickX(int chan) {
+	return chan == 0 ? pad.substickX : 0;
+}
+
+s8 PAD_SubStickY(int chan) {
+	return chan == 0 ? pad.substickY : 0;
+}
+
+u8 PAD_TriggerL(int chan) {
+	return chan == 0 ? pad.triggerL : 0;
+}
+
+u8 PAD_TriggerR(int chan) {
+	return chan == 0 ? pad.triggerR : 0;
+}
+
+u32 PAD_ControlMotor(s32 chan, u32 cmd) {
+	return 1;
+}
+
+sampling_callback PAD_SetSamplingCallback(sampling_callback cb) {
+	sampling_callback old = samplingCallback;
+	samplingCallback = cb;
+	nextPollTick = now + pollIntervalTicks;
+	return old;
+}
+
+void SI_SetXY(u16 line, u8 cnt) {
+	u32 lineTime = (scanMode == VI_PROGRESSIVE) ? LINE_TIME_PROGRESSIVE : LINE_TIME_INTERLACED;
+	u64 interval = microsecs_to_ticks(((u64) line * lineTime) / 100);
+	if (interval != pollIntervalTicks) {
+		pollIntervalTicks = interval;
+		nextPollTick = now + pollIntervalTicks;
+	}
+}
+
+// video
+
+void VIDEO_Init(void) {
+	now = 0;
+	retraceCount = 0;
+	pollIntervalTicks = FRAME_TICKS / 2;
+	nextPollTick = pollIntervalTicks;
+}
+
+GXRModeObj *VIDEO_GetPreferredMode(GXRModeObj *unused) {
+	return &mode;
+}
+
+void VIDEO_Configure(GXRModeObj *rmode) {
+}
+
+void VIDEO_ClearFrameBuffer(GXRModeObj *rmode, void *fb, u32 color) {
+	u32 *words = fb;
+	for (int i = 0; i < (rmode->fbWidth * rmode->xfbHeight) / 2; i++) {
+		words[i] = color;
+	}
+}
+
+void VIDEO_SetNextFramebuffer(void *fb) {
+	shownXfb = fb;
+}
+
+void VIDEO_SetBlack(bool black) {
+}
+
+void VIDEO_Flush(void) {
+}
+
+void VIDEO_WaitVSync(void) {
+	// polls keep happening while we wait
+	u64 frameEnd = ((now / FRAME_TICKS) + 1) * FRAME_TICKS;
+	if (samplingCallback != NULL && !inSamplingCallback && !irqDisabled) {
+		while (nextPollTick <= frameEnd) {
+			now = nextPollTick;
+			runPolls();
+		}
+	}
+	now = frameEnd;
+	retraceCount++;
+	if (retraceCallback != NULL) {
+		retraceCallback(retraceCount);
+	}
+}
+
+u32 VIDEO_GetScanMode(void) {
+	return scanMode;
+}
+
+u32 VIDEO_GetCurrentTvMode(void) {
+	return VI_NTSC;
+}
+
+VIRetraceCallback VIDEO_SetPostRetraceCallback(VIRetraceCallback callback) {
+	VIRetraceCallback old = retraceCallback;
+	retraceCallback = callback;
+	return old;
+}
+
+// system
+
+void *SYS_AllocateFramebuffer(GXRModeObj *rmode) {
+	return calloc(rmode->fbWidth * rmode->xfbHeight, VI_DISPLAY_PIX_SZ);
+}
+
+u32 IRQ_Disable(void) {
+	u32 level = irqDisabled;
+	irqDisabled = true;
+	return level;
+}
+
+void IRQ_Restore(u32 level) {
+	irqDisabled = level != 0;
+	// anything that came due while they were off
+	runPolls();
+}
+
+u32 SYS_ResetButtonDown(void) {
+	return 0;
+}
+
+void SYS_ResetSystem(s32 reset, u32 resetCode, s32 forceMenu) {
+	exit(0);
+}
+
+void SYS_SetPowerCallback(void (*callback)(void)) {
+}
+
+bool fatInitDefault(void) {
+	return false;
+}
+
+void DEBUG_Init(int device, int channel) {
+}
+
+void _break(void) {
+}
+
+int usb_isgeckoalive(s32 chn) {
+	return 0;
+}
+
+void usb_flush(s32 chn) {
+}
+
+int usb_sendbuffer(s32 chn, const void *buffer, int size) {
+	return size;
+}
+
+int usb_sendbuffer_safe(s32 chn, const void *buffer, int size) {
+	return size;
+}
+
+// threads, only the recorder uses these
+
+#define SHIM_MAX_THREADS 8
+#define SHIM_MAX_QUEUES 8
+
+typedef struct ShimQueue {
+	bool used;
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	// a signal with nobody sleeping is kept, so the sleeper can't miss it
+	u32 pending;
+} ShimQueue;
+
+static pthread_t threads[SHIM_MAX_THREADS];
+static bool threadUsed[SHIM_MAX_THREADS];
+static ShimQueue queues[SHIM_MAX_QUEUES];
+
+s32 LWP_CreateThread(lwp_t *thethread, void *(*entry)(void *), void *arg, void *stackbase, u32 stack_size, u8 prio) {
+	for (int i = 0; i < SHIM_MAX_THREADS; i++) {
+		if (!threadUsed[i]) {
+			if (pthread_create(&threads[i], NULL, entry, arg) != 0) {
+				return -1;
+			}
+			threadUsed[i] = true;
+			*thethread = i;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+s32 LWP_JoinThread(lwp_t thethread, void **value_ptr) {
+	if (thethread >= SHIM_MAX_THREADS || !threadUsed[thethread]) {
+		return -1;
+	}
+	pthread_join(threads[thethread], value_ptr);
+	threadUsed[thethread] = false;
+	return 0;
+}
+
+void LWP_YieldThread(void) {
+	sched_yield();
+}
+
+s32 LWP_InitQueue(lwpq_t *thequeue) {
+	for (int i = 0; i < SHIM_MAX_QUEUES; i++) {
+		if (!queues[i].used) {
+			queues[i].used = true;
+			queues[i].pending = 0;
+			pthread_mutex_init(&queues[i].lock, NULL);
+			pthread_cond_init(&queues[i].cond, NULL);
+			*thequeue = i;
+			return 0;
+		}
+	}
+	return -1;
+}
+
+void LWP_CloseQueue(lwpq_t thequeue) {
+	if (thequeue >= SHIM_MAX_QUEUES || !queues[thequeue].used) {
+		return;
+	}
+	pthread_mutex_destroy(&queues[thequeue].lock);
+	pthread_cond_destroy(&queues[thequeue].cond);
+	queues[thequeue].used = false;
+}
+
+s32 LWP_ThreadSleep(lwpq_t thequeue) {
+	ShimQueue *queue = &queues[thequeue];
+	pthread_mutex_lock(&queue->lock);
+	while (queue->pending == 0) {
+		pthread_cond_wait(&queue->cond, &queue->lock);
+	}
+	queue->pending--;
+	pthread_mutex_unlock(&queue->lock);
+	return 0;
+}
+
+void LWP_ThreadSignal(lwpq_t thequeue) {
+	ShimQueue *queue = &queues[thequeue];
+	pthread_mutex_lock(&queue->lock);
+	queue->pending = 1;
+	pthread_cond_signal(&queue->cond);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+void LWP_ThreadBroadcast(lwpq_t thequeue) {
+	LWP_ThreadSignal(thequeue);
+}
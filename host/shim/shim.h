@@ -0,0 +1,55 @@
+//
+// Created on 2026/10/18.
+//
+
+// harness side of the libogc shim
+// time is virtual: every gettime() call moves it forward by a microsecond, and VIDEO_WaitVSync moves it to the
+// next frame, so a run with the same input always takes the same path through the menus
+// the sampling callback fires from inside gettime() and VIDEO_WaitVSync once its next poll is due,
+// which is close enough to the interrupt on the console for the menus that busy-wait on it
+// everything here is single threaded, LWP threads exist but shouldn't touch the clock
+
+#ifndef GTS_SHIM_H
+#define GTS_SHIM_H
+
+#include "gctypes.h"
+
+// ntsc, 59.94 hz
+#define SHIM_FRAME_US 16683
+#define SHIM_XFB_WIDTH 640
+#define SHIM_XFB_HEIGHT 480
+
+typedef struct ShimPadState {
+	bool connected;
+	u16 buttons;
+	s8 stickX;
+	s8 stickY;
+	s8 substickX;
+	s8 substickY;
+	u8 triggerL;
+	u8 triggerR;
+} ShimPadState;
+
+// called on every PAD_ScanPads with the current virtual time
+typedef void (*ShimPadSource)(u64 timeUs, ShimPadState *state);
+
+void shim_setPadSource(ShimPadSource source);
+
+// what PAD_GetOrigin reports, centered unless this is called
+void shim_setOrigin(const ShimPadState *origin);
+
+// VI_INTERLACE or VI_PROGRESSIVE, needs to be set before VIDEO_Init
+void shim_setScanMode(u32 scanMode);
+
+// gettime() exits the program once virtual time passes this
+// the menus block in a few places until the stick moves, this stops a script that never moves it from hanging
+void shim_setTimeLimitUs(u64 limitUs);
+
+u64 shim_timeUs();
+// frames since VIDEO_Init, a frame that blocked for a while skips ahead
+u32 shim_frame();
+
+// the framebuffer from the last VIDEO_SetNextFramebuffer
+void *shim_shownFramebuffer();
+
+#endif //GTS_SHIM_H
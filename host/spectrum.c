@@ -0,0 +1,164 @@
+//
+// Created on 2026/10/18.
+//
+
+// checks the fixed point fft in source/analysis/spectrum.c against a double precision dft,
+// checks spectrum_analyze on synthetic snapbacks with a known frequency and decay, then times both
+// build with "make host", then run "./gtsspectrum [-n iterations]"
+// exits with 1 if the fft's error or the frequency estimates are outside the limits below
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include "../source/analysis/spectrum.h"
+
+// signal to error ratio the fft has to reach on every test input
+#define MIN_SNR_DB 40.0
+// the frequency estimate has to be this close, in bins, when the ringing lasts long enough to see
+#define MAX_FREQ_ERROR_BINS 1.0
+// and the decay this close, as a fraction
+#define MAX_DECAY_ERROR 0.25
+
+static uint64_t nowNs() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t) ts.tv_sec * 1000000000ull) + ts.tv_nsec;
+}
+
+// returns the signal to error ratio in db
+static double checkFft(const char *name, const int16_t *input) {
+	static int16_t re[SPECTRUM_LEN], im[SPECTRUM_LEN];
+	memcpy(re, input, sizeof(re));
+	memset(im, 0, sizeof(im));
+	spectrum_fft(re, im);
+
+	double signal = 0, error = 0;
+	for (int k = 0; k < SPECTRUM_LEN; k++) {
+		double refRe = 0, refIm = 0;
+		for (int n = 0; n < SPECTRUM_LEN; n++) {
+			double angle = (-2.0 * M_PI * k * n) / SPECTRUM_LEN;
+			refRe += input[n] * cos(angle);
+			refIm += input[n] * sin(angle);
+		}
+		// the fixed point version is scaled down by the length
+		refRe /= SPECTRUM_LEN;
+		refIm /= SPECTRUM_LEN;
+		signal += (refRe * refRe) + (refIm * refIm);
+		error += ((re[k] - refRe) * (re[k] - refRe)) + ((im[k] - refIm) * (im[k] - refIm));
+	}
+	double snr = error > 0 ? 10.0 * log10(signal / error) : 999.0;
+	printf("  %-10s %6.1f dB\n", name, snr);
+	return snr;
+}
+
+// held at full for a bit, then released, ringing as a damped cosine around 0
+static void makeSnapback(WaveformData *data, double freqHz, double decayMs) {
+	memset(data, 0, sizeof(WaveformData));
+	double timeMs = 0;
+	for (int i = 0; i < WAVEFORM_SAMPLES; i++) {
+		// polls are ~700us apart, with some jitter
+		uint64_t stepUs = i == 0 ? 0 : 650 + (rand() % 100);
+		timeMs += stepUs / 1000.0;
+		data->data[i].timeDiffUs = stepUs;
+		double value = 100;
+		if (timeMs > 50) {
+			double t = timeMs - 50;
+			value = 100 * exp(-t / decayMs) * cos(2 * M_PI * freqHz * t / 1000.0);
+		}
+		data->data[i].ax = (int) lround(value);
+	}
+	data->endPoint = WAVEFORM_SAMPLES;
+	data->isDataReady = true;
+}
+
+static void usage(const char *name) {
+	fprintf(stderr, "usage: %s [-n iterations]\n", name);
+}
+
+int main(int argc, char **argv) {
+	int iterations = 2000;
+	int opt;
+	while ((opt = getopt(argc, argv, "n:h")) != -1) {
+		switch (opt) {
+			case 'n':
+				iterations = atoi(optarg);
+				break;
+			default:
+				usage(argv[0]);
+				return 1;
+		}
+	}
+	if (iterations < 1) {
+		iterations = 1;
+	}
+	srand(1);
+	bool failed = false;
+
+	printf("fft against a double precision dft, %d points\n", SPECTRUM_LEN);
+	int16_t input[SPECTRUM_LEN];
+	for (int i = 0; i < SPECTRUM_LEN; i++) {
+		input[i] = (int16_t) lround(16000 * sin((2 * M_PI * 37 * i) / SPECTRUM_LEN));
+	}
+	failed |= checkFft("sine", input) < MIN_SNR_DB;
+	for (int i = 0; i < SPECTRUM_LEN; i++) {
+		input[i] = (int16_t) lround((8000 * sin((2 * M_PI * 12.3 * i) / SPECTRUM_LEN)) +
+		                            (4000 * cos((2 * M_PI * 101.7 * i) / SPECTRUM_LEN)));
+	}
+	failed |= checkFft("two tones", input) < MIN_SNR_DB;
+	for (int i = 0; i < SPECTRUM_LEN; i++) {
+		input[i] = (rand() % 32001) - 16000;
+	}
+	failed |= checkFft("noise", input) < MIN_SNR_DB;
+
+	printf("\nsynthetic snapbacks\n");
+	printf("  %8s %8s | %8s %8s %8s\n", "hz", "decay", "found hz", "decay", "floor");
+	static WaveformData data;
+	static SpectrumResult result;
+	const double freqs[] = { 15, 30, 60, 120 };
+	const double decays[] = { 15, 40, 100 };
+	for (int f = 0; f < 4; f++) {
+		for (int d = 0; d < 3; d++) {
+			makeSnapback(&data, freqs[f], decays[d]);
+			spectrum_analyze(&data, false, &result);
+			printf("  %8.1f %8.1f | %8.2f %8.2f %8.1f", freqs[f], decays[d], result.peakHz, result.decayMs,
+			       result.noiseFloorDb);
+			// short ringing only has a couple of cycles, there's not enough there for the limits to mean anything
+			bool check = (freqs[f] * decays[d] / 1000.0) >= 1.0;
+			bool bad = !result.found;
+			if (check) {
+				bad |= fabs(result.peakHz - freqs[f]) > MAX_FREQ_ERROR_BINS * spectrum_binHz(1);
+				bad |= fabs(result.decayMs - decays[d]) > MAX_DECAY_ERROR * decays[d];
+			}
+			printf("%s\n", bad ? "  FAIL" : (check ? "" : "  (not checked)"));
+			failed |= bad;
+		}
+	}
+
+	printf("\ntiming, %d runs\n", iterations);
+	int16_t re[SPECTRUM_LEN], im[SPECTRUM_LEN];
+	uint64_t start = nowNs();
+	for (int i = 0; i < iterations; i++) {
+		memcpy(re, input, sizeof(re));
+		memset(im, 0, sizeof(im));
+		spectrum_fft(re, im);
+	}
+	uint64_t fftNs = (nowNs() - start) / iterations;
+	makeSnapback(&data, 40, 40);
+	start = nowNs();
+	for (int i = 0; i < iterations; i++) {
+		spectrum_analyze(&data, false, &result);
+	}
+	uint64_t analyzeNs = (nowNs() - start) / iterations;
+	printf("  fft      %8.2f us\n", fftNs / 1000.0);
+	printf("  analyze  %8.2f us (resample, window, fft, db, median)\n", analyzeNs / 1000.0);
+	printf("  %d butterflies per fft\n", (SPECTRUM_LEN / 2) * SPECTRUM_LOG2_LEN);
+
+	if (failed) {
+		printf("\nFAILED\n");
+		return 1;
+	}
+	return 0;
+}
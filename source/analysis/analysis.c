@@ -0,0 +1,311 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "analysis.h"
+#include <stdlib.h>
+#include "fixed.h"
+
+// a frame is 50000/3 us, so times are multiplied by 3 before being compared with it, to keep it a whole number
+#define FRAME_TIME_US_X3 50000
+#define PERCENT_MAX fixed_fromInt(100)
+
+void analysis_stickRange(const WaveformData *data, unsigned int start, unsigned int end, bool cStick, StickRange *range) {
+	if (end > data->endPoint) {
+		end = data->endPoint;
+	}
+	if (start >= end) {
+		*range = (StickRange) { 0, 0, 0, 0 };
+		return;
+	}
+
+	// initialize stat values to first point
+	int x = cStick ? data->data[start].cx : data->data[start].ax;
+	int y = cStick ? data->data[start].cy : data->data[start].ay;
+	range->minX = x, range->maxX = x;
+	range->minY = y, range->maxY = y;
+
+	for (unsigned int i = start + 1; i < end; i++) {
+		x = cStick ? data->data[i].cx : data->data[i].ax;
+		y = cStick ? data->data[i].cy : data->data[i].ay;
+		if (range->minX > x) {
+			range->minX = x;
+		}
+		if (range->maxX < x) {
+			range->maxX = x;
+		}
+		if (range->minY > y) {
+			range->minY = y;
+		}
+		if (range->maxY < y) {
+			range->maxY = y;
+		}
+	}
+}
+
+bool analysis_pivot(const WaveformData *data, PivotResult *result) {
+	bool pivotHit80 = false;
+	bool prevPivotHit80 = false;
+	bool leftPivotRange = false;
+	bool prevLeftPivotRange = false;
+	int pivotStartIndex = -1, pivotEndIndex = -1;
+	int pivotStartSign = 0;
+	// start from the back of the list
+	for (int i = data->endPoint - 1; i >= 0; i--) {
+		// check x coordinate for +-64 (dash threshold)
+		if ( (data->data[i].ax >= 64 || data->data[i].ax <= -64) && !leftPivotRange) {
+			if (pivotEndIndex == -1) {
+				pivotEndIndex = i;
+			}
+			// pivot input must hit 80 on both sides
+			if (data->data[i].ax >= 80 || data->data[i].ax <= -80) {
+				pivotHit80 = true;
+			}
+		}
+
+		// are we outside the pivot range and have already logged data of being in range
+		if (pivotEndIndex != -1 && data->data[i].ax < 64 && data->data[i].ax > -64) {
+			leftPivotRange = true;
+			if (pivotStartIndex == -1) {
+				// need the "previous" poll since this one is out of the range
+				pivotStartIndex = i + 1;
+			}
+			if (prevLeftPivotRange || !pivotHit80) {
+				break;
+			}
+		}
+
+		// look for the initial input
+		if ( (data->data[i].ax >= 64 || data->data[i].ax <= -64) && leftPivotRange) {
+			// used to ensure starting input is from the opposite side
+			if (pivotStartSign == 0) {
+				pivotStartSign = data->data[i].ax;
+			}
+			prevLeftPivotRange = true;
+			if (data->data[i].ax >= 80 || data->data[i].ax <= -80) {
+				prevPivotHit80 = true;
+				break;
+			}
+		}
+	}
+
+	// phobvision doc says both sides need to hit 80 to succeed
+	// multiplication is to ensure signs are correct
+	if (!(prevPivotHit80 && pivotHit80 && (data->data[pivotEndIndex].ax * pivotStartSign < 0))) {
+		return false;
+	}
+
+	result->timeInRangeUs = 0;
+	for (int i = pivotStartIndex; i <= pivotEndIndex; i++) {
+		result->timeInRangeUs += data->data[i].timeDiffUs;
+	}
+
+	fix16 noTurnPercent = 0, pivotPercent, dashbackPercent = 0;
+
+	result->timeInRangeMs = fixed_toFloat(fixed_usToMs(result->timeInRangeUs));
+
+	// how long a poll could occur that would cause a miss, times 3
+	int64_t diffFrameTimePoll = FRAME_TIME_US_X3 - (int64_t) result->timeInRangeUs * 3;
+
+	// negative time difference, dashback
+	if (diffFrameTimePoll < 0) {
+		dashbackPercent = fixed_clamp(fixed_percent(-diffFrameTimePoll, FRAME_TIME_US_X3), 0, PERCENT_MAX);
+		pivotPercent = PERCENT_MAX - dashbackPercent;
+	// positive or 0 time diff, no turn
+	} else {
+		noTurnPercent = fixed_clamp(fixed_percent(diffFrameTimePoll, FRAME_TIME_US_X3), 0, PERCENT_MAX);
+		pivotPercent = PERCENT_MAX - noTurnPercent;
+	}
+
+	result->noTurnPercent = fixed_toFloat(noTurnPercent);
+	result->pivotPercent = fixed_toFloat(pivotPercent);
+	result->dashbackPercent = fixed_toFloat(dashbackPercent);
+	return true;
+}
+
+void analysis_dashback(const WaveformData *data, DashbackResult *result) {
+	// go forward in list
+	int dashbackStartIndex = -1, dashbackEndIndex = -1;
+	uint64_t timeInRange = 0;
+	for (int i = 0; i < data->endPoint; i++) {
+		// is the stick in the range
+		if ((data->data[i].ax >= 23 && data->data[i].ax < 64) || (data->data[i].ax <= -23 && data->data[i].ax > -64)) {
+			timeInRange += data->data[i].timeDiffUs;
+			if (dashbackStartIndex == -1) {
+				dashbackStartIndex = i;
+			}
+		} else if (dashbackStartIndex != -1) {
+			dashbackEndIndex = i - 1;
+			break;
+		}
+	}
+
+	if (dashbackEndIndex == -1) {
+		result->timeInRangeMs = 0;
+		result->vanillaPercent = 0;
+		result->ucfPercent = 0;
+		return;
+	}
+
+	result->timeInRangeMs = fixed_toFloat(fixed_usToMs(timeInRange));
+
+	// the chance the game's poll doesn't land in the range
+	fix16 vanillaPercent = fixed_percent(FRAME_TIME_US_X3 - (int64_t) timeInRange * 3, FRAME_TIME_US_X3);
+
+	// ucf dashback is a little more involved
+	uint64_t ucfTimeInRange = timeInRange;
+	for (int i = dashbackStartIndex; i <= dashbackEndIndex; i++) {
+		// we're gonna assume that the previous frame polled around the origin, because i cant be bothered
+		// it also makes the math easier
+		uint64_t usFromPoll = 0;
+		int nextPollIndex = i;
+		// we need the sample that would occur around 1f after
+		// imported captures can end early, so don't go past the last sample
+		while (usFromPoll < 16666 && nextPollIndex < data->endPoint - 1) {
+			nextPollIndex++;
+			usFromPoll += data->data[nextPollIndex].timeDiffUs;
+		}
+		// the two frames need to move more than 75 units for UCF to convert it
+		if (data->data[i].ax + data->data[nextPollIndex].ax > 75 ||
+				data->data[i].ax + data->data[nextPollIndex].ax < -75) {
+			ucfTimeInRange -= data->data[i].timeDiffUs;
+		}
+	}
+
+	fix16 ucfPercent = PERCENT_MAX;
+	if (ucfTimeInRange != 0) {
+		ucfPercent = fixed_percent(FRAME_TIME_US_X3 - (int64_t) ucfTimeInRange * 3, FRAME_TIME_US_X3);
+	}
+
+	// over 100 shouldn't happen in theory, maybe on box?
+	// under 0 definitely can happen though
+	result->vanillaPercent = fixed_toFloat(fixed_clamp(vanillaPercent, 0, PERCENT_MAX));
+	result->ucfPercent = fixed_toFloat(fixed_clamp(ucfPercent, 0, PERCENT_MAX));
+}
+
+enum MOTION_TYPE analysis_classify(const WaveformData *data, bool cStick, MotionFeatures *features) {
+	MotionFeatures local;
+	if (features == NULL) {
+		features = &local;
+	}
+	*features = (MotionFeatures) { 0 };
+	if (data->endPoint == 0) {
+		return MOTION_NONE;
+	}
+
+	int startX = cStick ? data->data[0].cx : data->data[0].ax;
+	int startY = cStick ? data->data[0].cy : data->data[0].ay;
+	features->startDistance = abs(startX) > abs(startY) ? abs(startX) : abs(startY);
+
+	// last side x was past the deadzone and the dash threshold on, 0 for neither yet
+	int deadzoneSide = 0, dashSide = 0;
+	bool inDash = false;
+	int x = 0, y = 0;
+	for (unsigned int i = 0; i < data->endPoint; i++) {
+		x = cStick ? data->data[i].cx : data->data[i].ax;
+		y = cStick ? data->data[i].cy : data->data[i].ay;
+
+		int side = (x >= 23) - (x <= -23);
+		if (side != 0) {
+			if (deadzoneSide != 0 && side != deadzoneSide) {
+				features->zeroCrossings++;
+			}
+			deadzoneSide = side;
+		}
+
+		if (x >= 64 || x <= -64) {
+			if (!inDash) {
+				inDash = true;
+				features->dashEntries++;
+				features->lastDwellUs = 0;
+				int sign = x > 0 ? 1 : -1;
+				if (dashSide != 0 && sign != dashSide) {
+					features->dashSideSwitches++;
+				}
+				dashSide = sign;
+			}
+			features->lastDwellUs += data->data[i].timeDiffUs;
+		} else {
+			inDash = false;
+		}
+	}
+	features->returnedToOrigin = x > -23 && x < 23 && y > -23 && y < 23;
+
+	// a capture that ends somewhere else was cut off, or was just the stick being moved around
+	if (!features->returnedToOrigin) {
+		return MOTION_NONE;
+	}
+	// the capture starts when the stick leaves where it was held, which is still far out for a release
+	if (features->startDistance >= 64) {
+		return MOTION_SNAPBACK;
+	}
+	if (cStick) {
+		return MOTION_NONE;
+	}
+	if (features->dashSideSwitches != 0 && features->zeroCrossings != 0 && features->lastDwellUs <= MOTION_PIVOT_MAX_DWELL_US) {
+		return MOTION_PIVOT;
+	}
+	if (features->dashEntries != 0) {
+		return MOTION_DASHBACK;
+	}
+	return MOTION_NONE;
+}
+
+void analysis_runAll(const WaveformData *data, bool cStick, AnalysisReport *report) {
+	report->motion = analysis_classify(data, cStick, &report->features);
+	analysis_stickRange(data, 0, data->endPoint, cStick, &report->range);
+	report->pivotFound = false;
+	report->pivot = (PivotResult) { 0 };
+	report->dashback = (DashbackResult) { 0 };
+	switch (report->motion) {
+		case MOTION_PIVOT:
+			report->pivotFound = analysis_pivot(data, &report->pivot);
+			break;
+		case MOTION_DASHBACK:
+			analysis_dashback(data, &report->dashback);
+			break;
+		default:
+			break;
+	}
+}
+
+// scales one axis of a stick past the rim back to a magnitude of 80, truncated like melee does
+// v * 80 / magnitude is the square root of v^2 * 6400 / magnitude^2, and flooring the division first doesn't
+// change the floor of the square root, so this is exact with one divide and no floats
+static int scaleToRim(int value, int magnitudeSquared) {
+	uint32_t scaled = fixed_isqrt((uint32_t) (80 * 80 * value * value) / (uint32_t) magnitudeSquared);
+	return value < 0 ? -(int) scaled : (int) scaled;
+}
+
+// a lot of this comes from github.com/phobgcc/phobconfigtool
+WaveformDatapoint convertStickValues(WaveformDatapoint *data) {
+	WaveformDatapoint retData;
+
+	retData.ax = data->ax, retData.ay = data->ay;
+	retData.cx = data->cx, retData.cy = data->cy;
+
+	// store whether x or y are negative
+	retData.isAXNegative = (retData.ax < 0) ? true : false;
+	retData.isAYNegative = (retData.ay < 0) ? true : false;
+	retData.isCXNegative = (retData.cx < 0) ? true : false;
+	retData.isCYNegative = (retData.cy < 0) ? true : false;
+
+	int stickMagnitudeSquared = (retData.ax * retData.ax) + (retData.ay * retData.ay);
+	int cStickMagnitudeSquared = (retData.cx * retData.cx) + (retData.cy * retData.cy);
+
+	// magnitude must be between 0 and 80
+	if (stickMagnitudeSquared > 80 * 80) {
+		retData.ax = scaleToRim(retData.ax, stickMagnitudeSquared);
+		retData.ay = scaleToRim(retData.ay, stickMagnitudeSquared);
+	}
+	if (cStickMagnitudeSquared > 80 * 80) {
+		retData.cx = scaleToRim(retData.cx, cStickMagnitudeSquared);
+		retData.cy = scaleToRim(retData.cy, cStickMagnitudeSquared);
+	}
+
+	// convert to the decimal format for melee, each unit is 0.0125
+	retData.ax = abs(retData.ax) * 125, retData.ay = abs(retData.ay) * 125;
+	retData.cx = abs(retData.cx) * 125, retData.cy = abs(retData.cy) * 125;
+
+	return retData;
+}
@@ -0,0 +1,98 @@
+//
+// Created on 2026/10/18.
+//
+
+// results for the oscilloscope tests, and the melee coordinate conversion
+// gtsbatch re-runs these on exported captures
+// a lot of the specific values are taken from:
+// https://github.com/PhobGCC/PhobGCC-doc/blob/main/For_Users/Phobvision_Guide_Latest.md
+
+#ifndef GTS_ANALYSIS_H
+#define GTS_ANALYSIS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../waveform.h"
+
+static const float FRAME_TIME_MS = (1000/60.0);
+
+// min/max of a stick over part of a capture, the snapback result
+typedef struct StickRange {
+	int minX;
+	int maxX;
+	int minY;
+	int maxY;
+} StickRange;
+
+typedef struct PivotResult {
+	// time spent past the dash threshold on the second side
+	uint64_t timeInRangeUs;
+	float timeInRangeMs;
+	// chance of each outcome, based on where the game's poll lands
+	float noTurnPercent;
+	float pivotPercent;
+	float dashbackPercent;
+} PivotResult;
+
+typedef struct DashbackResult {
+	// time between the deadzone and the dash threshold on the first input
+	float timeInRangeMs;
+	float vanillaPercent;
+	float ucfPercent;
+} DashbackResult;
+
+// what a capture looks like, in the same order as enum OSCILLOSCOPE_TEST
+enum MOTION_TYPE { MOTION_SNAPBACK, MOTION_PIVOT, MOTION_DASHBACK, MOTION_NONE };
+
+// a pivot's second side is only held for about a frame, anything held longer is a turnaround
+#define MOTION_PIVOT_MAX_DWELL_US 50000
+
+typedef struct MotionFeatures {
+	// furthest either axis was from the origin on the first sample
+	int startDistance;
+	// x went from one side of the deadzone to the other
+	int zeroCrossings;
+	// separate times x went past the dash threshold, and how many of those were on the other side from the last
+	int dashEntries;
+	int dashSideSwitches;
+	// time spent past the dash threshold on the last entry
+	uint64_t lastDwellUs;
+	// both axes ended inside the deadzone
+	bool returnedToOrigin;
+} MotionFeatures;
+
+// everything that applies to a capture, from one call
+typedef struct AnalysisReport {
+	enum MOTION_TYPE motion;
+	MotionFeatures features;
+	// over the whole capture
+	StickRange range;
+	bool pivotFound;
+	PivotResult pivot;
+	DashbackResult dashback;
+} AnalysisReport;
+
+// stick range from start up to (not including) end
+// uses the c-stick instead if cStick is true
+void analysis_stickRange(const WaveformData *data, unsigned int start, unsigned int end, bool cStick, StickRange *range);
+
+// find the last pivot input in a capture, returns false if there isn't a valid one
+bool analysis_pivot(const WaveformData *data, PivotResult *result);
+
+// time the stick spends between the deadzone and the dash threshold on the first input
+void analysis_dashback(const WaveformData *data, DashbackResult *result);
+
+// looks at a finished capture and decides which test it was, in one pass
+// released from a held position is a snapback, out past the dash threshold and back is a dashback,
+// and out past it on one side then briefly the other is a pivot
+// features can be NULL
+enum MOTION_TYPE analysis_classify(const WaveformData *data, bool cStick, MotionFeatures *features);
+
+// classifies the capture, then runs the analyzers that apply to it
+// pivot and dashback only look at the analog stick, so a c-stick capture is a snapback or nothing
+void analysis_runAll(const WaveformData *data, bool cStick, AnalysisReport *report);
+
+// converts raw input values to melee coordinates
+WaveformDatapoint convertStickValues(WaveformDatapoint *data);
+
+#endif //GTS_ANALYSIS_H
@@ -0,0 +1,111 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "attempts.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+void attempts_reset(AttemptSession *session) {
+	memset(session, 0, sizeof(AttemptSession));
+	session->lastTest = -1;
+}
+
+// furthest past the origin on the other side from where the stick was held
+static float snapbackOvershoot(const WaveformData *data, bool cStick) {
+	StickRange range;
+	analysis_stickRange(data, 0, data->endPoint, cStick, &range);
+	int startX = cStick ? data->data[0].cx : data->data[0].ax;
+	int startY = cStick ? data->data[0].cy : data->data[0].ay;
+	int overshoot;
+	if (abs(startY) > abs(startX)) {
+		overshoot = startY > 0 ? -range.minY : range.maxY;
+	} else {
+		overshoot = startX > 0 ? -range.minX : range.maxX;
+	}
+	return overshoot > 0 ? overshoot : 0;
+}
+
+int attempts_bin(enum MOTION_TYPE test, float value) {
+	if (test >= ATTEMPT_TESTS || value < 0) {
+		return 0;
+	}
+	int bin = value / ATTEMPT_BIN_WIDTH[test];
+	return bin < ATTEMPT_BINS ? bin : ATTEMPT_BINS - 1;
+}
+
+void attempts_add(AttemptSession *session, const WaveformData *data, bool cStick, enum MOTION_TYPE test, AttemptRow *row) {
+	AttemptRow attempt = { 0 };
+	session->attempts++;
+	attempt.number = session->attempts;
+	attempt.test = test;
+	for (unsigned int i = 1; i < data->endPoint; i++) {
+		attempt.durationUs += data->data[i].timeDiffUs;
+	}
+
+	switch (test) {
+		case MOTION_SNAPBACK:
+			attempt.value = snapbackOvershoot(data, cStick);
+			attempt.measured = true;
+			attempt.success = attempt.value <= ATTEMPT_SNAPBACK_MAX;
+			break;
+		case MOTION_PIVOT: {
+			PivotResult pivot = { 0 };
+			if (analysis_pivot(data, &pivot)) {
+				attempt.value = pivot.timeInRangeMs;
+				attempt.measured = true;
+				attempt.percent = pivot.pivotPercent;
+				attempt.success = pivot.pivotPercent >= ATTEMPT_SUCCESS_PERCENT;
+			}
+			break;
+		}
+		case MOTION_DASHBACK: {
+			DashbackResult dashback;
+			analysis_dashback(data, &dashback);
+			attempt.value = dashback.timeInRangeMs;
+			attempt.measured = true;
+			attempt.percent = dashback.ucfPercent;
+			attempt.success = dashback.ucfPercent >= ATTEMPT_SUCCESS_PERCENT;
+			break;
+		}
+		default:
+			attempt.test = MOTION_NONE;
+			session->unknown++;
+			break;
+	}
+
+	if (attempt.test != MOTION_NONE) {
+		AttemptTotals *totals = &session->tests[attempt.test];
+		totals->attempts++;
+		if (attempt.success) {
+			totals->successes++;
+		}
+		session->lastTest = attempt.test;
+	}
+	// a failed pivot with no second side has nothing to go in the mean
+	if (attempt.measured) {
+		AttemptTotals *totals = &session->tests[attempt.test];
+		totals->measured++;
+		double delta = attempt.value - totals->mean;
+		totals->mean += delta / totals->measured;
+		totals->m2 += delta * (attempt.value - totals->mean);
+		if (totals->measured == 1 || attempt.value < totals->min) {
+			totals->min = attempt.value;
+		}
+		if (totals->measured == 1 || attempt.value > totals->max) {
+			totals->max = attempt.value;
+		}
+		totals->histogram[attempts_bin(attempt.test, attempt.value)]++;
+	}
+	if (row != NULL) {
+		*row = attempt;
+	}
+}
+
+float attempts_stdDev(const AttemptTotals *totals) {
+	if (totals->measured < 2) {
+		return 0;
+	}
+	return sqrt(totals->m2 / (totals->measured - 1));
+}
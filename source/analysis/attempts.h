@@ -0,0 +1,78 @@
+//
+// Created on 2026/10/18.
+//
+
+// practice sessions, every capture is an attempt at a test and gets added to that test's totals
+// the totals are running (Welford's mean and variance, a fixed histogram), so nothing about an attempt is kept
+// once it's added, and a session of any length takes the same space
+
+#ifndef GTS_ATTEMPTS_H
+#define GTS_ATTEMPTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../waveform.h"
+#include "analysis.h"
+
+// snapback, pivot and dashback, in enum MOTION_TYPE order
+#define ATTEMPT_TESTS 3
+#define ATTEMPT_BINS 16
+// what each histogram bin covers, in the test's units, the last bin also has everything past it
+static const float ATTEMPT_BIN_WIDTH[ATTEMPT_TESTS] = { 4, 2, 2 };
+static const char *const ATTEMPT_UNITS[ATTEMPT_TESTS] = { "units", "ms", "ms" };
+
+// a snapback is a success if it doesn't go past the deadzone on the other side
+#define ATTEMPT_SNAPBACK_MAX 22
+// pivots and dashbacks are a success when they come out more often than not
+#define ATTEMPT_SUCCESS_PERCENT 50
+
+// one attempt, what gets exported
+typedef struct AttemptRow {
+	uint32_t number;
+	enum MOTION_TYPE test;
+	bool success;
+	// false if there was nothing to measure, a pivot without a second side
+	bool measured;
+	// snapback: furthest the stick went past the origin after the release
+	// pivot: time past the dash threshold on the second side, dashback: time between the deadzone and dash threshold
+	float value;
+	// snapback: 0, pivot: chance of a pivot, dashback: chance of a ucf dashback
+	float percent;
+	uint64_t durationUs;
+} AttemptRow;
+
+typedef struct AttemptTotals {
+	uint32_t attempts;
+	uint32_t successes;
+	// attempts with a value, the rest of these are only over those
+	uint32_t measured;
+	double mean;
+	// sum of squared differences from the mean
+	double m2;
+	float min;
+	float max;
+	uint32_t histogram[ATTEMPT_BINS];
+} AttemptTotals;
+
+typedef struct AttemptSession {
+	AttemptTotals tests[ATTEMPT_TESTS];
+	// captures that weren't any of the tests
+	uint32_t unknown;
+	uint32_t attempts;
+	// the test of the last attempt that was one
+	int lastTest;
+} AttemptSession;
+
+void attempts_reset(AttemptSession *session);
+
+// works out the result of a capture for a test, and adds it
+// test is usually what the capture was classified as, MOTION_NONE only counts it as unknown
+// row can be NULL
+void attempts_add(AttemptSession *session, const WaveformData *data, bool cStick, enum MOTION_TYPE test, AttemptRow *row);
+
+float attempts_stdDev(const AttemptTotals *totals);
+
+// the bin a value goes in for a test
+int attempts_bin(enum MOTION_TYPE test, float value);
+
+#endif //GTS_ATTEMPTS_H
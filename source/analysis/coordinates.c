@@ -0,0 +1,131 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "coordinates.h"
+#include "analysis.h"
+
+// refer to coordinates.h for descriptions of these values
+const int STICKMAP_FF_WD_ENUM_LEN = 3;
+
+const int STICKMAP_FF_WD_COORD_SAFE[][2] = { {9375, 3125},
+                                             {9375, 3250} };
+const int STICKMAP_FF_WD_COORD_SAFE_LEN = 2;
+
+const int STICKMAP_FF_WD_COORD_UNSAFE[][2] = { {9500, 3000},
+                                                      {9500, 2875} };
+const int STICKMAP_FF_WD_COORD_UNSAFE_LEN = 2;
+
+const int STICKMAP_SHIELDDROP_ENUM_LEN = 4;
+
+const int STICKMAP_SHIELDDROP_COORD_VANILLA[][2] = { { 7375, 6625 },
+													 { 7375, 6750 },
+													 { 7250, 6875 } };
+const int STICKMAP_SHIELDDROP_COORD_VANILLA_LEN = 3;
+
+const int STICKMAP_SHIELDDROP_COORD_UCF_LOWER[][2] = { { 7000, 7000 },
+													   { 7125, 7000 },
+													   
+													   { 6875, 7125 },
+													   { 7000, 7125 },
+													   
+													   { 6750, 7250 },
+													   { 6875, 7250 },
+													   
+													   { 6500, 7375 },
+													   { 6625, 7375 },
+													   { 6750, 7375 },
+													   
+													   { 6375, 7500 },
+													   { 6500, 7500 },
+													   
+													   { 6250, 7625 },
+													   { 6375, 7625 },
+													   
+													   { 6125, 7785 },
+													   { 6250, 7785 },
+													   { 6000, 7875 },
+													   { 6125, 7875 } };
+const int STICKMAP_SHIELDDROP_COORD_UCF_LOWER_LEN = 17;
+
+const int STICKMAP_SHIELDDROP_COORD_UCF_UPPER[][2] = { { 7875, 6125 },
+                                                       { 7750, 6125 },
+													   
+													   { 7625, 6250 },
+													   { 7750, 6250 },
+													   
+													   { 7500, 6375 },
+													   { 7625, 6375 },
+													   
+													   { 7375, 6500 },
+													   { 7500, 6500 } };
+const int STICKMAP_SHIELDDROP_COORD_UCF_UPPER_LEN = 8;
+
+int isCoordValid(enum STICKMAP_LIST test, WaveformDatapoint coords) {
+	int ret = 0;
+	switch (test) {
+		case FF_WD:
+			// safe coords
+			for (int i = 0; i < STICKMAP_FF_WD_COORD_SAFE_LEN; i++) {
+				if ((coords.ax == STICKMAP_FF_WD_COORD_SAFE[i][0] && coords.ay == STICKMAP_FF_WD_COORD_SAFE[i][1]) ||
+				    (coords.ay == STICKMAP_FF_WD_COORD_SAFE[i][0] && coords.ax == STICKMAP_FF_WD_COORD_SAFE[i][1])) {
+					ret = 1;
+					break;
+				}
+			}
+			// unsafe coords
+			for (int i = 0; i < STICKMAP_FF_WD_COORD_UNSAFE_LEN; i++) {
+				if ((coords.ax == STICKMAP_FF_WD_COORD_UNSAFE[i][0] && coords.ay == STICKMAP_FF_WD_COORD_UNSAFE[i][1]) ||
+				    (coords.ay == STICKMAP_FF_WD_COORD_UNSAFE[i][0] && coords.ax == STICKMAP_FF_WD_COORD_UNSAFE[i][1]) ) {
+					ret = 2;
+					break;
+				}
+			}
+			break;
+		case SHIELDDROP:
+			if (coords.isAYNegative) {
+				// vanilla
+				for (int i = 0; i < STICKMAP_SHIELDDROP_COORD_VANILLA_LEN; i++) {
+					if (coords.ay == STICKMAP_SHIELDDROP_COORD_VANILLA[i][1] ||
+					    (coords.ay * -1) == STICKMAP_SHIELDDROP_COORD_VANILLA[i][1]) {
+						ret = 1;
+						break;
+					}
+				}
+				// ucf lower
+				for (int i = 0; i < STICKMAP_SHIELDDROP_COORD_UCF_LOWER_LEN; i++) {
+					if ((coords.ax == STICKMAP_SHIELDDROP_COORD_UCF_LOWER[i][0] &&
+					     coords.ay == STICKMAP_SHIELDDROP_COORD_UCF_LOWER[i][1]) ||
+					    ((coords.ax * -1) == STICKMAP_SHIELDDROP_COORD_UCF_LOWER[i][0] &&
+					     coords.ay == STICKMAP_SHIELDDROP_COORD_UCF_LOWER[i][1])) {
+						ret = 2;
+						break;
+					}
+				}
+				// ucf v0.84 upper
+				for (int i = 0; i < STICKMAP_SHIELDDROP_COORD_UCF_UPPER_LEN; i++) {
+					if ((coords.ax == STICKMAP_SHIELDDROP_COORD_UCF_UPPER[i][0] &&
+					     coords.ay == STICKMAP_SHIELDDROP_COORD_UCF_UPPER[i][1]) ||
+					    ((coords.ax * -1) == STICKMAP_SHIELDDROP_COORD_UCF_UPPER[i][0] &&
+					     coords.ay == STICKMAP_SHIELDDROP_COORD_UCF_UPPER[i][1])) {
+						ret = 3;
+						break;
+					}
+				}
+			}
+		case (NONE):
+		default:
+			break;
+	}
+	return ret;
+}
+
+void coordinates_buildLookup(StickmapLookup *lookup, enum STICKMAP_LIST stickmap) {
+	lookup->stickmap = stickmap;
+	for (int y = -128; y < 128; y++) {
+		for (int x = -128; x < 128; x++) {
+			WaveformDatapoint raw = { .ax = x, .ay = y };
+			lookup->result[y + 128][x + 128] = isCoordValid(stickmap, convertStickValues(&raw));
+		}
+	}
+}
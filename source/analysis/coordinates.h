@@ -0,0 +1,66 @@
+//
+// Created on 2026/10/18.
+//
+
+// stickmap coordinate tables and classification, the text and colors for them are in stickmap_coordinates.h
+// gtsnotch checks its firefox / wavedash results against isCoordValid
+
+#ifndef GTS_COORDINATES_H
+#define GTS_COORDINATES_H
+
+#include <stdint.h>
+#include "../waveform.h"
+
+enum STICKMAP_LIST { NONE, FF_WD, SHIELDDROP };
+
+
+// Firefox and Wavedash min/max
+
+// enum for the return values of isCoordValid
+enum STICKMAP_FF_WD_ENUM { FF_WD_MISS, FF_WD_SAFE, FF_WD_UNSAFE };
+extern const int STICKMAP_FF_WD_ENUM_LEN;
+
+// coordinate tuples
+// array of tuples is the best way to think of this
+// safe coordinates
+extern const int STICKMAP_FF_WD_COORD_SAFE[][2];
+extern const int STICKMAP_FF_WD_COORD_SAFE_LEN;
+
+// unsafe coordinates
+extern const int STICKMAP_FF_WD_COORD_UNSAFE[][2];
+extern const int STICKMAP_FF_WD_COORD_UNSAFE_LEN;
+
+
+// Shield drop coordinates
+
+enum STICKMAP_SHIELDDROP_ENUM { SHIELDDROP_MISS, SHIELDDROP_VANILLA, SHIELDDROP_UCF_LOWER, SHIELDDROP_UCF_UPPER };
+extern const int STICKMAP_SHIELDDROP_ENUM_LEN;
+
+extern const int STICKMAP_SHIELDDROP_COORD_VANILLA[][2];
+extern const int STICKMAP_SHIELDDROP_COORD_VANILLA_LEN;
+
+extern const int STICKMAP_SHIELDDROP_COORD_UCF_LOWER[][2];
+extern const int STICKMAP_SHIELDDROP_COORD_UCF_LOWER_LEN;
+
+extern const int STICKMAP_SHIELDDROP_COORD_UCF_UPPER[][2];
+extern const int STICKMAP_SHIELDDROP_COORD_UCF_UPPER_LEN;
+
+
+// takes melee coordinates from convertStickValues, returns one of the enums above for the given stickmap
+int isCoordValid(enum STICKMAP_LIST, WaveformDatapoint);
+
+// isCoordValid for every raw stick position at once, so a poll is classified with one read
+// [y][x], with -128 at index 0
+typedef struct StickmapLookup {
+	enum STICKMAP_LIST stickmap;
+	uint8_t result[256][256];
+} StickmapLookup;
+
+// goes through all 65536 positions, so only call this when the stickmap changes
+void coordinates_buildLookup(StickmapLookup *lookup, enum STICKMAP_LIST stickmap);
+
+static inline int coordinates_lookup(const StickmapLookup *lookup, int8_t x, int8_t y) {
+	return lookup->result[y + 128][x + 128];
+}
+
+#endif //GTS_COORDINATES_H
@@ -0,0 +1,219 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "events.h"
+#include <string.h>
+
+// samples are copied out of the capture this many at a time
+#define EVENTS_BLOCK 256
+
+static const char *EVENT_NAMES[EVENT_TYPE_LEN] = { "crosses", "leaves 23", "back in 23", "enters 64", "leaves 64",
+                                                   "peak", "rest" };
+
+typedef struct AxisState {
+	// zone code of the last sample, see zoneCodes
+	uint8_t code;
+	// side of the last excursion out of the deadzone, 0 before the first one
+	int lastSide;
+	// furthest point of the excursion in progress
+	bool out;
+	int peak;
+	uint32_t peakPosition;
+	uint32_t peakTimeUs;
+} AxisState;
+
+static void addEvent(EventIndex *index, uint32_t position, uint32_t timeUs, enum EVENT_TYPE type, enum EVENT_AXIS axis, int value) {
+	if (index->count == EVENTS_MAX) {
+		index->dropped++;
+		return;
+	}
+	// peaks and rests are only known after the events that follow them, so they can land a few places back
+	int i = index->count;
+	while (i > 0 && index->events[i - 1].position > position) {
+		index->events[i] = index->events[i - 1];
+		i--;
+	}
+	index->events[i] = (StickEvent) { position, timeUs, type, axis, value };
+	index->count++;
+}
+
+// 0 in the deadzone, 1 past it, 2 past the dash threshold, plus 4 if it's negative and not in the deadzone
+// no branches, so this vectorizes
+static void zoneCodes(const int8_t *values, uint8_t *codes, int count) {
+	for (int i = 0; i < count; i++) {
+		int v = values[i];
+		int a = v < 0 ? -v : v;
+		int level = (a >= EVENTS_DEADZONE) + (a >= EVENTS_DASH);
+		codes[i] = level | (((v < 0) & (level != 0)) << 2);
+	}
+}
+
+static void endExcursion(EventIndex *index, AxisState *state, enum EVENT_AXIS axis) {
+	if (state->out) {
+		addEvent(index, state->peakPosition, state->peakTimeUs, EVENT_PEAK, axis, state->peak);
+		state->out = false;
+	}
+}
+
+// only does any work where the zone changes, or while the stick is out of the deadzone
+static void axisEvents(EventIndex *index, AxisState *state, enum EVENT_AXIS axis, const int8_t *values,
+                       const uint8_t *codes, const uint32_t *timeUs, uint32_t base, int count) {
+	for (int i = 0; i < count; i++) {
+		uint8_t code = codes[i];
+		int level = code & 3;
+		int side = (code & 4) ? -1 : 1;
+		uint32_t position = base + i;
+		if (code != state->code) {
+			int prevLevel = state->code & 3;
+			int prevSide = (state->code & 4) ? -1 : 1;
+			bool switched = prevLevel != 0 && level != 0 && side != prevSide;
+
+			if (prevLevel == 2 && (level != 2 || switched)) {
+				addEvent(index, position, timeUs[i], EVENT_EXIT_DASH, axis, values[i]);
+			}
+			if (prevLevel != 0 && (level == 0 || switched)) {
+				endExcursion(index, state, axis);
+				if (level == 0) {
+					addEvent(index, position, timeUs[i], EVENT_RETURN_DEADZONE, axis, values[i]);
+				}
+			}
+			if (level != 0 && (prevLevel == 0 || switched)) {
+				if (state->lastSide != 0 && side != state->lastSide) {
+					addEvent(index, position, timeUs[i], EVENT_CROSS, axis, values[i]);
+				}
+				if (prevLevel == 0) {
+					addEvent(index, position, timeUs[i], EVENT_LEAVE_DEADZONE, axis, values[i]);
+				}
+				state->lastSide = side;
+				state->out = true;
+				state->peak = 0;
+			}
+			if (level == 2 && (prevLevel != 2 || switched)) {
+				addEvent(index, position, timeUs[i], EVENT_ENTER_DASH, axis, values[i]);
+			}
+			state->code = code;
+		}
+		if (state->out && values[i] * side > state->peak * side) {
+			state->peak = values[i];
+			state->peakPosition = position;
+			state->peakTimeUs = timeUs[i];
+		}
+	}
+}
+
+void events_build(EventIndex *index, const WaveformData *data, unsigned int start, unsigned int count, bool cStick) {
+	index->count = 0;
+	index->dropped = 0;
+	index->samples = count;
+	if (count == 0) {
+		return;
+	}
+
+	int8_t xs[EVENTS_BLOCK], ys[EVENTS_BLOCK];
+	uint8_t xCodes[EVENTS_BLOCK], yCodes[EVENTS_BLOCK];
+	uint32_t timeUs[EVENTS_BLOCK];
+	AxisState xState = { 0 }, yState = { 0 };
+	uint32_t totalUs = 0;
+
+	// resting, over both axes
+	int anchorX = 0, anchorY = 0;
+	uint32_t restPosition = 0, restTimeUs = 0;
+	bool restAdded = false;
+
+	for (unsigned int base = 0; base < count; base += EVENTS_BLOCK) {
+		int len = (count - base) < EVENTS_BLOCK ? (int) (count - base) : EVENTS_BLOCK;
+		unsigned int ring = (start + base) % WAVEFORM_SAMPLES;
+		for (int i = 0; i < len; i++) {
+			const WaveformDatapoint *point = &data->data[ring];
+			xs[i] = cStick ? point->cx : point->ax;
+			ys[i] = cStick ? point->cy : point->ay;
+			// the first sample's time is from before the buffer starts
+			if (base + i != 0) {
+				totalUs += point->timeDiffUs;
+			}
+			timeUs[i] = totalUs;
+			ring++;
+			if (ring == WAVEFORM_SAMPLES) {
+				ring = 0;
+			}
+		}
+		zoneCodes(xs, xCodes, len);
+		zoneCodes(ys, yCodes, len);
+
+		// the first sample is where things start, not a change
+		if (base == 0) {
+			xState.code = xCodes[0];
+			yState.code = yCodes[0];
+			anchorX = xs[0];
+			anchorY = ys[0];
+		}
+		axisEvents(index, &xState, EVENT_AXIS_X, xs, xCodes, timeUs, base, len);
+		axisEvents(index, &yState, EVENT_AXIS_Y, ys, yCodes, timeUs, base, len);
+
+		for (int i = 0; i < len; i++) {
+			int dx = xs[i] - anchorX, dy = ys[i] - anchorY;
+			if (dx <= EVENTS_REST_STILL && dx >= -EVENTS_REST_STILL && dy <= EVENTS_REST_STILL && dy >= -EVENTS_REST_STILL) {
+				if (!restAdded && timeUs[i] - restTimeUs >= EVENTS_REST_US) {
+					addEvent(index, restPosition, restTimeUs, EVENT_REST, EVENT_AXIS_BOTH, anchorX);
+					restAdded = true;
+				}
+			} else {
+				anchorX = xs[i];
+				anchorY = ys[i];
+				restAdded = false;
+				restPosition = base + i;
+				restTimeUs = timeUs[i];
+			}
+		}
+	}
+	// an excursion still going at the end of the buffer has its peak somewhere in it
+	endExcursion(index, &xState, EVENT_AXIS_X);
+	endExcursion(index, &yState, EVENT_AXIS_Y);
+}
+
+int events_lowerBound(const EventIndex *index, uint32_t position) {
+	int low = 0, high = index->count;
+	while (low < high) {
+		int mid = (low + high) / 2;
+		if (index->events[mid].position < position) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+	return low;
+}
+
+int events_nextFrom(const EventIndex *index, int event, int typeMask) {
+	for (int i = event + 1; i < index->count; i++) {
+		if (typeMask & (1 << index->events[i].type)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+int events_prevFrom(const EventIndex *index, int event, int typeMask) {
+	for (int i = event - 1; i >= 0; i--) {
+		if (typeMask & (1 << index->events[i].type)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+int events_next(const EventIndex *index, uint32_t position, int typeMask) {
+	return events_nextFrom(index, events_lowerBound(index, position + 1) - 1, typeMask);
+}
+
+int events_prev(const EventIndex *index, uint32_t position, int typeMask) {
+	return events_prevFrom(index, events_lowerBound(index, position), typeMask);
+}
+
+const char *events_typeName(enum EVENT_TYPE type) {
+	if (type >= EVENT_TYPE_LEN) {
+		return "?";
+	}
+	return EVENT_NAMES[type];
+}
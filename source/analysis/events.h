@@ -0,0 +1,86 @@
+//
+// Created on 2026/10/18.
+//
+
+// index of the interesting parts of a long capture, so a view can jump between them
+// built once over a buffer that isn't changing (the continuous oscilloscope while it's locked),
+// after that finding the next or previous event is a binary search, nothing scans the samples again
+// the samples are read in blocks, so the index doesn't care how long the buffer is
+
+#ifndef GTS_EVENTS_H
+#define GTS_EVENTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../waveform.h"
+
+#define EVENTS_MAX 2048
+// melee's deadzone and dash threshold
+#define EVENTS_DEADZONE 23
+#define EVENTS_DASH 64
+// both axes within this distance of where the rest started, for this long
+// in time rather than samples, so it doesn't depend on the polling rate the buffer was filled at
+#define EVENTS_REST_STILL 2
+#define EVENTS_REST_US 40000
+
+enum EVENT_TYPE {
+	// from one side of the deadzone to the other
+	EVENT_CROSS,
+	EVENT_LEAVE_DEADZONE,
+	EVENT_RETURN_DEADZONE,
+	EVENT_ENTER_DASH,
+	EVENT_EXIT_DASH,
+	// furthest point between leaving the deadzone and coming back
+	EVENT_PEAK,
+	// start of the stick resting anywhere
+	EVENT_REST,
+	EVENT_TYPE_LEN
+};
+
+// which events a search stops at
+#define EVENTS_MASK_ALL ((1 << EVENT_TYPE_LEN) - 1)
+#define EVENTS_MASK_ZONES ((1 << EVENT_CROSS) | (1 << EVENT_LEAVE_DEADZONE) | (1 << EVENT_RETURN_DEADZONE) | \
+                           (1 << EVENT_ENTER_DASH) | (1 << EVENT_EXIT_DASH))
+#define EVENTS_MASK_PEAKS (1 << EVENT_PEAK)
+#define EVENTS_MASK_RESTS (1 << EVENT_REST)
+
+enum EVENT_AXIS { EVENT_AXIS_X, EVENT_AXIS_Y, EVENT_AXIS_BOTH };
+
+typedef struct StickEvent {
+	// samples from the start of the buffer
+	uint32_t position;
+	// time from the start of the buffer
+	uint32_t timeUs;
+	uint8_t type;
+	uint8_t axis;
+	// axis value at the event, the x value for a rest
+	int16_t value;
+} StickEvent;
+
+typedef struct EventIndex {
+	// sorted by position
+	StickEvent events[EVENTS_MAX];
+	int count;
+	// events that didn't fit
+	uint32_t dropped;
+	uint32_t samples;
+} EventIndex;
+
+// indexes count samples of data, starting at start and wrapping around the end of the array
+// uses the c-stick instead if cStick is true
+void events_build(EventIndex *index, const WaveformData *data, unsigned int start, unsigned int count, bool cStick);
+
+// first event after (or last event before) position that's in typeMask, -1 if there isn't one
+int events_next(const EventIndex *index, uint32_t position, int typeMask);
+int events_prev(const EventIndex *index, uint32_t position, int typeMask);
+
+// same, but starting from an event instead of a position
+int events_nextFrom(const EventIndex *index, int event, int typeMask);
+int events_prevFrom(const EventIndex *index, int event, int typeMask);
+
+// first event at or after position, for walking the events in a range
+int events_lowerBound(const EventIndex *index, uint32_t position);
+
+const char *events_typeName(enum EVENT_TYPE type);
+
+#endif //GTS_EVENTS_H
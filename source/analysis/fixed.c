@@ -0,0 +1,47 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "fixed.h"
+
+static fix16 saturate(int64_t value) {
+	if (value > FIX16_MAX) {
+		return FIX16_MAX;
+	}
+	if (value < -FIX16_MAX) {
+		return -FIX16_MAX;
+	}
+	return (fix16) value;
+}
+
+fix16 fixed_usToMs(uint64_t us) {
+	// anything this long saturates anyway, and it keeps the shift from overflowing
+	if (us >= ((uint64_t) FIX16_MAX / FIX16_ONE + 1) * 1000) {
+		return FIX16_MAX;
+	}
+	return saturate((int64_t) ((us << FIX16_SHIFT) / 1000));
+}
+
+fix16 fixed_percent(int64_t num, int64_t den) {
+	// 100 << 16 is about 2^23, so this is exact for anything up to about 2^40 (a capture's worth of microseconds)
+	return saturate((num * (100 * FIX16_ONE)) / den);
+}
+
+// one result bit per step, from the top, no multiplies or divides
+uint32_t fixed_isqrt(uint32_t value) {
+	uint32_t result = 0;
+	uint32_t bit = 1u << 30;
+	while (bit > value) {
+		bit >>= 2;
+	}
+	while (bit != 0) {
+		if (value >= result + bit) {
+			value -= result + bit;
+			result = (result >> 1) + bit;
+		} else {
+			result >>= 1;
+		}
+		bit >>= 2;
+	}
+	return result;
+}
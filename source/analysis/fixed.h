@@ -0,0 +1,48 @@
+//
+// Created on 2026/10/18.
+//
+
+// fixed point (q16) math for the analyzers, since the console's cpu is slow at floats and divides
+// everything here is integer math, so the console and the host tools get the same results bit for bit
+// results only become floats at the end, for printing and exporting
+// host/fixed.c compares these against the float math they replaced
+
+#ifndef GTS_FIXED_H
+#define GTS_FIXED_H
+
+#include <stdint.h>
+
+// 16.16, whole part in the top half
+typedef int32_t fix16;
+
+#define FIX16_SHIFT 16
+#define FIX16_ONE (1 << FIX16_SHIFT)
+#define FIX16_MAX INT32_MAX
+
+static inline fix16 fixed_fromInt(int32_t value) {
+	return value * FIX16_ONE;
+}
+
+// exact, a q16 value always fits in a float's range, and dividing by a power of 2 doesn't round
+static inline float fixed_toFloat(fix16 value) {
+	return value / (float) FIX16_ONE;
+}
+
+static inline fix16 fixed_clamp(fix16 value, fix16 min, fix16 max) {
+	if (value < min) {
+		return min;
+	}
+	return value > max ? max : value;
+}
+
+// microseconds to milliseconds, saturates at FIX16_MAX (about 32 seconds)
+fix16 fixed_usToMs(uint64_t us);
+
+// num / den * 100, rounded towards zero, saturates instead of overflowing
+// num and den just need to be in the same units, den can't be 0
+fix16 fixed_percent(int64_t num, int64_t den);
+
+// floor of the square root, 32 bits since the console's cpu needs two instructions for most 64 bit operations
+uint32_t fixed_isqrt(uint32_t value);
+
+#endif //GTS_FIXED_H
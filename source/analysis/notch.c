@@ -0,0 +1,197 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "notch.h"
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include "analysis.h"
+#include "coordinates.h"
+
+// octagon corners from DrawOctagonalGate, cardinals are 100 out and diagonals are 74 on both axes
+#define NOTCH_CARDINAL_RADIUS 100.0f
+#define NOTCH_DIAGONAL_RADIUS (74.0f * (float) M_SQRT2)
+
+static float toDegrees(float y, float x) {
+	float angle = atan2f(y, x) * (180.0f / (float) M_PI);
+	return angle < 0 ? angle + 360.0f : angle;
+}
+
+void notch_reset(NotchTracker *tracker) {
+	memset(tracker, 0, sizeof(NotchTracker));
+}
+
+static void addRest(NotchTracker *tracker, int x, int y) {
+	// closest notch, if any are close enough
+	int best = -1;
+	int bestDistSq = (NOTCH_CLUSTER_DIST * NOTCH_CLUSTER_DIST) + 1;
+	for (int i = 0; i < tracker->clusterCount; i++) {
+		NotchCluster *cluster = &tracker->clusters[i];
+		int dx = x - (cluster->sumX / (int32_t) cluster->rests);
+		int dy = y - (cluster->sumY / (int32_t) cluster->rests);
+		int distSq = (dx * dx) + (dy * dy);
+		if (distSq < bestDistSq) {
+			best = i;
+			bestDistSq = distSq;
+		}
+	}
+
+	if (best == -1) {
+		if (tracker->clusterCount < NOTCH_MAX_CLUSTERS) {
+			best = tracker->clusterCount;
+			tracker->clusterCount++;
+		} else {
+			// out of room, a notch that was only rested in once is most likely noise
+			for (int i = 0; i < NOTCH_MAX_CLUSTERS; i++) {
+				if (tracker->clusters[i].rests == 1) {
+					best = i;
+					break;
+				}
+			}
+			if (best == -1) {
+				tracker->droppedRests++;
+				return;
+			}
+		}
+		memset(&tracker->clusters[best], 0, sizeof(NotchCluster));
+	}
+	tracker->clusters[best].sumX += x;
+	tracker->clusters[best].sumY += y;
+	tracker->clusters[best].rests++;
+}
+
+void notch_flush(NotchTracker *tracker) {
+	if (tracker->dwellSamples >= NOTCH_DWELL_SAMPLES) {
+		// round the mean position to the nearest stick value
+		int32_t half = tracker->dwellSamples / 2;
+		int32_t sumX = tracker->dwellSumX, sumY = tracker->dwellSumY;
+		int x = (sumX + (sumX < 0 ? -half : half)) / (int32_t) tracker->dwellSamples;
+		int y = (sumY + (sumY < 0 ? -half : half)) / (int32_t) tracker->dwellSamples;
+		if ((x * x) + (y * y) >= NOTCH_MIN_RADIUS * NOTCH_MIN_RADIUS) {
+			addRest(tracker, x, y);
+		}
+	}
+	tracker->dwellSamples = 0;
+	tracker->dwellSumX = 0;
+	tracker->dwellSumY = 0;
+}
+
+void notch_add(NotchTracker *tracker, int x, int y) {
+	tracker->samples++;
+
+	// gate outline
+	int32_t radiusSq = (x * x) + (y * y);
+	if (radiusSq != 0) {
+		int bin = (int) (toDegrees(y, x) * (NOTCH_GATE_BINS / 360.0f)) % NOTCH_GATE_BINS;
+		if (radiusSq > tracker->gateRadiusSq[bin]) {
+			tracker->gateRadiusSq[bin] = radiusSq;
+			tracker->gateX[bin] = x;
+			tracker->gateY[bin] = y;
+		}
+	}
+
+	// resting
+	if (tracker->dwellSamples != 0 &&
+	    abs(x - tracker->anchorX) <= NOTCH_STILL && abs(y - tracker->anchorY) <= NOTCH_STILL) {
+		tracker->dwellSumX += x;
+		tracker->dwellSumY += y;
+		tracker->dwellSamples++;
+		return;
+	}
+	notch_flush(tracker);
+	tracker->anchorX = x;
+	tracker->anchorY = y;
+	tracker->dwellSumX = x;
+	tracker->dwellSumY = y;
+	tracker->dwellSamples = 1;
+}
+
+int notch_results(const NotchTracker *tracker, NotchResult *results, int maxResults) {
+	int count = 0;
+	for (int i = 0; i < tracker->clusterCount && count < maxResults; i++) {
+		const NotchCluster *cluster = &tracker->clusters[i];
+		if (cluster->rests < NOTCH_MIN_RESTS) {
+			continue;
+		}
+		NotchResult *result = &results[count];
+		result->x = (float) cluster->sumX / cluster->rests;
+		result->y = (float) cluster->sumY / cluster->rests;
+		result->rests = cluster->rests;
+
+		WaveformDatapoint raw = { 0 };
+		raw.ax = (int) lroundf(result->x);
+		raw.ay = (int) lroundf(result->y);
+		WaveformDatapoint melee = convertStickValues(&raw);
+		result->ffwd = isCoordValid(FF_WD, melee);
+		result->meleeX = melee.isAXNegative ? -melee.ax : melee.ax;
+		result->meleeY = melee.isAYNegative ? -melee.ay : melee.ay;
+
+		result->angle = toDegrees(result->meleeY, result->meleeX);
+		result->octagonError = result->angle - (roundf(result->angle / 45.0f) * 45.0f);
+
+		// keep them sorted by angle as they go in
+		for (int j = count; j > 0 && results[j - 1].angle > results[j].angle; j--) {
+			NotchResult tmp = results[j - 1];
+			results[j - 1] = results[j];
+			results[j] = tmp;
+		}
+		count++;
+	}
+	return count;
+}
+
+float notch_idealRadius(float angle) {
+	angle = fmodf(angle, 360.0f);
+	if (angle < 0) {
+		angle += 360.0f;
+	}
+	// the edge of the octagon this direction hits, between corner k and k + 1
+	int k = (int) (angle / 45.0f) % 8;
+	float a1 = k * 45.0f * ((float) M_PI / 180.0f);
+	float a2 = (k + 1) * 45.0f * ((float) M_PI / 180.0f);
+	float r1 = (k % 2 == 0) ? NOTCH_CARDINAL_RADIUS : NOTCH_DIAGONAL_RADIUS;
+	float r2 = (k % 2 == 0) ? NOTCH_DIAGONAL_RADIUS : NOTCH_CARDINAL_RADIUS;
+	float ax = r1 * cosf(a1), ay = r1 * sinf(a1);
+	float ex = (r2 * cosf(a2)) - ax, ey = (r2 * sinf(a2)) - ay;
+	float theta = angle * ((float) M_PI / 180.0f);
+	float dx = cosf(theta), dy = sinf(theta);
+	// where the ray from the center crosses the edge
+	return ((ax * ey) - (ay * ex)) / ((dx * ey) - (dy * ex));
+}
+
+void notch_fitGate(const NotchTracker *tracker, GateFit *fit) {
+	memset(fit, 0, sizeof(GateFit));
+	float errorTotal = 0;
+	const int binsPerVertex = NOTCH_GATE_BINS / NOTCH_GATE_VERTICES;
+	for (int i = 0; i < NOTCH_GATE_BINS; i++) {
+		// the stick never went out to the gate this way
+		if (tracker->gateRadiusSq[i] < NOTCH_MIN_RADIUS * NOTCH_MIN_RADIUS) {
+			continue;
+		}
+		float angle = toDegrees(tracker->gateY[i], tracker->gateX[i]);
+		float radius = sqrtf((float) tracker->gateRadiusSq[i]);
+		float ideal = notch_idealRadius(angle);
+		float error = fabsf(radius - ideal);
+		errorTotal += error;
+		if (error > fit->maxError) {
+			fit->maxError = error;
+		}
+		fit->binsUsed++;
+
+		// the bins within half a corner of each octagon corner
+		int vertex = ((i + (binsPerVertex / 2)) / binsPerVertex) % NOTCH_GATE_VERTICES;
+		GateVertex *curr = &fit->vertices[vertex];
+		if (!curr->found || radius > curr->radius) {
+			curr->found = true;
+			curr->x = tracker->gateX[i];
+			curr->y = tracker->gateY[i];
+			curr->angle = angle;
+			curr->radius = radius;
+			curr->idealRadius = ideal;
+		}
+	}
+	if (fit->binsUsed != 0) {
+		fit->meanError = errorTotal / fit->binsUsed;
+	}
+}
@@ -0,0 +1,111 @@
+//
+// Created on 2026/10/18.
+//
+
+// notch and gate shape detection, fed one stick sample at a time
+// places where the stick rests out near the gate get clustered into notches, and the furthest the stick
+// has gone in each direction gives the shape of the gate, which is compared against the octagon DrawOctagonalGate uses
+// everything is a fixed size, so this can run for as long as samples keep coming in
+// dwell lengths are in samples at the high polling rate (~1400 hz)
+// host/notch.c runs this on synthetic gates and rests
+
+#ifndef GTS_NOTCH_H
+#define GTS_NOTCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// the stick counts as resting while it stays within this distance of where the rest started
+#define NOTCH_STILL 2
+// samples the stick has to rest for, ~30ms
+#define NOTCH_DWELL_SAMPLES 40
+// rests closer to the center than this aren't notches
+#define NOTCH_MIN_RADIUS 60
+// a rest this close to a notch's center is part of that notch
+#define NOTCH_CLUSTER_DIST 4
+#define NOTCH_MAX_CLUSTERS 16
+// a notch needs this many separate rests in it to be reported
+#define NOTCH_MIN_RESTS 2
+
+// directions the gate outline is tracked in, needs to be a multiple of 8
+#define NOTCH_GATE_BINS 64
+#define NOTCH_GATE_VERTICES 8
+
+typedef struct NotchCluster {
+	int32_t sumX;
+	int32_t sumY;
+	uint32_t rests;
+} NotchCluster;
+
+typedef struct NotchTracker {
+	// the rest in progress
+	int anchorX;
+	int anchorY;
+	int32_t dwellSumX;
+	int32_t dwellSumY;
+	uint32_t dwellSamples;
+
+	NotchCluster clusters[NOTCH_MAX_CLUSTERS];
+	int clusterCount;
+	// rests that didn't fit, because every cluster already had more than one rest in it
+	uint32_t droppedRests;
+
+	// furthest point seen in each direction, bin 0 starts at +x and they go counterclockwise
+	int32_t gateRadiusSq[NOTCH_GATE_BINS];
+	int8_t gateX[NOTCH_GATE_BINS];
+	int8_t gateY[NOTCH_GATE_BINS];
+
+	uint64_t samples;
+} NotchTracker;
+
+typedef struct NotchResult {
+	// center of the notch in raw stick values
+	float x;
+	float y;
+	// melee coordinates, signed, in the same units as convertStickValues (0.0125 is 125)
+	int meleeX;
+	int meleeY;
+	// degrees, counterclockwise from +x, from the melee coordinates
+	float angle;
+	// how far the angle is from the nearest multiple of 45, what an ideal octagon notch would be at
+	float octagonError;
+	// enum STICKMAP_FF_WD_ENUM for the firefox/wavedash stickmap
+	int ffwd;
+	uint32_t rests;
+} NotchResult;
+
+typedef struct GateVertex {
+	bool found;
+	int x;
+	int y;
+	float angle;
+	float radius;
+	// radius of the ideal octagon in the same direction
+	float idealRadius;
+} GateVertex;
+
+typedef struct GateFit {
+	// the furthest point near each corner of the octagon, starting at +x and going counterclockwise
+	GateVertex vertices[NOTCH_GATE_VERTICES];
+	// mean and worst difference from the ideal octagon, over every direction the stick has been out to the gate
+	float meanError;
+	float maxError;
+	int binsUsed;
+} GateFit;
+
+void notch_reset(NotchTracker *tracker);
+
+void notch_add(NotchTracker *tracker, int x, int y);
+
+// ends the rest in progress, for when a capture is finished
+void notch_flush(NotchTracker *tracker);
+
+// fills up to maxResults notches, sorted by angle, returns how many there were
+int notch_results(const NotchTracker *tracker, NotchResult *results, int maxResults);
+
+void notch_fitGate(const NotchTracker *tracker, GateFit *fit);
+
+// radius of the octagon DrawOctagonalGate draws, at angle degrees
+float notch_idealRadius(float angle);
+
+#endif //GTS_NOTCH_H
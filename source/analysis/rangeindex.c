@@ -0,0 +1,86 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "rangeindex.h"
+
+// level of the biggest run that fits in len samples
+static int levelFor(unsigned int len) {
+	return 31 - __builtin_clz(len);
+}
+
+void rangeindex_build(RangeIndex *index, const WaveformData *data, bool cStick) {
+	unsigned int samples = data->endPoint;
+	if (samples > WAVEFORM_SAMPLES) {
+		samples = WAVEFORM_SAMPLES;
+	}
+	index->samples = samples;
+	index->timeUs[0] = 0;
+	index->sumX[0] = 0;
+	index->sumY[0] = 0;
+	for (unsigned int i = 0; i < samples; i++) {
+		int x = cStick ? data->data[i].cx : data->data[i].ax;
+		int y = cStick ? data->data[i].cy : data->data[i].ay;
+		// the first sample's time is from before the capture started
+		index->timeUs[i + 1] = index->timeUs[i] + (i != 0 ? data->data[i].timeDiffUs : 0);
+		index->sumX[i + 1] = index->sumX[i] + x;
+		index->sumY[i + 1] = index->sumY[i] + y;
+		index->minX[0][i] = x;
+		index->maxX[0][i] = x;
+		index->minY[0][i] = y;
+		index->maxY[0][i] = y;
+	}
+
+	// each level from two halves of the one below it
+	for (int level = 1; level < RANGE_LEVELS && (1u << level) <= samples; level++) {
+		unsigned int half = 1u << (level - 1);
+		for (unsigned int i = 0; i + (1u << level) <= samples; i++) {
+			const int8_t *minX = index->minX[level - 1], *maxX = index->maxX[level - 1];
+			const int8_t *minY = index->minY[level - 1], *maxY = index->maxY[level - 1];
+			index->minX[level][i] = minX[i] < minX[i + half] ? minX[i] : minX[i + half];
+			index->maxX[level][i] = maxX[i] > maxX[i + half] ? maxX[i] : maxX[i + half];
+			index->minY[level][i] = minY[i] < minY[i + half] ? minY[i] : minY[i + half];
+			index->maxY[level][i] = maxY[i] > maxY[i + half] ? maxY[i] : maxY[i + half];
+		}
+	}
+}
+
+void rangeindex_query(const RangeIndex *index, unsigned int first, unsigned int last, RangeStats *stats) {
+	if (index->samples == 0) {
+		*stats = (RangeStats) { 0 };
+		return;
+	}
+	if (first > last) {
+		unsigned int tmp = first;
+		first = last;
+		last = tmp;
+	}
+	if (last >= index->samples) {
+		last = index->samples - 1;
+	}
+	if (first > last) {
+		first = last;
+	}
+
+	unsigned int len = last - first + 1;
+	stats->timeUs = index->timeUs[last + 1] - index->timeUs[first + 1];
+	stats->meanX = (float) (index->sumX[last + 1] - index->sumX[first]) / len;
+	stats->meanY = (float) (index->sumY[last + 1] - index->sumY[first]) / len;
+
+	// one run from the start, one that ends at the end, they overlap in the middle
+	int level = levelFor(len);
+	unsigned int second = last + 1 - (1u << level);
+	const int8_t *minX = index->minX[level], *maxX = index->maxX[level];
+	const int8_t *minY = index->minY[level], *maxY = index->maxY[level];
+	stats->minX = minX[first] < minX[second] ? minX[first] : minX[second];
+	stats->maxX = maxX[first] > maxX[second] ? maxX[first] : maxX[second];
+	stats->minY = minY[first] < minY[second] ? minY[first] : minY[second];
+	stats->maxY = maxY[first] > maxY[second] ? maxY[first] : maxY[second];
+}
+
+uint64_t rangeindex_timeAt(const RangeIndex *index, unsigned int sample) {
+	if (sample >= index->samples) {
+		sample = index->samples != 0 ? index->samples - 1 : 0;
+	}
+	return index->timeUs[sample + 1];
+}
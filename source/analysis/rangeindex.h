@@ -0,0 +1,53 @@
+//
+// Created on 2026/10/18.
+//
+
+// answers min/max/mean/time questions about any part of a capture in constant time
+// prefix sums give the time and the means, sparse tables give the min and max
+// (each level holds the min/max of a run of 2^level samples, so two overlapping runs cover any range)
+// built once per capture, it's big, so keep one around instead of putting it on the stack
+
+#ifndef GTS_RANGEINDEX_H
+#define GTS_RANGEINDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../waveform.h"
+
+// 2^RANGE_LEVELS has to be at least WAVEFORM_SAMPLES
+#define RANGE_LEVELS 12
+_Static_assert((1 << RANGE_LEVELS) >= WAVEFORM_SAMPLES, "RANGE_LEVELS is too small for WAVEFORM_SAMPLES");
+
+typedef struct RangeIndex {
+	unsigned int samples;
+	// sums of everything before a sample, so there's one more than there are samples
+	uint64_t timeUs[WAVEFORM_SAMPLES + 1];
+	int32_t sumX[WAVEFORM_SAMPLES + 1];
+	int32_t sumY[WAVEFORM_SAMPLES + 1];
+	int8_t minX[RANGE_LEVELS][WAVEFORM_SAMPLES];
+	int8_t maxX[RANGE_LEVELS][WAVEFORM_SAMPLES];
+	int8_t minY[RANGE_LEVELS][WAVEFORM_SAMPLES];
+	int8_t maxY[RANGE_LEVELS][WAVEFORM_SAMPLES];
+} RangeIndex;
+
+typedef struct RangeStats {
+	// time from the first sample to the last
+	uint64_t timeUs;
+	int minX;
+	int maxX;
+	int minY;
+	int maxY;
+	float meanX;
+	float meanY;
+} RangeStats;
+
+// uses the c-stick instead if cStick is true
+void rangeindex_build(RangeIndex *index, const WaveformData *data, bool cStick);
+
+// first and last are both included, and can be given in either order
+void rangeindex_query(const RangeIndex *index, unsigned int first, unsigned int last, RangeStats *stats);
+
+// time from the start of the capture to a sample
+uint64_t rangeindex_timeAt(const RangeIndex *index, unsigned int sample);
+
+#endif //GTS_RANGEINDEX_H
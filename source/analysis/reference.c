@@ -0,0 +1,164 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "reference.h"
+#include <math.h>
+#include <string.h>
+
+static WaveformData reference;
+static bool pinned = false;
+static uint32_t generation = 0;
+
+// both timelines, resampled, and then decimated for the coarse pass
+static int16_t captureSamples[REFERENCE_LEN];
+static int16_t referenceSamples[REFERENCE_LEN];
+static int16_t captureCoarse[REFERENCE_LEN / REFERENCE_DECIMATE];
+static int16_t referenceCoarse[REFERENCE_LEN / REFERENCE_DECIMATE];
+
+void reference_pin(const WaveformData *capture) {
+	memcpy(&reference, capture, sizeof(WaveformData));
+	reference_setPinned(true);
+}
+
+void reference_clear() {
+	reference_setPinned(false);
+}
+
+const WaveformData *reference_get() {
+	return pinned ? &reference : NULL;
+}
+
+WaveformData *reference_buffer() {
+	return &reference;
+}
+
+void reference_setPinned(bool value) {
+	pinned = value;
+	generation++;
+}
+
+uint32_t reference_generation() {
+	return generation;
+}
+
+static int axisValue(const WaveformDatapoint *point, bool cStick, bool yAxis) {
+	if (cStick) {
+		return yAxis ? point->cy : point->cx;
+	}
+	return yAxis ? point->ay : point->ax;
+}
+
+// value at every REFERENCE_SAMPLE_US from the first sample, holding the last value between polls
+static int resample(const WaveformData *data, bool cStick, bool yAxis, int16_t *out) {
+	int count = 0;
+	unsigned int i = 0;
+	uint64_t timeUs = 0;
+	uint64_t targetUs = 0;
+	while (count < REFERENCE_LEN && data->endPoint != 0) {
+		while (i + 1 < data->endPoint && timeUs + data->data[i + 1].timeDiffUs <= targetUs) {
+			timeUs += data->data[i + 1].timeDiffUs;
+			i++;
+		}
+		if (i + 1 >= data->endPoint) {
+			break;
+		}
+		out[count] = axisValue(&data->data[i], cStick, yAxis);
+		count++;
+		targetUs += REFERENCE_SAMPLE_US;
+	}
+	return count;
+}
+
+static int decimate(const int16_t *in, int count, int16_t *out) {
+	int outCount = count / REFERENCE_DECIMATE;
+	for (int i = 0; i < outCount; i++) {
+		int sum = 0;
+		for (int j = 0; j < REFERENCE_DECIMATE; j++) {
+			sum += in[(i * REFERENCE_DECIMATE) + j];
+		}
+		out[i] = sum / REFERENCE_DECIMATE;
+	}
+	return outCount;
+}
+
+// sum of capture[t] * reference[t + lag] wherever both exist
+static int64_t correlate(const int16_t *capture, int captureCount, const int16_t *ref, int refCount, int lag) {
+	int start = lag < 0 ? -lag : 0;
+	int end = captureCount < refCount - lag ? captureCount : refCount - lag;
+	int64_t sum = 0;
+	for (int t = start; t < end; t++) {
+		sum += capture[t] * ref[t + lag];
+	}
+	return sum;
+}
+
+// best lag in [center - range, center + range]
+static int bestLag(const int16_t *capture, int captureCount, const int16_t *ref, int refCount, int center, int range) {
+	int best = center;
+	int64_t bestSum = INT64_MIN;
+	for (int lag = center - range; lag <= center + range; lag++) {
+		int64_t sum = correlate(capture, captureCount, ref, refCount, lag);
+		// ties go to the lag closest to the trigger point
+		if (sum > bestSum || (sum == bestSum && (lag < 0 ? -lag : lag) < (best < 0 ? -best : best))) {
+			best = lag;
+			bestSum = sum;
+		}
+	}
+	return best;
+}
+
+static void metrics(const WaveformData *data, bool cStick, ReferenceMetrics *result) {
+	result->durationUs = 0;
+	for (unsigned int i = 1; i < data->endPoint; i++) {
+		result->durationUs += data->data[i].timeDiffUs;
+	}
+	analysis_stickRange(data, 0, data->endPoint, cStick, &result->range);
+	result->pivot = (PivotResult) { 0 };
+	result->pivotFound = analysis_pivot(data, &result->pivot);
+	analysis_dashback(data, &result->dashback);
+}
+
+bool reference_compare(const WaveformData *capture, bool cStick, ReferenceDiff *diff) {
+	memset(diff, 0, sizeof(ReferenceDiff));
+	if (!pinned) {
+		return false;
+	}
+	metrics(capture, cStick, &diff->capture);
+	metrics(&reference, cStick, &diff->reference);
+
+	// line up the axis the capture moved the most on
+	StickRange *range = &diff->capture.range;
+	diff->yAxis = (range->maxY - range->minY) > (range->maxX - range->minX);
+	int captureCount = resample(capture, cStick, diff->yAxis, captureSamples);
+	int refCount = resample(&reference, cStick, diff->yAxis, referenceSamples);
+	if (captureCount == 0 || refCount == 0) {
+		return true;
+	}
+
+	// coarse around the trigger point, then full resolution around the best coarse lag
+	int maxLag = (REFERENCE_MAX_LAG_MS * 1000) / REFERENCE_SAMPLE_US;
+	int captureCoarseCount = decimate(captureSamples, captureCount, captureCoarse);
+	int refCoarseCount = decimate(referenceSamples, refCount, referenceCoarse);
+	int lag = 0;
+	if (captureCoarseCount != 0 && refCoarseCount != 0) {
+		lag = bestLag(captureCoarse, captureCoarseCount, referenceCoarse, refCoarseCount, 0,
+		              maxLag / REFERENCE_DECIMATE) * REFERENCE_DECIMATE;
+	}
+	lag = bestLag(captureSamples, captureCount, referenceSamples, refCount, lag, REFERENCE_DECIMATE);
+	diff->lagUs = lag * REFERENCE_SAMPLE_US;
+
+	// normalized over the overlap
+	int64_t cross = correlate(captureSamples, captureCount, referenceSamples, refCount, lag);
+	int64_t captureEnergy = 0, refEnergy = 0;
+	int start = lag < 0 ? -lag : 0;
+	int end = captureCount < refCount - lag ? captureCount : refCount - lag;
+	for (int t = start; t < end; t++) {
+		captureEnergy += captureSamples[t] * captureSamples[t];
+		refEnergy += referenceSamples[t + lag] * referenceSamples[t + lag];
+	}
+	if (captureEnergy != 0 && refEnergy != 0) {
+		diff->match = (float) ((double) cross / sqrt((double) captureEnergy * (double) refEnergy));
+	}
+	return true;
+}
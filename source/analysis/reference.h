@@ -0,0 +1,66 @@
+//
+// Created on 2026/10/18.
+//
+
+// a capture pinned as a reference, for comparing a controller before and after a change
+// captures start at their trigger point (when the stick first moved), so they're lined up there first,
+// then cross-correlation over both timelines resampled to REFERENCE_SAMPLE_US finds the best offset around it
+// the correlation runs coarse first (REFERENCE_DECIMATE samples averaged together) then only refines around the best
+// coarse offset, so it's a fraction of the work of checking every offset at full resolution
+
+#ifndef GTS_REFERENCE_H
+#define GTS_REFERENCE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../waveform.h"
+#include "analysis.h"
+
+#define REFERENCE_SAMPLE_US 1000
+// long enough for a full capture at the high polling rate
+#define REFERENCE_LEN 4096
+#define REFERENCE_DECIMATE 4
+// furthest the alignment will move the reference from the trigger point
+#define REFERENCE_MAX_LAG_MS 250
+
+// the results that get compared
+typedef struct ReferenceMetrics {
+	uint64_t durationUs;
+	StickRange range;
+	bool pivotFound;
+	PivotResult pivot;
+	DashbackResult dashback;
+} ReferenceMetrics;
+
+typedef struct ReferenceDiff {
+	// how much later the same motion happens in the reference, negative if it's earlier
+	// the reference at (time + lagUs) lines up with the capture at time
+	int32_t lagUs;
+	// correlation at that offset, 1 is the same shape
+	float match;
+	// the axis that was aligned, the one the capture moved the most on
+	bool yAxis;
+	ReferenceMetrics capture;
+	ReferenceMetrics reference;
+} ReferenceDiff;
+
+// copies a capture in as the reference
+void reference_pin(const WaveformData *capture);
+
+void reference_clear();
+
+// the pinned capture, NULL if there isn't one
+const WaveformData *reference_get();
+
+// storage to read a capture straight into, call reference_setPinned once it's filled
+WaveformData *reference_buffer();
+void reference_setPinned(bool pinned);
+
+// changes every time the reference does, so anything worked out from it can tell when it's stale
+uint32_t reference_generation();
+
+// aligns the reference to a capture and works out both sets of results
+// uses the c-stick instead if cStick is true, returns false if there's no reference
+bool reference_compare(const WaveformData *capture, bool cStick, ReferenceDiff *diff);
+
+#endif //GTS_REFERENCE_H
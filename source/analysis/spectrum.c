@@ -0,0 +1,244 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "spectrum.h"
+#include <math.h>
+#include <string.h>
+#include <stdlib.h>
+#include "analysis.h"
+
+// q15 twiddles and hann window, filled the first time they're needed
+static int16_t cosTable[SPECTRUM_LEN / 2];
+static int16_t sinTable[SPECTRUM_LEN / 2];
+static int16_t hannTable[SPECTRUM_LEN];
+static bool tablesReady = false;
+
+// resampled capture, and the fft's working space
+static int16_t samples[SPECTRUM_LEN];
+static int16_t fftRe[SPECTRUM_LEN];
+static int16_t fftIm[SPECTRUM_LEN];
+
+// stick values go in with this many fractional bits, +/-255 away from rest still fits in q15
+#define SPECTRUM_VALUE_SHIFT 7
+
+static void buildTables() {
+	for (int i = 0; i < SPECTRUM_LEN / 2; i++) {
+		float angle = (2.0f * (float) M_PI * i) / SPECTRUM_LEN;
+		cosTable[i] = (int16_t) lroundf(cosf(angle) * 32767.0f);
+		sinTable[i] = (int16_t) lroundf(sinf(angle) * 32767.0f);
+	}
+	for (int i = 0; i < SPECTRUM_LEN; i++) {
+		hannTable[i] = (int16_t) lroundf(0.5f * (1.0f - cosf((2.0f * (float) M_PI * i) / (SPECTRUM_LEN - 1))) * 32767.0f);
+	}
+	tablesReady = true;
+}
+
+void spectrum_fft(int16_t *re, int16_t *im) {
+	if (!tablesReady) {
+		buildTables();
+	}
+
+	// bit reversed order
+	for (unsigned int i = 1, j = 0; i < SPECTRUM_LEN; i++) {
+		unsigned int bit = SPECTRUM_LEN >> 1;
+		for (; j & bit; bit >>= 1) {
+			j ^= bit;
+		}
+		j ^= bit;
+		if (i < j) {
+			int16_t tmp = re[i];
+			re[i] = re[j];
+			re[j] = tmp;
+			tmp = im[i];
+			im[i] = im[j];
+			im[j] = tmp;
+		}
+	}
+
+	// every stage halves its output, so nothing overflows as long as the input fits in q15
+	for (int len = 2; len <= SPECTRUM_LEN; len <<= 1) {
+		int half = len >> 1;
+		int step = SPECTRUM_LEN / len;
+		for (int i = 0; i < SPECTRUM_LEN; i += len) {
+			for (int j = 0; j < half; j++) {
+				int32_t wr = cosTable[j * step];
+				int32_t wi = -sinTable[j * step];
+				int a = i + j;
+				int b = a + half;
+				int32_t tr = ((re[b] * wr) - (im[b] * wi)) >> 15;
+				int32_t ti = ((re[b] * wi) + (im[b] * wr)) >> 15;
+				int32_t ur = re[a];
+				int32_t ui = im[a];
+				re[a] = (ur + tr) >> 1;
+				im[a] = (ui + ti) >> 1;
+				re[b] = (ur - tr) >> 1;
+				im[b] = (ui - ti) >> 1;
+			}
+		}
+	}
+}
+
+float spectrum_binHz(int bin) {
+	return (bin * 1000000.0f) / (SPECTRUM_SAMPLE_US * (float) SPECTRUM_LEN);
+}
+
+static int axisValue(const WaveformDatapoint *point, bool cStick, bool yAxis) {
+	if (cStick) {
+		return yAxis ? point->cy : point->cx;
+	}
+	return yAxis ? point->ay : point->ax;
+}
+
+// one peak per half cycle, fit ln(peak) against time, the slope gives the time constant
+static float decayTime(unsigned int count) {
+	float sumT = 0, sumL = 0, sumTT = 0, sumTL = 0;
+	int peaks = 0;
+	int peak = 0;
+	unsigned int peakIndex = 0;
+	for (unsigned int i = 0; i <= count; i++) {
+		bool crossed = i == count || (i > 0 && ((samples[i] < 0) != (samples[i - 1] < 0)));
+		if (crossed && peak != 0) {
+			if (peak < (SPECTRUM_MIN_PEAK << SPECTRUM_VALUE_SHIFT)) {
+				break;
+			}
+			float t = (peakIndex * SPECTRUM_SAMPLE_US) / 1000.0f;
+			float l = logf((float) peak);
+			sumT += t;
+			sumL += l;
+			sumTT += t * t;
+			sumTL += t * l;
+			peaks++;
+			peak = 0;
+		}
+		if (i < count && abs(samples[i]) > peak) {
+			peak = abs(samples[i]);
+			peakIndex = i;
+		}
+	}
+	if (peaks < 3) {
+		return 0;
+	}
+	float slope = ((peaks * sumTL) - (sumT * sumL)) / ((peaks * sumTT) - (sumT * sumT));
+	return slope < 0 ? -1.0f / slope : 0;
+}
+
+static int compareFloats(const void *a, const void *b) {
+	float fa = *(const float *) a, fb = *(const float *) b;
+	return (fa > fb) - (fa < fb);
+}
+
+void spectrum_analyze(const WaveformData *data, bool cStick, SpectrumResult *result) {
+	memset(result, 0, sizeof(SpectrumResult));
+	unsigned int end = data->endPoint;
+	if (end < 16) {
+		return;
+	}
+	if (!tablesReady) {
+		buildTables();
+	}
+
+	// the axis that moved the most
+	StickRange range;
+	analysis_stickRange(data, 0, end, cStick, &range);
+	bool yAxis = (range.maxY - range.minY) > (range.maxX - range.minX);
+	result->yAxis = yAxis;
+
+	// the stick has settled by the end of a capture, so the last tenth is the resting position
+	int restSum = 0;
+	unsigned int restStart = end - (end / 10);
+	for (unsigned int i = restStart; i < end; i++) {
+		restSum += axisValue(&data->data[i], cStick, yAxis);
+	}
+	int rest = restSum / (int) (end - restStart);
+
+	// released from the furthest point, ringing starts the first time it crosses the rest position after that
+	unsigned int furthest = 0;
+	for (unsigned int i = 1; i < end; i++) {
+		if (abs(axisValue(&data->data[i], cStick, yAxis) - rest) > abs(axisValue(&data->data[furthest], cStick, yAxis) - rest)) {
+			furthest = i;
+		}
+	}
+	int side = axisValue(&data->data[furthest], cStick, yAxis) - rest;
+	unsigned int start = furthest;
+	while (start < end && (axisValue(&data->data[start], cStick, yAxis) - rest) * side > 0) {
+		start++;
+	}
+	if (side == 0 || start + 2 >= end) {
+		return;
+	}
+	result->found = true;
+	result->start = start;
+
+	// linear interpolation at SPECTRUM_SAMPLE_US steps
+	unsigned int count = 0;
+	unsigned int i = start;
+	uint64_t timeUs = 0;
+	uint64_t targetUs = 0;
+	while (count < SPECTRUM_LEN) {
+		while (i + 1 < end && timeUs + data->data[i + 1].timeDiffUs <= targetUs) {
+			timeUs += data->data[i + 1].timeDiffUs;
+			i++;
+		}
+		if (i + 1 >= end) {
+			break;
+		}
+		int32_t v0 = (axisValue(&data->data[i], cStick, yAxis) - rest) << SPECTRUM_VALUE_SHIFT;
+		int32_t v1 = (axisValue(&data->data[i + 1], cStick, yAxis) - rest) << SPECTRUM_VALUE_SHIFT;
+		uint32_t span = data->data[i + 1].timeDiffUs;
+		int32_t value = v0;
+		if (span != 0) {
+			value += (int32_t) (((int64_t) (v1 - v0) * (int64_t) (targetUs - timeUs)) / span);
+		}
+		samples[count] = value;
+		count++;
+		targetUs += SPECTRUM_SAMPLE_US;
+	}
+	result->samples = count;
+	result->decayMs = decayTime(count);
+
+	// the ringing is strongest right at the start, so only the falling half of the window is used
+	// zero pad past the samples there are
+	for (unsigned int k = 0; k < SPECTRUM_LEN; k++) {
+		if (k < count) {
+			int16_t window = hannTable[(SPECTRUM_LEN / 2) + ((k * ((SPECTRUM_LEN / 2) - 1)) / count)];
+			fftRe[k] = (samples[k] * window) >> 15;
+		} else {
+			fftRe[k] = 0;
+		}
+		fftIm[k] = 0;
+	}
+	spectrum_fft(fftRe, fftIm);
+
+	// power, then db against the strongest bin above SPECTRUM_MIN_HZ
+	uint32_t power[SPECTRUM_BINS];
+	int minBin = (int) ceilf(SPECTRUM_MIN_HZ / spectrum_binHz(1));
+	int peakBin = minBin;
+	for (int k = 0; k < SPECTRUM_BINS; k++) {
+		power[k] = (uint32_t) ((fftRe[k] * fftRe[k]) + (fftIm[k] * fftIm[k]));
+		if (k > minBin && power[k] > power[peakBin]) {
+			peakBin = k;
+		}
+	}
+	float peakPower = power[peakBin] != 0 ? (float) power[peakBin] : 1.0f;
+	for (int k = 0; k < SPECTRUM_BINS; k++) {
+		// anything at or below the last bit is -100
+		result->binDb[k] = power[k] != 0 ? 10.0f * log10f(power[k] / peakPower) : -100.0f;
+	}
+
+	// fit a parabola through the peak and its neighbors for a frequency between bins
+	float offset = 0;
+	if (peakBin > minBin && peakBin < SPECTRUM_BINS - 1) {
+		float a = result->binDb[peakBin - 1], b = result->binDb[peakBin], c = result->binDb[peakBin + 1];
+		float denom = a - (2 * b) + c;
+		if (denom != 0) {
+			offset = 0.5f * (a - c) / denom;
+		}
+	}
+	result->peakHz = spectrum_binHz(peakBin) + (offset * spectrum_binHz(1));
+
+	float sorted[SPECTRUM_BINS - 1];
+	memcpy(sorted, &result->binDb[1], sizeof(sorted));
+	qsort(sorted, SPECTRUM_BINS - 1, sizeof(float), compareFloats);
+	result->noiseFloorDb = sorted[(SPECTRUM_BINS - 1) / 2];
+}
@@ -0,0 +1,56 @@
+//
+// Created on 2026/10/18.
+//
+
+// spectrum of the ringing after a snapback, to see how fast and how long the stick oscillates
+// the capture's polls aren't evenly spaced, so the part after the release is resampled to SPECTRUM_SAMPLE_US first,
+// then goes through a fixed point (q15) radix-2 fft, since the console's cpu is slow at floats in a loop
+// the working buffers are static, so only one thread should use this at a time
+// gtsspectrum checks the fft against a double precision one
+
+#ifndef GTS_SPECTRUM_H
+#define GTS_SPECTRUM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "../waveform.h"
+
+// fft size, 512 samples at 1 khz covers half a second at ~2 hz per bin
+#define SPECTRUM_LOG2_LEN 9
+#define SPECTRUM_LEN (1 << SPECTRUM_LOG2_LEN)
+#define SPECTRUM_BINS (SPECTRUM_LEN / 2)
+#define SPECTRUM_SAMPLE_US 1000
+// peaks smaller than this don't count towards the decay, they're mostly noise
+#define SPECTRUM_MIN_PEAK 2
+// anything slower is the stick settling, not ringing
+#define SPECTRUM_MIN_HZ 5.0f
+
+typedef struct SpectrumResult {
+	// false if there's no release in the capture
+	bool found;
+	// which axis was used, the one that moved the most
+	bool yAxis;
+	// sample the ringing starts at, the first time the stick crosses its resting position after the release
+	unsigned int start;
+	// resampled samples that went into the fft, the rest is zero padding
+	unsigned int samples;
+	// strongest frequency above SPECTRUM_MIN_HZ
+	float peakHz;
+	// time for the ringing to fall to 1/e of where it started, 0 if there weren't enough peaks to tell
+	float decayMs;
+	// median power of every bin, relative to the peak
+	float noiseFloorDb;
+	// power of each bin in db relative to the peak, 0 is the peak
+	float binDb[SPECTRUM_BINS];
+} SpectrumResult;
+
+// in place fft of SPECTRUM_LEN q15 values, the output is scaled down by SPECTRUM_LEN so it can't overflow
+void spectrum_fft(int16_t *re, int16_t *im);
+
+// frequency of a bin
+float spectrum_binHz(int bin);
+
+// runs on the analog stick, or the c-stick if cStick is true
+void spectrum_analyze(const WaveformData *data, bool cStick, SpectrumResult *result);
+
+#endif //GTS_SPECTRUM_H
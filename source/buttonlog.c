@@ -0,0 +1,138 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "buttonlog.h"
+#include <string.h>
+
+void buttonLog_reset(ButtonLog *log, uint16_t held) {
+	log->writeCount = 0;
+	log->prevHeld = held;
+}
+
+void buttonLog_record(ButtonLog *log, uint16_t held, uint32_t timeUs) {
+	uint16_t changed = held ^ log->prevHeld;
+	if (changed == 0) {
+		return;
+	}
+	// events from the same poll share a timestamp, and are written in button order
+	for (uint8_t i = 0; i < BUTTONLOG_BUTTONS; i++) {
+		if (changed & (1 << i)) {
+			log->events[log->writeCount & (BUTTONLOG_LEN - 1)] = buttonLog_encode(i, (held >> i) & 1, timeUs);
+			log->writeCount++;
+		}
+	}
+	log->prevHeld = held;
+}
+
+uint32_t buttonLog_count(const ButtonLog *log) {
+	uint32_t count = log->writeCount;
+	if (count > BUTTONLOG_LEN) {
+		return BUTTONLOG_LEN;
+	}
+	return count;
+}
+
+ButtonEvent buttonLog_get(const ButtonLog *log, uint32_t index) {
+	uint32_t count = log->writeCount;
+	uint32_t start = (count > BUTTONLOG_LEN) ? count - BUTTONLOG_LEN : 0;
+	return log->events[(start + index) & (BUTTONLOG_LEN - 1)];
+}
+
+void buttonLog_analyze(const ButtonLog *log, uint32_t bounceWindowUs, ButtonStats stats[]) {
+	// per button state while walking the log
+	bool isPressed[BUTTONLOG_BUTTONS] = { false };
+	bool pendingRelease[BUTTONLOG_BUTTONS] = { false };
+	ButtonEvent pressStart[BUTTONLOG_BUTTONS] = { 0 };
+	ButtonEvent lastRelease[BUTTONLOG_BUTTONS] = { 0 };
+
+	memset(stats, 0, sizeof(ButtonStats) * BUTTONLOG_BUTTONS);
+	for (int i = 0; i < BUTTONLOG_BUTTONS; i++) {
+		stats[i].minPressUs = UINT32_MAX;
+	}
+
+	uint32_t count = buttonLog_count(log);
+	for (uint32_t i = 0; i < count; i++) {
+		ButtonEvent event = buttonLog_get(log, i);
+		uint8_t button = buttonLog_button(event);
+		ButtonStats *curr = &stats[button];
+
+		if (buttonLog_isPress(event)) {
+			if (isPressed[button]) {
+				continue;
+			}
+			isPressed[button] = true;
+			if (pendingRelease[button]) {
+				// released and pressed again too quickly, treat it as one long press
+				if (buttonLog_timeDiff(lastRelease[button], event) < bounceWindowUs) {
+					curr->bounces++;
+					pendingRelease[button] = false;
+					continue;
+				}
+				// previous press was real, finish it up
+				uint32_t duration = buttonLog_timeDiff(pressStart[button], lastRelease[button]);
+				curr->completedPresses++;
+				curr->totalPressUs += duration;
+				if (duration < curr->minPressUs) {
+					curr->minPressUs = duration;
+				}
+				if (duration > curr->maxPressUs) {
+					curr->maxPressUs = duration;
+				}
+				pendingRelease[button] = false;
+			}
+			curr->presses++;
+			pressStart[button] = event;
+		} else {
+			// a release with no press means the press was already overwritten in the buffer
+			if (!isPressed[button]) {
+				continue;
+			}
+			isPressed[button] = false;
+			pendingRelease[button] = true;
+			lastRelease[button] = event;
+		}
+	}
+
+	// any release still waiting to see if it bounces is done now
+	for (int i = 0; i < BUTTONLOG_BUTTONS; i++) {
+		if (pendingRelease[i]) {
+			uint32_t duration = buttonLog_timeDiff(pressStart[i], lastRelease[i]);
+			stats[i].completedPresses++;
+			stats[i].totalPressUs += duration;
+			if (duration < stats[i].minPressUs) {
+				stats[i].minPressUs = duration;
+			}
+			if (duration > stats[i].maxPressUs) {
+				stats[i].maxPressUs = duration;
+			}
+		}
+		if (stats[i].completedPresses == 0) {
+			stats[i].minPressUs = 0;
+		}
+	}
+}
+
+bool buttonLog_lastInterPress(const ButtonLog *log, uint8_t *first, uint8_t *second, uint32_t *timeUs) {
+	uint32_t count = buttonLog_count(log);
+	bool foundSecond = false;
+	ButtonEvent secondEvent = 0;
+
+	// walk backwards from the newest event
+	for (uint32_t i = count; i > 0; i--) {
+		ButtonEvent event = buttonLog_get(log, i - 1);
+		if (!buttonLog_isPress(event)) {
+			continue;
+		}
+		if (!foundSecond) {
+			foundSecond = true;
+			secondEvent = event;
+		} else if (buttonLog_button(event) != buttonLog_button(secondEvent)) {
+			*first = buttonLog_button(event);
+			*second = buttonLog_button(secondEvent);
+			*timeUs = buttonLog_timeDiff(event, secondEvent);
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,95 @@
+//
+// Created on 2026/10/18.
+//
+
+// log of button press/release edges, recorded from the sampling callback
+// host/buttonlog.c checks this on scripted presses
+
+#ifndef GTS_BUTTONLOG_H
+#define GTS_BUTTONLOG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// number of events kept before the oldest ones get overwritten, must be a power of two
+#define BUTTONLOG_LEN 1024
+
+// button ids are the bit index of the button in the PAD_BUTTON_* masks
+// (0 -> dpad left, 8 -> A, 12 -> start), so 16 is enough for all of them
+#define BUTTONLOG_BUTTONS 16
+
+// default window where a release followed by a press of the same button counts as switch bounce
+#define BUTTONLOG_BOUNCE_WINDOW_US 5000
+
+// events are packed into 32 bits:
+// bits 0-3 -> button id
+// bit 4 -> edge, 1 for press, 0 for release
+// bits 5-31 -> callback timestamp in microseconds, this wraps every ~134 seconds
+typedef uint32_t ButtonEvent;
+
+#define BUTTONLOG_TIME_BITS 27
+#define BUTTONLOG_TIME_MASK ((1u << BUTTONLOG_TIME_BITS) - 1)
+
+static inline ButtonEvent buttonLog_encode(uint8_t button, bool press, uint32_t timeUs) {
+	return ((timeUs & BUTTONLOG_TIME_MASK) << 5) | ((press ? 1u : 0u) << 4) | (button & 0xF);
+}
+
+static inline uint8_t buttonLog_button(ButtonEvent event) {
+	return event & 0xF;
+}
+
+static inline bool buttonLog_isPress(ButtonEvent event) {
+	return (event >> 4) & 1;
+}
+
+static inline uint32_t buttonLog_time(ButtonEvent event) {
+	return event >> 5;
+}
+
+// microseconds from one event to a later one, handles the timestamp wrapping
+static inline uint32_t buttonLog_timeDiff(ButtonEvent from, ButtonEvent to) {
+	return (buttonLog_time(to) - buttonLog_time(from)) & BUTTONLOG_TIME_MASK;
+}
+
+typedef struct ButtonLog {
+	ButtonEvent events[BUTTONLOG_LEN];
+	// total number of events ever written, the next write goes to writeCount % BUTTONLOG_LEN
+	volatile uint32_t writeCount;
+	// held state from the last call to buttonLog_record
+	uint16_t prevHeld;
+} ButtonLog;
+
+// results for a single button, from buttonLog_analyze
+typedef struct ButtonStats {
+	// presses after bounces are filtered out
+	uint32_t presses;
+	// release -> press transitions inside the bounce window
+	uint32_t bounces;
+	// durations of completed presses, from the first press edge to the final release edge
+	uint32_t completedPresses;
+	uint32_t minPressUs;
+	uint32_t maxPressUs;
+	uint64_t totalPressUs;
+} ButtonStats;
+
+void buttonLog_reset(ButtonLog *log, uint16_t held);
+
+// compare held to the previous call, and log an event for every button that changed
+// meant to be called from the sampling callback, so this only touches the log itself
+void buttonLog_record(ButtonLog *log, uint16_t held, uint32_t timeUs);
+
+// number of events that can still be read back
+uint32_t buttonLog_count(const ButtonLog *log);
+
+// get an event, 0 is the oldest event still in the buffer
+ButtonEvent buttonLog_get(const ButtonLog *log, uint32_t index);
+
+// fill stats (BUTTONLOG_BUTTONS entries) for every button in the log
+void buttonLog_analyze(const ButtonLog *log, uint32_t bounceWindowUs, ButtonStats stats[]);
+
+// find the most recent press, and the press of a different button that came right before it
+// useful for things like jump -> airdodge timing
+// returns false if there aren't two presses to compare
+bool buttonLog_lastInterPress(const ButtonLog *log, uint8_t *first, uint8_t *second, uint32_t *timeUs);
+
+#endif //GTS_BUTTONLOG_H
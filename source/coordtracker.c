@@ -0,0 +1,74 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "coordtracker.h"
+#include <string.h>
+#include <ogc/irq.h>
+#include "polling.h"
+#include "input.h"
+
+static StickmapLookup lookup;
+static HitMap map;
+static CoordTrackerStats stats;
+
+static bool running = false;
+// the callback leaves the counts alone while the lookup is being rebuilt
+static volatile bool lookupReady = false;
+
+static sampling_callback cb;
+static void coordTrackerCallback() {
+	PAD_ScanPads();
+
+	// queue button changes for the menu code
+	input_update();
+
+	if (!lookupReady) {
+		return;
+	}
+	s8 x = PAD_StickX(0);
+	s8 y = PAD_StickY(0);
+	stats.results[coordinates_lookup(&lookup, x, y)]++;
+	stats.polls++;
+	hitmap_add(&map, x, y);
+}
+
+void coordTracker_setStickmap(enum STICKMAP_LIST stickmap) {
+	lookupReady = false;
+	coordinates_buildLookup(&lookup, stickmap);
+	memset(&stats, 0, sizeof(CoordTrackerStats));
+	hitmap_clear(&map);
+	lookupReady = true;
+}
+
+void coordTracker_start(enum STICKMAP_LIST stickmap) {
+	coordTracker_setStickmap(stickmap);
+	setSamplingRateHigh();
+	cb = PAD_SetSamplingCallback(coordTrackerCallback);
+	running = true;
+}
+
+void coordTracker_stop() {
+	if (!running) {
+		return;
+	}
+	setSamplingRateNormal();
+	PAD_SetSamplingCallback(cb);
+	lookupReady = false;
+	running = false;
+}
+
+bool coordTracker_isRunning() {
+	return running;
+}
+
+void coordTracker_stats(CoordTrackerStats *out) {
+	// the counts are 64 bits, which takes two loads here, so the callback can't run partway through the copy
+	u32 level = IRQ_Disable();
+	*out = stats;
+	IRQ_Restore(level);
+}
+
+const HitMap *coordTracker_map() {
+	return &map;
+}
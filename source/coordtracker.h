@@ -0,0 +1,38 @@
+//
+// Created on 2026/10/18.
+//
+
+// stickmap hit tracking for the coordinate viewer
+// every poll at the high polling rate is classified against the stickmap from the sampling callback,
+// with a lookup table built for the stickmap, so it's one read however many coordinates the stickmap has
+// the raw positions also go into a hit map, for a heat overlay of where the stick has been
+
+#ifndef GTS_COORDTRACKER_H
+#define GTS_COORDTRACKER_H
+
+#include <gccore.h>
+#include "hitmap.h"
+#include "analysis/coordinates.h"
+
+// one more than the most results a stickmap has
+#define COORDTRACKER_RESULTS 4
+
+typedef struct CoordTrackerStats {
+	u64 polls;
+	u64 results[COORDTRACKER_RESULTS];
+} CoordTrackerStats;
+
+// starts polling at the high rate, and clears everything
+// the callback takes over input_update while this is running
+void coordTracker_start(enum STICKMAP_LIST stickmap);
+void coordTracker_stop();
+bool coordTracker_isRunning();
+
+// rebuilds the lookup and clears the counts
+void coordTracker_setStickmap(enum STICKMAP_LIST stickmap);
+
+// copies the counts as of one poll
+void coordTracker_stats(CoordTrackerStats *stats);
+const HitMap *coordTracker_map();
+
+#endif //GTS_COORDTRACKER_H
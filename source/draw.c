@@ -4,11 +4,63 @@
 
 #include "draw.h"
 #include "images/stickmaps.h"
+#include "profiler.h"
 
-static bool do2xHorizontalDraw = false;
+// the primitives that draw differently depending on the scan mode
+// interlaced modes write both pixels of a word at once, progressive blends into the half the pixel is in
+// each one is written once below with the mode as a constant, and built for both modes, so nothing checks the mode
+// per pixel. setInterlaced picks which set the public functions go through, once the scan mode is known
+typedef struct DrawPrimitives {
+	void (*dot)(int x, int y, int color, void *xfb);
+	void (*vLine)(int x, int y1, int y2, int color, void *xfb);
+	void (*filledBox)(int x1, int y1, int x2, int y2, int color, void *xfb);
+	void (*line)(int x1, int y1, int x2, int y2, int color, void *xfb);
+	void (*circle)(int cx, int cy, int r, int color, void *xfb);
+} DrawPrimitives;
+
+static const DrawPrimitives PRIMITIVES_INTERLACED;
+static const DrawPrimitives PRIMITIVES_PROGRESSIVE;
+static const DrawPrimitives *primitives = &PRIMITIVES_PROGRESSIVE;
 
 void setInterlaced(bool interlaced) {
-	do2xHorizontalDraw = interlaced;
+	primitives = interlaced ? &PRIMITIVES_INTERLACED : &PRIMITIVES_PROGRESSIVE;
+}
+
+// blends a single pixel into its word, keeping the other pixel's luminance
+static inline void dotAccurate(int x, int y, int color, void *xfb) {
+	uint32_t *tmpfb = xfb;
+	int index = (x >> 1) + (640 * y) / 2;
+	uint32_t data = tmpfb[index];
+	
+	if (x % 2 == 1) {
+		if (data >> 24 == 0) {
+			// no data in left pixel, leave it as-is
+			tmpfb[index] = color & 0x00FFFFFF;
+		} else {
+			// preserve the left pixel luminance
+			uint32_t leftLuminance = data & 0xFF000000;
+			uint32_t rightLuminance = color & 0x0000FF00;
+			uint32_t cb, cr;
+			// mix cb and cr
+			cb = ( ((data & 0x00FF0000) >> 16) + ((color & 0x00FF0000) >> 16) ) / 2;
+			cr = ( (data & 0x000000FF) + (color & 0x000000FF) ) / 2;
+			tmpfb[index] = leftLuminance | (cb << 16) | rightLuminance | cr;
+		}
+	} else {
+		if ((data & 0xFFFF00FF) >> 8 == 0) {
+			// no data in right pixel, leave it as-is
+			tmpfb[index] = color & 0xFFFF00FF;
+		} else {
+			// preserve the right pixel luminance
+			uint32_t leftLuminance = color & 0xFF000000;
+			uint32_t rightLuminance = data & 0x0000FF00;
+			uint32_t cb, cr;
+			// mix cb and cr
+			cb = ( ((data & 0x00FF0000) >> 16) + ((color & 0x00FF0000) >> 16) ) / 2;
+			cr = ( (data & 0x000000FF) + (color & 0x000000FF) ) / 2;
+			tmpfb[index] = leftLuminance | (cb << 16) | rightLuminance | cr;
+		}
+	}
 }
 
 // most of this is taken from
@@ -16,6 +68,7 @@ void setInterlaced(bool interlaced) {
 // TODO: this is easily the most costly function in here. single main loop goes from 4ms to 10 ms from calling this,
 // TODO: see if this can be improved
 void drawImage(void *currXfb, const unsigned char image[], const unsigned char colorIndex[8], u16 offsetX, u16 offsetY) {
+	PROFILE_SCOPE(PROFILE_IMAGE);
 	// get information on the image to be drawn
 	u32 width = image[0] << 8 | image[1];
 	u32 height = image[2] << 8 | image[3];
@@ -42,7 +95,7 @@ void drawImage(void *currXfb, const unsigned char image[], const unsigned char c
 		for (int column = offsetX; column < imageEndpointX; column++) {
 			// is there a pixel to actually draw? (0-4 is transparency)
 			if (color >= 5) {
-				DrawDotAccurate(column, row, CUSTOM_COLORS[color - 5], currXfb);
+				dotAccurate(column, row, CUSTOM_COLORS[color - 5], currXfb);
 			}
 			
 			runIndex++;
@@ -56,54 +109,59 @@ void drawImage(void *currXfb, const unsigned char image[], const unsigned char c
 	}
 }
 
-// taken from github.com/phobgcc/phobconfigtool
-// should probably replace this with something gl based at some point
-/*
-* takes in values to draw a horizontal line of a given color
-*/
-void DrawHLine (int x1, int x2, int y, int color, void *xfb) {
-	for (int i = x1; i <= x2; i++) {
-		DrawDotAccurate(i, y, color, xfb);
+// copies a buffer that's already in the framebuffer's format (two pixels per word) onto the screen
+// words that are 0 are skipped, so whatever is under them stays visible
+// offsetX needs to be even
+void drawLayer(void *currXfb, const u32 *layer, u16 widthWords, u16 height, u16 offsetX, u16 offsetY) {
+	PROFILE_SCOPE(PROFILE_IMAGE);
+	if (offsetX + (widthWords * 2) > 640 || offsetY + height > 480) {
+		return;
+	}
+	u32 *tmpfb = currXfb;
+	for (int row = 0; row < height; row++) {
+		u32 *dest = tmpfb + (offsetX >> 1) + ((640 * (offsetY + row)) / 2);
+		const u32 *src = layer + (row * widthWords);
+		for (int col = 0; col < widthWords; col++) {
+			if (src[col] != 0) {
+				dest[col] = src[col];
+			}
+		}
 	}
 }
 
+// the generic versions of the primitives, interlaced is always a constant where these are used
+// always_inline makes sure each mode gets its own copy with the check folded away
+#define PRIMITIVE static inline __attribute__((always_inline))
 
-/*
-* takes in values to draw a vertical line of a given color
-*/
-void DrawVLine (int x, int y1, int y2, int color, void *xfb) {
-	for (int i = y1; i <= y2; i++) {
-		DrawDot(x, i, color, xfb);
+PRIMITIVE void dot(int x, int y, int color, void *xfb, bool interlaced) {
+	if (interlaced) {
+		u32 *tmpfb = xfb;
+		tmpfb[(x >> 1) + (640 * y) / 2] = color;
+	} else {
+		dotAccurate(x, y, color, xfb);
 	}
 }
 
-
-/*
-* takes in values to draw a box of a given color
-*/
-void DrawBox (int x1, int y1, int x2, int y2, int color, void *xfb) {
-	DrawHLine (x1, x2, y1, color, xfb);
-	DrawHLine (x1, x2, y2, color, xfb);
-	DrawVLine (x1, y1, y2, color, xfb);
-	DrawVLine (x2, y1, y2, color, xfb);
+PRIMITIVE void vLine(int x, int y1, int y2, int color, void *xfb, bool interlaced) {
+	for (int i = y1; i <= y2; i++) {
+		dot(x, i, color, xfb, interlaced);
+	}
 }
 
-
-void DrawFilledBox (int x1, int y1, int x2, int y2, int color, void *xfb) {
+PRIMITIVE void filledBox(int x1, int y1, int x2, int y2, int color, void *xfb, bool interlaced) {
 	for (int i = x1; i < x2 + 1; i++) {
-		DrawVLine(i, y1, y2, color, xfb);
+		vLine(i, y1, y2, color, xfb, interlaced);
 	}
 }
 
-
 // draw a line given two coordinates, using Bresenham's line-drawing algorithm
-void DrawLine(int x1, int y1, int x2, int y2, int color, void *xfb) {
+PRIMITIVE void line(int x1, int y1, int x2, int y2, int color, void *xfb, bool interlaced) {
 	// use simpler algorithm if line is horizontal or vertical
 	if (x1 == x2) {
 		if (y1 < y2) {
-			DrawVLine(x1, y1, y2, color, xfb);
+			vLine(x1, y1, y2, color, xfb, interlaced);
 		} else {
-			DrawVLine(x1, y2, y1, color, xfb);
+			vLine(x1, y2, y1, color, xfb, interlaced);
 		}
 		return;
 	}
@@ -135,7 +193,7 @@ void DrawLine(int x1, int y1, int x2, int y2, int color, void *xfb) {
 		int currY = y1;
 		
 		for (int i = 0; i < distanceX; i++) {
-			DrawDot(x1 + (i * xDir), currY, color, xfb);
+			dot(x1 + (i * xDir), currY, color, xfb, interlaced);
 			if (delta > 0) {
 				currY += (1 * yDir);
 				delta -= (2 * distanceX);
@@ -148,9 +206,7 @@ void DrawLine(int x1, int y1, int x2, int y2, int color, void *xfb) {
 		int currX = x1;
 		
 		for (int i = 0; i < distanceY; i++) {
-			DrawDot(currX, (y1 + (i * yDir)), color, xfb);
-			//tmpfb[(((y1 + (i * yDir)) * 640) + currX) / 2] = color;
-			//tmpfb[((x1 + i) + (currY * 640)) / 2] = color;
+			dot(currX, (y1 + (i * yDir)), color, xfb, interlaced);
 			if (delta > 0) {
 				currX += (1 * xDir);
 				delta -= (2 * distanceY);
@@ -160,64 +216,15 @@ void DrawLine(int x1, int y1, int x2, int y2, int color, void *xfb) {
 	}
 }
 
-
-void DrawDot (int x, int y, int color, void *xfb) {
-	if (do2xHorizontalDraw) {
-		x >>= 1;
-		u32 *tmpfb = xfb;
-		tmpfb[x + (640 * y) / 2] = color;
-	} else {
-		DrawDotAccurate(x, y, color, xfb);
-	}
-}
-
-void DrawDotAccurate (int x, int y, int color, void *xfb) {
-	uint32_t *tmpfb = xfb;
-	int index = (x >> 1) + (640 * y) / 2;
-	uint32_t data = tmpfb[index];
-	
-	if (x % 2 == 1) {
-		if (data >> 24 == 0) {
-			// no data in left pixel, leave it as-is
-			tmpfb[index] = color & 0x00FFFFFF;
-		} else {
-			// preserve the left pixel luminance
-			uint32_t leftLuminance = data & 0xFF000000;
-			uint32_t rightLuminance = color & 0x0000FF00;
-			uint32_t cb, cr;
-			// mix cb and cr
-			cb = ( ((data & 0x00FF0000) >> 16) + ((color & 0x00FF0000) >> 16) ) / 2;
-			cr = ( (data & 0x000000FF) + (color & 0x000000FF) ) / 2;
-			tmpfb[index] = leftLuminance | (cb << 16) | rightLuminance | cr;
-		}
-	} else {
-		if ((data & 0xFFFF00FF) >> 8 == 0) {
-			// no data in right pixel, leave it as-is
-			tmpfb[index] = color & 0xFFFF00FF;
-		} else {
-			// preserve the right pixel luminance
-			uint32_t leftLuminance = color & 0xFF000000;
-			uint32_t rightLuminance = data & 0x0000FF00;
-			uint32_t cb, cr;
-			// mix cb and cr
-			cb = ( ((data & 0x00FF0000) >> 16) + ((color & 0x00FF0000) >> 16) ) / 2;
-			cr = ( (data & 0x000000FF) + (color & 0x000000FF) ) / 2;
-			tmpfb[index] = leftLuminance | (cb << 16) | rightLuminance | cr;
-		}
-	}
-}
-
-
-
 // mostly taken from https://www.geeksforgeeks.org/mid-point-circle-drawing-algorithm/
-void DrawCircle (int cx, int cy, int r, int color, void *xfb) {
+PRIMITIVE void circle(int cx, int cy, int r, int color, void *xfb, bool interlaced) {
 	int x = r, y = 0;
 	
 	if (r > 0) {
-		DrawDot(cx + x, cy - y, color, xfb);
-		DrawDot(cx - x, cy + y, color, xfb);
-		DrawDot(cx + y, cy - x, color, xfb);
-		DrawDot(cx - y, cy + x, color, xfb);
+		dot(cx + x, cy - y, color, xfb, interlaced);
+		dot(cx - x, cy + y, color, xfb, interlaced);
+		dot(cx + y, cy - x, color, xfb, interlaced);
+		dot(cx - y, cy + x, color, xfb, interlaced);
 	}
 	
 	int delta = 1 - r;
@@ -236,28 +243,128 @@ void DrawCircle (int cx, int cy, int r, int color, void *xfb) {
 			break;
 		}
 		
-		DrawDot(cx + x, cy + y, color, xfb);
-		DrawDot(cx - x, cy - y, color, xfb);
-		DrawDot(cx + x, cy - y, color, xfb);
-		DrawDot(cx - x, cy + y, color, xfb);
+		dot(cx + x, cy + y, color, xfb, interlaced);
+		dot(cx - x, cy - y, color, xfb, interlaced);
+		dot(cx + x, cy - y, color, xfb, interlaced);
+		dot(cx - x, cy + y, color, xfb, interlaced);
 		
 		if (x != y) {
-			DrawDot(cx + y, cy + x, color, xfb);
-			DrawDot(cx - y, cy + x, color, xfb);
-			DrawDot(cx + y, cy - x, color, xfb);
-			DrawDot(cx - y, cy - x, color, xfb);
+			dot(cx + y, cy + x, color, xfb, interlaced);
+			dot(cx - y, cy + x, color, xfb, interlaced);
+			dot(cx + y, cy - x, color, xfb, interlaced);
+			dot(cx - y, cy - x, color, xfb, interlaced);
 		}
 	}
 }
 
+// each primitive built for each mode
+static void dotInterlaced(int x, int y, int color, void *xfb) {
+	dot(x, y, color, xfb, true);
+}
+static void dotProgressive(int x, int y, int color, void *xfb) {
+	dot(x, y, color, xfb, false);
+}
+static void vLineInterlaced(int x, int y1, int y2, int color, void *xfb) {
+	vLine(x, y1, y2, color, xfb, true);
+}
+static void vLineProgressive(int x, int y1, int y2, int color, void *xfb) {
+	vLine(x, y1, y2, color, xfb, false);
+}
+static void filledBoxInterlaced(int x1, int y1, int x2, int y2, int color, void *xfb) {
+	filledBox(x1, y1, x2, y2, color, xfb, true);
+}
+static void filledBoxProgressive(int x1, int y1, int x2, int y2, int color, void *xfb) {
+	filledBox(x1, y1, x2, y2, color, xfb, false);
+}
+static void lineInterlaced(int x1, int y1, int x2, int y2, int color, void *xfb) {
+	line(x1, y1, x2, y2, color, xfb, true);
+}
+static void lineProgressive(int x1, int y1, int x2, int y2, int color, void *xfb) {
+	line(x1, y1, x2, y2, color, xfb, false);
+}
+static void circleInterlaced(int cx, int cy, int r, int color, void *xfb) {
+	circle(cx, cy, r, color, xfb, true);
+}
+static void circleProgressive(int cx, int cy, int r, int color, void *xfb) {
+	circle(cx, cy, r, color, xfb, false);
+}
+
+static const DrawPrimitives PRIMITIVES_INTERLACED = { dotInterlaced, vLineInterlaced, filledBoxInterlaced,
+                                                      lineInterlaced, circleInterlaced };
+static const DrawPrimitives PRIMITIVES_PROGRESSIVE = { dotProgressive, vLineProgressive, filledBoxProgressive,
+                                                       lineProgressive, circleProgressive };
+
+// taken from github.com/phobgcc/phobconfigtool
+// should probably replace this with something gl based at some point
+/*
+* takes in values to draw a horizontal line of a given color
+*/
+void DrawHLine (int x1, int x2, int y, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	for (int i = x1; i <= x2; i++) {
+		dotAccurate(i, y, color, xfb);
+	}
+}
+
+
+/*
+* takes in values to draw a vertical line of a given color
+*/
+void DrawVLine (int x, int y1, int y2, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	primitives->vLine(x, y1, y2, color, xfb);
+}
+
+
+/*
+* takes in values to draw a box of a given color
+*/
+void DrawBox (int x1, int y1, int x2, int y2, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	DrawHLine (x1, x2, y1, color, xfb);
+	DrawHLine (x1, x2, y2, color, xfb);
+	primitives->vLine(x1, y1, y2, color, xfb);
+	primitives->vLine(x2, y1, y2, color, xfb);
+}
+
+
+void DrawFilledBox (int x1, int y1, int x2, int y2, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	primitives->filledBox(x1, y1, x2, y2, color, xfb);
+}
+
+
+void DrawLine(int x1, int y1, int x2, int y2, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	primitives->line(x1, y1, x2, y2, color, xfb);
+}
+
+
+void DrawDot (int x, int y, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	primitives->dot(x, y, color, xfb);
+}
+
+void DrawDotAccurate (int x, int y, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	dotAccurate(x, y, color, xfb);
+}
+
+
+void DrawCircle (int cx, int cy, int r, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
+	primitives->circle(cx, cy, r, color, xfb);
+}
+
 // taken from
 // https://stackoverflow.com/questions/1201200/fast-algorithm-for-drawing-filled-circles
 // originally this just called DrawCircle for a smaller radius, but it broke when I fixed the DrawDot function.
 void DrawFilledCircle(int cx, int cy, int r, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
 	for (int ty = (r * -1); ty <= r; ty++) {
 		for (int tx = (r * -1); tx <= r; tx++) {
 			if ( (tx * tx) + (ty * ty) <= (r * r)) {
-				DrawDotAccurate(cx + tx, cy + ty, color, xfb);
+				dotAccurate(cx + tx, cy + ty, color, xfb);
 			}
 		}
 	}
@@ -265,12 +372,14 @@ void DrawFilledCircle(int cx, int cy, int r, int color, void *xfb) {
 
 // rad should be number of pixels from the center, _not_ including the center
 void DrawFilledBoxCenter(int x, int y, int rad, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
 	int topLeftX = x - rad;
 	int topLeftY = y - rad;
 	DrawFilledBox(topLeftX, topLeftY, x + rad, y + rad, color, xfb);
 }
 
 void DrawOctagonalGate(int x, int y, int scale, int color, void *xfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
 	const int CARDINAL_MAX = 100 / scale;
 	const int DIAGONAL_MAX = 74 / scale;
 	// analog stick
@@ -301,6 +410,7 @@ void DrawOctagonalGate(int x, int y, int scale, int color, void *xfb) {
 }
 
 void DrawStickmapOverlay(enum STICKMAP_LIST stickmap, int which, void *currXfb) {
+	PROFILE_SCOPE(PROFILE_SHAPES);
 	switch (stickmap) {
 		case (FF_WD):
 			// bools for which parts to draw
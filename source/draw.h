@@ -80,6 +80,7 @@ void setInterlaced(bool interlaced);
 // draw functions
 
 void drawImage(void *currXfb, const unsigned char image[], const unsigned char colorIndex[8], u16 offsetX, u16 offsetY);
+void drawLayer(void *currXfb, const u32 *layer, u16 widthWords, u16 height, u16 offsetX, u16 offsetY);
 
 // drawing functions from phobconfigtool
 void DrawHLine (int x1, int x2, int y, int color, void *xfb);
@@ -0,0 +1,250 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "captureindex.h"
+#include <stdlib.h>
+#include <string.h>
+
+// compact once at least this many records are dead, and they make up half the file
+#define INDEX_COMPACT_MIN_DEAD 64
+
+static void putU16(uint8_t *buf, uint16_t value) {
+	buf[0] = value & 0xFF;
+	buf[1] = (value >> 8) & 0xFF;
+}
+
+static void putU32(uint8_t *buf, uint32_t value) {
+	buf[0] = value & 0xFF;
+	buf[1] = (value >> 8) & 0xFF;
+	buf[2] = (value >> 16) & 0xFF;
+	buf[3] = (value >> 24) & 0xFF;
+}
+
+static uint16_t getU16(const uint8_t *buf) {
+	return buf[0] | (buf[1] << 8);
+}
+
+static uint32_t getU32(const uint8_t *buf) {
+	return ((uint32_t) buf[0]) | ((uint32_t) buf[1] << 8) | ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+// fnv-1a, only needs to catch a record that was cut off or never fully written
+static uint32_t checksum(const uint8_t *buf, uint32_t len) {
+	uint32_t hash = 2166136261u;
+	for (uint32_t i = 0; i < len; i++) {
+		hash ^= buf[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void encodeRecord(const CaptureSummary *summary, uint8_t *buf) {
+	memset(buf, 0, INDEX_RECORD_BYTES);
+	snprintf((char *) buf, INDEX_NAME_LEN, "%s", summary->name);
+	putU32(buf + 32, summary->samples);
+	putU32(buf + 36, summary->durationUs);
+	putU32(buf + 40, summary->exportTime);
+	buf[44] = (uint8_t) summary->testType;
+	buf[45] = summary->flags;
+	buf[46] = (uint8_t) summary->minX;
+	buf[47] = (uint8_t) summary->maxX;
+	buf[48] = (uint8_t) summary->minY;
+	buf[49] = (uint8_t) summary->maxY;
+	putU32(buf + 52, summary->pivotUs);
+	putU32(buf + 60, checksum(buf, 60));
+}
+
+static bool decodeRecord(const uint8_t *buf, CaptureSummary *summary) {
+	if (getU32(buf + 60) != checksum(buf, 60)) {
+		return false;
+	}
+	memcpy(summary->name, buf, INDEX_NAME_LEN);
+	summary->name[INDEX_NAME_LEN - 1] = '\0';
+	summary->samples = getU32(buf + 32);
+	summary->durationUs = getU32(buf + 36);
+	summary->exportTime = getU32(buf + 40);
+	summary->testType = (int8_t) buf[44];
+	summary->flags = buf[45];
+	summary->minX = (int8_t) buf[46];
+	summary->maxX = (int8_t) buf[47];
+	summary->minY = (int8_t) buf[48];
+	summary->maxY = (int8_t) buf[49];
+	summary->pivotUs = getU32(buf + 52);
+	return true;
+}
+
+static bool writeHeader(FILE *fptr) {
+	uint8_t buf[INDEX_HEADER_BYTES];
+	memcpy(buf, INDEX_MAGIC, 4);
+	putU16(buf + 4, INDEX_VERSION);
+	putU16(buf + 6, INDEX_RECORD_BYTES);
+	return fwrite(buf, 1, INDEX_HEADER_BYTES, fptr) == INDEX_HEADER_BYTES;
+}
+
+int index_append(const char *path, const CaptureSummary *summary) {
+	FILE *fptr = fopen(path, "ab");
+	if (fptr == NULL) {
+		return 1;
+	}
+	fseek(fptr, 0, SEEK_END);
+	long size = ftell(fptr);
+	// new file, start with the header
+	if (size == 0 && !writeHeader(fptr)) {
+		fclose(fptr);
+		return 2;
+	}
+	// a write was cut off, pad it out to a full record so everything after it stays aligned
+	// the padded record fails its checksum and gets skipped when loading
+	if (size > INDEX_HEADER_BYTES && (size - INDEX_HEADER_BYTES) % INDEX_RECORD_BYTES != 0) {
+		long padding = INDEX_RECORD_BYTES - ((size - INDEX_HEADER_BYTES) % INDEX_RECORD_BYTES);
+		for (long i = 0; i < padding; i++) {
+			fputc(0, fptr);
+		}
+	}
+
+	uint8_t buf[INDEX_RECORD_BYTES];
+	encodeRecord(summary, buf);
+	bool written = fwrite(buf, 1, INDEX_RECORD_BYTES, fptr) == INDEX_RECORD_BYTES;
+	fclose(fptr);
+	return written ? 0 : 2;
+}
+
+int index_remove(const char *path, const char *name) {
+	CaptureSummary summary;
+	memset(&summary, 0, sizeof(summary));
+	strncpy(summary.name, name, INDEX_NAME_LEN - 1);
+	summary.flags = INDEX_FLAG_REMOVED;
+	return index_append(path, &summary);
+}
+
+int index_find(const CaptureIndex *index, const char *name) {
+	for (uint32_t i = 0; i < index->count; i++) {
+		if (strncmp(index->entries[i].name, name, INDEX_NAME_LEN) == 0) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+int index_load(const char *path, const char *tmpPath, CaptureIndex *index) {
+	index->count = 0;
+	index->records = 0;
+
+	FILE *fptr = fopen(path, "rb");
+	if (fptr == NULL) {
+		// the old index was removed, but the compacted one never got renamed
+		if (rename(tmpPath, path) != 0) {
+			return 0;
+		}
+		fptr = fopen(path, "rb");
+		if (fptr == NULL) {
+			return 0;
+		}
+	}
+
+	uint8_t buf[INDEX_RECORD_BYTES];
+	if (fread(buf, 1, INDEX_HEADER_BYTES, fptr) != INDEX_HEADER_BYTES || memcmp(buf, INDEX_MAGIC, 4) != 0 ||
+	    getU16(buf + 4) != INDEX_VERSION || getU16(buf + 6) != INDEX_RECORD_BYTES) {
+		fclose(fptr);
+		return 1;
+	}
+
+	CaptureSummary summary;
+	while (fread(buf, 1, INDEX_RECORD_BYTES, fptr) == INDEX_RECORD_BYTES) {
+		index->records++;
+		// skip records from writes that didn't finish
+		if (!decodeRecord(buf, &summary)) {
+			continue;
+		}
+		int existing = index_find(index, summary.name);
+		if (summary.flags & INDEX_FLAG_REMOVED) {
+			if (existing != -1) {
+				index->entries[existing] = index->entries[index->count - 1];
+				index->count--;
+			}
+		} else if (existing != -1) {
+			index->entries[existing] = summary;
+		} else if (index->count < INDEX_MAX_ENTRIES) {
+			index->entries[index->count] = summary;
+			index->count++;
+		}
+	}
+	fclose(fptr);
+	return 0;
+}
+
+bool index_needsCompaction(const CaptureIndex *index) {
+	uint32_t dead = index->records - index->count;
+	return dead >= INDEX_COMPACT_MIN_DEAD && dead >= index->count;
+}
+
+int index_compact(const char *path, const char *tmpPath, CaptureIndex *index) {
+	FILE *fptr = fopen(tmpPath, "wb");
+	if (fptr == NULL) {
+		return 1;
+	}
+	if (!writeHeader(fptr)) {
+		fclose(fptr);
+		return 2;
+	}
+	uint8_t buf[INDEX_RECORD_BYTES];
+	for (uint32_t i = 0; i < index->count; i++) {
+		encodeRecord(&index->entries[i], buf);
+		if (fwrite(buf, 1, INDEX_RECORD_BYTES, fptr) != INDEX_RECORD_BYTES) {
+			fclose(fptr);
+			return 2;
+		}
+	}
+	if (fclose(fptr) != 0) {
+		return 2;
+	}
+
+	// fat can't rename over an existing file
+	// if this gets interrupted between the two, index_load picks up the temporary file
+	remove(path);
+	if (rename(tmpPath, path) != 0) {
+		return 3;
+	}
+	index->records = index->count;
+	return 0;
+}
+
+static int compareNewest(const void *a, const void *b) {
+	// names start with the date, so reverse alphabetical is newest first
+	return strcmp(((const CaptureSummary *) b)->name, ((const CaptureSummary *) a)->name);
+}
+
+static int compareOldest(const void *a, const void *b) {
+	return compareNewest(b, a);
+}
+
+static int compareSamples(const void *a, const void *b) {
+	uint32_t sa = ((const CaptureSummary *) a)->samples, sb = ((const CaptureSummary *) b)->samples;
+	return (sa < sb) - (sa > sb);
+}
+
+static int compareDuration(const void *a, const void *b) {
+	uint32_t da = ((const CaptureSummary *) a)->durationUs, db = ((const CaptureSummary *) b)->durationUs;
+	return (da < db) - (da > db);
+}
+
+void index_sort(CaptureIndex *index, enum INDEX_SORT sort) {
+	int (*compare)(const void *, const void *);
+	switch (sort) {
+		case INDEX_SORT_OLDEST:
+			compare = compareOldest;
+			break;
+		case INDEX_SORT_SAMPLES:
+			compare = compareSamples;
+			break;
+		case INDEX_SORT_DURATION:
+			compare = compareDuration;
+			break;
+		case INDEX_SORT_NEWEST:
+		default:
+			compare = compareNewest;
+			break;
+	}
+	qsort(index->entries, index->count, sizeof(CaptureSummary), compare);
+}
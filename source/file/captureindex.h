@@ -0,0 +1,84 @@
+//
+// Created on 2026/10/18.
+//
+
+// index of exported captures, so they can be browsed without opening every file
+// the index is append-only, a new record for the same name replaces the old one, and a removed flag deletes it
+// if the console loses power mid-write, only the record being written is lost
+// once enough records are replaced, the index is rewritten to a temporary file and swapped in
+// host/captureindex.c checks the recovery paths against a real file
+
+#ifndef GTS_CAPTUREINDEX_H
+#define GTS_CAPTUREINDEX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// max number of captures the browser can hold
+#define INDEX_MAX_ENTRIES 1024
+#define INDEX_NAME_LEN 32
+
+// file layout, everything little endian:
+// header:  "GTSI", u16 version, u16 bytes per record
+// records: char name[32], u32 samples, u32 duration (us), u32 export time (unix),
+//          s8 test type, u8 flags, s8 min x, s8 max x, s8 min y, s8 max y, u16 reserved,
+//          u32 pivot time (us), u32 reserved, u32 checksum of everything before it in the record
+#define INDEX_MAGIC "GTSI"
+#define INDEX_VERSION 1
+#define INDEX_HEADER_BYTES 8
+#define INDEX_RECORD_BYTES 64
+
+#define INDEX_FLAG_REMOVED 0x01
+#define INDEX_FLAG_PIVOT 0x02
+
+typedef struct CaptureSummary {
+	char name[INDEX_NAME_LEN];
+	uint32_t samples;
+	uint32_t durationUs;
+	uint32_t exportTime;
+	// enum OSCILLOSCOPE_TEST, -1 if unknown
+	int8_t testType;
+	uint8_t flags;
+	// stick range over the whole capture, the snapback result
+	int8_t minX;
+	int8_t maxX;
+	int8_t minY;
+	int8_t maxY;
+	// only valid with INDEX_FLAG_PIVOT
+	uint32_t pivotUs;
+} CaptureSummary;
+
+typedef struct CaptureIndex {
+	CaptureSummary entries[INDEX_MAX_ENTRIES];
+	uint32_t count;
+	// records in the file, including replaced and removed ones
+	uint32_t records;
+} CaptureIndex;
+
+enum INDEX_SORT { INDEX_SORT_NEWEST, INDEX_SORT_OLDEST, INDEX_SORT_SAMPLES, INDEX_SORT_DURATION, INDEX_SORT_LEN };
+
+// add a record to the end of the index, creating it if needed
+// returns 0 on success
+int index_append(const char *path, const CaptureSummary *summary);
+
+// mark a capture as removed
+int index_remove(const char *path, const char *name);
+
+// read the index, tmpPath is where compaction writes to, and is used if a compaction was interrupted
+// a missing index is not an error, it just loads empty
+// returns 0 on success, 1 if the file isn't an index
+int index_load(const char *path, const char *tmpPath, CaptureIndex *index);
+
+// whether enough records were replaced that rewriting the index is worth it
+bool index_needsCompaction(const CaptureIndex *index);
+
+// write only the current entries to tmpPath, then swap it in for path
+int index_compact(const char *path, const char *tmpPath, CaptureIndex *index);
+
+// find an entry by name, -1 if it isn't in the index
+int index_find(const CaptureIndex *index, const char *name);
+
+void index_sort(CaptureIndex *index, enum INDEX_SORT sort);
+
+#endif //GTS_CAPTUREINDEX_H
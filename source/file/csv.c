@@ -0,0 +1,169 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "csv.h"
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+int csv_parse(FILE *fptr, CsvFieldCallback callback, void *ctx) {
+	char field[CSV_FIELD_MAX];
+	uint32_t len = 0;
+	uint32_t row = 0, col = 0;
+	// whether anything has been read on the current row, so a trailing newline doesn't make an empty row
+	bool rowStarted = false;
+
+	while (true) {
+		int c = getc(fptr);
+		if (c == '\r') {
+			continue;
+		}
+		if (c == ',' || c == '\n' || c == EOF) {
+			if (c == ',' || rowStarted || len != 0) {
+				field[len] = '\0';
+				if (!callback(ctx, row, col, field)) {
+					return 2;
+				}
+				col++;
+				rowStarted = true;
+			}
+			len = 0;
+			if (c == '\n' && rowStarted) {
+				row++;
+				col = 0;
+				rowStarted = false;
+			}
+			if (c == EOF) {
+				return 0;
+			}
+			continue;
+		}
+		if (len == CSV_FIELD_MAX - 1) {
+			return 1;
+		}
+		field[len++] = c;
+	}
+}
+
+typedef struct CaptureParseState {
+	char *timeStr;
+	uint32_t *sampleCount;
+	CaptureValueCallback callback;
+	void *ctx;
+	bool malformed;
+	// values seen in each row, a file that was cut off comes up short
+	uint32_t rowValues[CAPTURE_CSV_TIME + 1];
+} CaptureParseState;
+
+static bool captureField(void *ctx, uint32_t row, uint32_t col, const char *field) {
+	CaptureParseState *state = ctx;
+
+	if (row == CAPTURE_CSV_HEADER) {
+		if (col == 0) {
+			strncpy(state->timeStr, field, CSV_FIELD_MAX - 1);
+			state->timeStr[CSV_FIELD_MAX - 1] = '\0';
+		} else if (col == 1) {
+			*(state->sampleCount) = strtoul(field, NULL, 10);
+		}
+		return true;
+	}
+
+	if (row > CAPTURE_CSV_TIME || col >= *(state->sampleCount)) {
+		state->malformed = true;
+		return false;
+	}
+
+	char *end;
+	long long value = strtoll(field, &end, 10);
+	if (end == field || *end != '\0') {
+		state->malformed = true;
+		return false;
+	}
+	state->rowValues[row]++;
+	return state->callback(state->ctx, row, col, value);
+}
+
+int csv_readCapture(FILE *fptr, char *timeStr, uint32_t *sampleCount, CaptureValueCallback callback, void *ctx) {
+	CaptureParseState state = { timeStr, sampleCount, callback, ctx, false, { 0 } };
+	timeStr[0] = '\0';
+	*sampleCount = 0;
+
+	int ret = csv_parse(fptr, captureField, &state);
+	if (state.malformed || ret == 1) {
+		return 1;
+	}
+	if (ret != 0) {
+		return ret;
+	}
+	// every data row needs every sample, missing ones would otherwise just never get set
+	for (int row = CAPTURE_CSV_AX; row <= CAPTURE_CSV_TIME; row++) {
+		if (state.rowValues[row] != *sampleCount) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+static bool waveformValue(void *ctx, enum CAPTURE_CSV_ROW row, uint32_t index, long long value) {
+	WaveformData *data = ctx;
+	if (index >= WAVEFORM_SAMPLES) {
+		return false;
+	}
+	// anything a stick or a poll interval can't be means the file isn't a capture
+	if ((row == CAPTURE_CSV_AX || row == CAPTURE_CSV_AY) && (value < INT8_MIN || value > INT8_MAX)) {
+		return false;
+	}
+	if (row == CAPTURE_CSV_TIME && value < 0) {
+		return false;
+	}
+	switch (row) {
+		case CAPTURE_CSV_AX:
+			data->data[index].ax = value;
+			break;
+		case CAPTURE_CSV_AY:
+			data->data[index].ay = value;
+			break;
+		case CAPTURE_CSV_TIME:
+			data->data[index].timeDiffUs = value;
+			break;
+		default:
+			break;
+	}
+	return true;
+}
+
+int csv_readWaveform(FILE *fptr, WaveformData *data) {
+	memset(data->data, 0, sizeof(data->data));
+
+	char timeStr[CSV_FIELD_MAX];
+	uint32_t sampleCount;
+	int ret = csv_readCapture(fptr, timeStr, &sampleCount, waveformValue, data);
+	if (ret != 0 || sampleCount == 0 || sampleCount > WAVEFORM_SAMPLES) {
+		data->endPoint = 0;
+		return 1;
+	}
+
+	data->endPoint = sampleCount;
+	data->totalTimeUs = 0;
+	for (uint32_t i = 0; i < sampleCount; i++) {
+		data->totalTimeUs += data->data[i].timeDiffUs;
+	}
+	data->fullMeasure = false;
+	data->exported = false;
+	data->testType = -1;
+	return 0;
+}
+
+bool csv_isCaptureName(const char *name) {
+	static const char PATTERN[] = "####-##-##_##-##-##_#.csv";
+	if (strlen(name) != strlen(PATTERN)) {
+		return false;
+	}
+	for (int i = 0; PATTERN[i] != '\0'; i++) {
+		if (PATTERN[i] == '#' ? !isdigit((unsigned char) name[i]) : name[i] != PATTERN[i]) {
+			return false;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,50 @@
+//
+// Created on 2026/10/18.
+//
+
+// streaming csv reader, reads one character at a time so files never have to fit in memory
+// gtsbatch reads exported captures with this same parser
+
+#ifndef GTS_CSV_H
+#define GTS_CSV_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "../waveform.h"
+
+// longest field that can be read, anything longer is treated as a malformed file
+#define CSV_FIELD_MAX 64
+
+// called for every field, row and col start at 0
+// return false to stop parsing
+typedef bool (*CsvFieldCallback)(void *ctx, uint32_t row, uint32_t col, const char *field);
+
+// quoting isn't supported, nothing we write needs it
+// returns 0 on success, 1 if a field is too long, 2 if the callback stopped early
+int csv_parse(FILE *fptr, CsvFieldCallback callback, void *ctx);
+
+// rows of a capture from exportData, the first row is the date and number of samples
+enum CAPTURE_CSV_ROW { CAPTURE_CSV_HEADER, CAPTURE_CSV_AX, CAPTURE_CSV_AY, CAPTURE_CSV_TIME };
+
+// called for every value in a capture, index is the sample number
+// return false to stop parsing
+typedef bool (*CaptureValueCallback)(void *ctx, enum CAPTURE_CSV_ROW row, uint32_t index, long long value);
+
+// read a capture written by exportData
+// timeStr gets the date from the first row, and needs to hold CSV_FIELD_MAX chars
+// a file is malformed if any value isn't a whole number, or the stick and time rows don't each have sampleCount values
+// returns 0 on success, 1 if the file is malformed, 2 if the callback stopped early
+int csv_readCapture(FILE *fptr, char *timeStr, uint32_t *sampleCount, CaptureValueCallback callback, void *ctx);
+
+// read a capture written by exportData straight into data, and fill in endPoint and totalTimeUs
+// the test type isn't in the file, so it's set to -1
+// returns 0 on success, 1 if the file is malformed, has more than WAVEFORM_SAMPLES samples,
+// or has a stick value outside -128 to 127 or a negative time
+int csv_readWaveform(FILE *fptr, WaveformData *data);
+
+// whether a file is named like exportData names captures, YYYY-MM-DD_HH-MM-SS_N.csv
+// the other exports in /GTS (soak logs, attempts, the profile) are csv too, and aren't captures
+bool csv_isCaptureName(const char *name);
+
+#endif //GTS_CSV_H
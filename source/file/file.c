@@ -6,16 +6,75 @@
 #include <stdlib.h>
 #include "../waveform.h"
 #include "../print.h"
+#include "../recorder.h"
+#include "csv.h"
+#include "captureindex.h"
+#include "../analysis/analysis.h"
+#include "../analysis/attempts.h"
+#include "../profiler.h"
 #include <stdbool.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <time.h>
+#include <dirent.h>
 
 // appended to the file, in order to prevent files from being overwritten
 // technically this can only occur if someone exports multiple in one second
 static unsigned int increment = 0;
 
+#define CAPTURE_INDEX_PATH "/GTS/index.bin"
+#define CAPTURE_INDEX_TMP_PATH "/GTS/index.tmp"
+
+// get current time in YY-MM-DD_HH-MM-SS format
+// timeStr needs to hold at least 32 chars
+// returns the time that was used
+static time_t getTimeStr(char *timeStr) {
+	time_t currTime;
+	struct tm * timeinfo;
+	time(&currTime);
+	timeinfo = localtime(&currTime);
+	// YYYY-MM-DD_HH-MM-SS_microS
+	strftime(timeStr, 32, "%Y-%m-%d_%H-%M-%S", timeinfo);
+	return currTime;
+}
+
+// fill in the index entry for a capture
+static void summarizeCapture(WaveformData *data, const char *name, time_t exportTime, CaptureSummary *summary) {
+	memset(summary, 0, sizeof(CaptureSummary));
+	strncpy(summary->name, name, INDEX_NAME_LEN - 1);
+	summary->samples = data->endPoint;
+	summary->durationUs = data->totalTimeUs;
+	summary->exportTime = exportTime;
+	summary->testType = data->testType;
+	
+	StickRange range;
+	analysis_stickRange(data, 0, data->endPoint, false, &range);
+	summary->minX = range.minX;
+	summary->maxX = range.maxX;
+	summary->minY = range.minY;
+	summary->maxY = range.maxY;
+	
+	PivotResult pivot;
+	if (analysis_pivot(data, &pivot)) {
+		summary->flags |= INDEX_FLAG_PIVOT;
+		summary->pivotUs = pivot.timeInRangeUs;
+	}
+}
+
+// create directory if it doesn't exist
+// https://stackoverflow.com/questions/7430248/creating-a-new-directory-in-c
+static bool createExportDir() {
+	struct stat st = {0};
+	if (stat("/GTS", &st) == -1) {
+		if (mkdir("/GTS", 0700) == -1) {
+			return false;
+		}
+	}
+	return true;
+}
+
 int exportData(WaveformData *data) {
+	PROFILE_SCOPE(PROFILE_EXPORT);
 	data->exported = true;
 	// do we have data to begin with?
 	if (!data->isDataReady) {
@@ -26,27 +85,11 @@ int exportData(WaveformData *data) {
 		return 2;
 	}
 	
-	// get current time in YY-MM-DD_HH-MM-SS format
-	time_t currTime;
-	struct tm * timeinfo;
-	
 	char timeStr[32];
-	{
-		time(&currTime);
-		timeinfo = localtime(&currTime);
-		// YYYY-MM-DD_HH-MM-SS_microS
-		strftime(timeStr, 32, "%Y-%m-%d_%H-%M-%S", timeinfo);
-	}
+	time_t currTime = getTimeStr(timeStr);
 	
-	// create directory if it doesn't exist
-	// https://stackoverflow.com/questions/7430248/creating-a-new-directory-in-c
-	{
-		struct stat st = {0};
-		if (stat("/GTS", &st) == -1) {
-			if (mkdir("/GTS", 0700) == -1) {
-				return 3;
-			}
-		}
+	if (!createExportDir()) {
+		return 3;
 	}
 	
 	// create filepath
@@ -110,5 +153,353 @@ int exportData(WaveformData *data) {
 	}
 	fprintf(fptr, "\n");
 	fclose(fptr);
+	
+	// keep the index up to date, the export itself still worked if this fails
+	CaptureSummary summary;
+	summarizeCapture(data, fileStr + strlen("/GTS/"), currTime, &summary);
+	index_append(CAPTURE_INDEX_PATH, &summary);
 	return 0;
-}
\ No newline at end of file
+}
+
+// base path for the current soak test, without an extension
+static char soakPath[64] = "";
+static const char* SOAK_AXIS_NAMES[SOAK_AXES] = { "ax", "ay", "cx", "cy" };
+
+int startSoakExport() {
+	soakPath[0] = '\0';
+	
+	if (!fatInitDefault()) {
+		return 2;
+	}
+	
+	char timeStr[32];
+	getTimeStr(timeStr);
+	
+	if (!createExportDir()) {
+		return 3;
+	}
+	
+	char fileStr[80];
+	snprintf(soakPath, sizeof(soakPath), "/GTS/soak_%s", timeStr);
+	snprintf(fileStr, sizeof(fileStr), "%s.csv", soakPath);
+	
+	{
+		struct stat st = {0};
+		// check if file already exists
+		if (stat(fileStr, &st) == 0) {
+			soakPath[0] = '\0';
+			return 4;
+		}
+	}
+	
+	FILE *fptr = fopen(fileStr, "w");
+	if (fptr == NULL) {
+		soakPath[0] = '\0';
+		return 5;
+	}
+	
+	// one row gets added per snapshot
+	fprintf(fptr, "elapsed_s,samples,dropped,interval_mean_us,interval_sd_us,interval_min_us,interval_max_us,gaps");
+	for (int i = 0; i < SOAK_AXES; i++) {
+		fprintf(fptr, ",%s_min,%s_max", SOAK_AXIS_NAMES[i], SOAK_AXIS_NAMES[i]);
+		for (int j = 0; j < SOAK_QUANTILE_LEN; j++) {
+			fprintf(fptr, ",%s_p%g", SOAK_AXIS_NAMES[i], SOAK_QUANTILES[j] * 100);
+		}
+		fprintf(fptr, ",%s_rest_mean,%s_rest_sd,%s_drift", SOAK_AXIS_NAMES[i], SOAK_AXIS_NAMES[i], SOAK_AXIS_NAMES[i]);
+	}
+	fprintf(fptr, "\n");
+	fclose(fptr);
+	return 0;
+}
+
+int exportSoakSnapshot(const SoakStats *stats, u32 dropped) {
+	if (soakPath[0] == '\0') {
+		return 1;
+	}
+	
+	char fileStr[80];
+	snprintf(fileStr, sizeof(fileStr), "%s.csv", soakPath);
+	FILE *fptr = fopen(fileStr, "a");
+	if (fptr == NULL) {
+		return 5;
+	}
+	
+	float mean, stdDev;
+	soakStats_interval(stats, &mean, &stdDev);
+	fprintf(fptr, "%llu,%llu,%u,%0.2f,%0.2f,%u,%u,%u", stats->elapsedUs / 1000000, stats->samples, dropped,
+	        mean, stdDev, stats->samples > 1 ? stats->intervalMinUs : 0, stats->intervalMaxUs, stats->gaps);
+	for (int i = 0; i < SOAK_AXES; i++) {
+		fprintf(fptr, ",%d,%d", stats->axis[i].min, stats->axis[i].max);
+		for (int j = 0; j < SOAK_QUANTILE_LEN; j++) {
+			fprintf(fptr, ",%0.2f", p2_get(&stats->axis[i].quantiles[j]));
+		}
+		if (soakStats_rest(stats, i, &mean, &stdDev)) {
+			fprintf(fptr, ",%0.3f,%0.3f", mean, stdDev);
+		} else {
+			fprintf(fptr, ",,");
+		}
+		fprintf(fptr, ",%0.3f", soakStats_driftRange(stats, i));
+	}
+	fprintf(fptr, "\n");
+	fclose(fptr);
+	
+	// rest histograms and drift get rewritten every time, they only make sense as a whole
+	snprintf(fileStr, sizeof(fileStr), "%s_rest.csv", soakPath);
+	fptr = fopen(fileStr, "w");
+	if (fptr == NULL) {
+		return 5;
+	}
+	fprintf(fptr, "value,ax,ay,cx,cy\n");
+	for (int i = 0; i < SOAK_REST_BINS; i++) {
+		fprintf(fptr, "%d", i - SOAK_REST_RANGE);
+		for (int j = 0; j < SOAK_AXES; j++) {
+			fprintf(fptr, ",%u", stats->axis[j].restHistogram[i]);
+		}
+		fprintf(fptr, "\n");
+	}
+	fclose(fptr);
+	
+	snprintf(fileStr, sizeof(fileStr), "%s_drift.csv", soakPath);
+	fptr = fopen(fileStr, "w");
+	if (fptr == NULL) {
+		return 5;
+	}
+	fprintf(fptr, "start_s,ax,ay,cx,cy\n");
+	for (u32 i = 0; i < stats->driftUsed; i++) {
+		fprintf(fptr, "%llu", (i * stats->driftBucketUs) / 1000000);
+		for (int j = 0; j < SOAK_AXES; j++) {
+			if (soakStats_driftMean(stats, i, j, &mean)) {
+				fprintf(fptr, ",%0.3f", mean);
+			} else {
+				fprintf(fptr, ",");
+			}
+		}
+		fprintf(fptr, "\n");
+	}
+	fclose(fptr);
+	return 0;
+}
+
+
+// the current practice session's attempts, empty if it isn't being exported
+static char attemptPath[64] = "";
+static const char* ATTEMPT_TEST_NAMES[] = { "snapback", "pivot", "dashback", "none" };
+
+int startAttemptExport() {
+	attemptPath[0] = '\0';
+	
+	if (!fatInitDefault()) {
+		return 2;
+	}
+	
+	char timeStr[32];
+	getTimeStr(timeStr);
+	
+	if (!createExportDir()) {
+		return 3;
+	}
+	
+	char fileStr[64];
+	snprintf(fileStr, sizeof(fileStr), "/GTS/attempts_%s.csv", timeStr);
+	
+	{
+		struct stat st = {0};
+		// check if file already exists
+		if (stat(fileStr, &st) == 0) {
+			return 4;
+		}
+	}
+	
+	FILE *fptr = fopen(fileStr, "w");
+	if (fptr == NULL) {
+		return 5;
+	}
+	// one row gets added per attempt
+	fprintf(fptr, "attempt,test,success,value,unit,percent,duration_ms\n");
+	fclose(fptr);
+	snprintf(attemptPath, sizeof(attemptPath), "%s", fileStr);
+	return 0;
+}
+
+int exportAttempt(const AttemptRow *row) {
+	if (attemptPath[0] == '\0') {
+		return 1;
+	}
+	
+	FILE *fptr = fopen(attemptPath, "a");
+	if (fptr == NULL) {
+		return 5;
+	}
+	fprintf(fptr, "%u,%s,%d,", row->number, ATTEMPT_TEST_NAMES[row->test], row->success);
+	if (row->test != MOTION_NONE && row->measured) {
+		fprintf(fptr, "%0.3f,%s,", row->value, ATTEMPT_UNITS[row->test]);
+	} else {
+		fprintf(fptr, ",,");
+	}
+	if (row->test == MOTION_PIVOT || row->test == MOTION_DASHBACK) {
+		fprintf(fptr, "%0.1f,", row->percent);
+	} else {
+		fprintf(fptr, ",");
+	}
+	fprintf(fptr, "%0.3f\n", row->durationUs / 1000.0);
+	fclose(fptr);
+	return 0;
+}
+
+
+int openRecordingFile(FILE **fptr) {
+	*fptr = NULL;
+	
+	if (!fatInitDefault()) {
+		return 2;
+	}
+	
+	char timeStr[32];
+	getTimeStr(timeStr);
+	
+	if (!createExportDir()) {
+		return 3;
+	}
+	
+	char fileStr[64];
+	snprintf(fileStr, sizeof(fileStr), "/GTS/rec_%s.gtsr", timeStr);
+	
+	{
+		struct stat st = {0};
+		// check if file already exists
+		if (stat(fileStr, &st) == 0) {
+			return 4;
+		}
+	}
+	
+	FILE *file = fopen(fileStr, "wb");
+	if (file == NULL) {
+		return 5;
+	}
+	if (!recorder_writeHeader(file)) {
+		fclose(file);
+		return 5;
+	}
+	*fptr = file;
+	return 0;
+}
+
+
+static int compareNamesNewestFirst(const void *a, const void *b) {
+	// names start with the date, so reverse alphabetical is newest first
+	return strcmp((const char *) b, (const char *) a);
+}
+
+int listCaptures(char names[][CAPTURE_NAME_LEN], int maxNames) {
+	if (!fatInitDefault()) {
+		return -1;
+	}
+	
+	DIR *dir = opendir("/GTS");
+	if (dir == NULL) {
+		return 0;
+	}
+	
+	int count = 0;
+	struct dirent *entry;
+	while ((entry = readdir(dir)) != NULL && count < maxNames) {
+		// only captures from exportData, other exports are csv too
+		if (!csv_isCaptureName(entry->d_name)) {
+			continue;
+		}
+		strcpy(names[count], entry->d_name);
+		count++;
+	}
+	closedir(dir);
+	
+	qsort(names, count, CAPTURE_NAME_LEN, compareNamesNewestFirst);
+	return count;
+}
+
+int importData(const char *name, WaveformData *data) {
+	char fileStr[16 + CAPTURE_NAME_LEN];
+	snprintf(fileStr, sizeof(fileStr), "/GTS/%s", name);
+	
+	FILE *fptr = fopen(fileStr, "r");
+	if (fptr == NULL) {
+		return 2;
+	}
+	// the parser reads a character at a time, a bigger buffer means fewer reads from the card
+	setvbuf(fptr, NULL, _IOFBF, 16 * 1024);
+	
+	data->isDataReady = false;
+	int ret = csv_readWaveform(fptr, data);
+	fclose(fptr);
+	if (ret != 0) {
+		return 1;
+	}
+	
+	// it's already on the card
+	data->exported = true;
+	data->isDataReady = true;
+	return 0;
+}
+
+int loadCaptureIndex(CaptureIndex *index) {
+	index->count = 0;
+	if (!fatInitDefault()) {
+		return 2;
+	}
+	if (index_load(CAPTURE_INDEX_PATH, CAPTURE_INDEX_TMP_PATH, index) != 0) {
+		return 1;
+	}
+	if (index_needsCompaction(index)) {
+		index_compact(CAPTURE_INDEX_PATH, CAPTURE_INDEX_TMP_PATH, index);
+	}
+	return 0;
+}
+
+int rebuildCaptureIndex(CaptureIndex *index) {
+	if (!fatInitDefault()) {
+		return 2;
+	}
+	// keep what we already know, the test type isn't stored in the capture itself
+	if (index_load(CAPTURE_INDEX_PATH, CAPTURE_INDEX_TMP_PATH, index) != 0) {
+		index->count = 0;
+	}
+	
+	char (*names)[CAPTURE_NAME_LEN] = malloc(INDEX_MAX_ENTRIES * CAPTURE_NAME_LEN);
+	WaveformData *capture = malloc(sizeof(WaveformData));
+	if (names == NULL || capture == NULL) {
+		free(names);
+		free(capture);
+		return 6;
+	}
+	int nameCount = listCaptures(names, INDEX_MAX_ENTRIES);
+	
+	// drop entries for files that are gone
+	for (int i = index->count - 1; i >= 0; i--) {
+		bool found = false;
+		for (int j = 0; j < nameCount; j++) {
+			if (strcmp(index->entries[i].name, names[j]) == 0) {
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			index->entries[i] = index->entries[index->count - 1];
+			index->count--;
+		}
+	}
+	
+	// add anything that was exported before the index existed
+	for (int i = 0; i < nameCount && index->count < INDEX_MAX_ENTRIES; i++) {
+		if (strlen(names[i]) >= INDEX_NAME_LEN || index_find(index, names[i]) != -1) {
+			continue;
+		}
+		if (importData(names[i], capture) != 0) {
+			continue;
+		}
+		summarizeCapture(capture, names[i], 0, &index->entries[index->count]);
+		index->count++;
+	}
+	free(names);
+	free(capture);
+	
+	return index_compact(CAPTURE_INDEX_PATH, CAPTURE_INDEX_TMP_PATH, index) == 0 ? 0 : 5;
+}
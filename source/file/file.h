@@ -1,10 +1,43 @@
+#ifndef GTS_FILE_H
+#define GTS_FILE_H
+
+#include <gccore.h>
 
 #include "../waveform.h"
+#include "../soakstats.h"
+#include "../analysis/attempts.h"
+#include "captureindex.h"
 #include <stdbool.h>
+#include <stdio.h>
 
-#ifndef GTS_FILE_H
-#define GTS_FILE_H
+// longest capture file name that can be listed
+#define CAPTURE_NAME_LEN 48
 
 int exportData(WaveformData *data);
 
+// fill names with the captures in /GTS/, newest first
+// returns the number of captures found, or -1 if the filesystem couldn't be read
+int listCaptures(char names[][CAPTURE_NAME_LEN], int maxNames);
+// load a capture from /GTS/ back into data, only x, y and timing are stored in the file
+int importData(const char *name, WaveformData *data);
+
+// read /GTS/index.bin, compacting it if needed, returns 0 on success
+int loadCaptureIndex(CaptureIndex *index);
+// scan /GTS/ and bring the index in line with the files there, returns 0 on success
+// this opens every capture that isn't indexed yet, so it can be slow
+int rebuildCaptureIndex(CaptureIndex *index);
+
+// create a new soak test log, returns 0 on success
+int startSoakExport();
+// append the current stats to the soak test log, and rewrite the histogram and drift files
+int exportSoakSnapshot(const SoakStats *stats, u32 dropped);
+
+// create a new practice session log, returns 0 on success
+int startAttemptExport();
+// append one attempt to the practice session log
+int exportAttempt(const AttemptRow *row);
+
+// create a new recording file in /GTS/ with the header already written, returns 0 on success
+int openRecordingFile(FILE **fptr);
+
 #endif //GTS_FILE_H
@@ -0,0 +1,89 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "frametime.h"
+#include <stdio.h>
+#include <string.h>
+
+static uint32_t bucketFor(uint32_t ns) {
+	if (ns < FRAMETIME_SUB_BUCKETS) {
+		return ns;
+	}
+	// position of the highest set bit, at least FRAMETIME_SUB_BITS here
+	uint32_t exp = 31 - __builtin_clz(ns);
+	uint32_t sub = (ns >> (exp - FRAMETIME_SUB_BITS)) & (FRAMETIME_SUB_BUCKETS - 1);
+	return ((exp - FRAMETIME_SUB_BITS + 1) * FRAMETIME_SUB_BUCKETS) + sub;
+}
+
+// middle of the range a bucket covers
+static uint32_t bucketValue(uint32_t bucket) {
+	if (bucket < FRAMETIME_SUB_BUCKETS) {
+		return bucket;
+	}
+	uint32_t exp = (bucket / FRAMETIME_SUB_BUCKETS) + FRAMETIME_SUB_BITS - 1;
+	uint32_t sub = bucket % FRAMETIME_SUB_BUCKETS;
+	uint64_t width = 1ull << (exp - FRAMETIME_SUB_BITS);
+	uint64_t low = (1ull << exp) + (sub * width);
+	return low + (width / 2);
+}
+
+void frameTime_reset(FrameTimeStats *stats) {
+	memset(stats, 0, sizeof(FrameTimeStats));
+}
+
+void frameTime_add(FrameTimeStats *stats, uint32_t ns) {
+	if (stats->count == 0 || ns < stats->minNs) {
+		stats->minNs = ns;
+	}
+	if (ns > stats->maxNs) {
+		stats->maxNs = ns;
+	}
+	stats->count++;
+	stats->totalNs += ns;
+	stats->buckets[bucketFor(ns)]++;
+}
+
+uint32_t frameTime_percentile(const FrameTimeStats *stats, uint32_t percent) {
+	if (stats->count == 0) {
+		return 0;
+	}
+	// nearest rank
+	uint64_t rank = (((uint64_t) stats->count * percent) + 99) / 100;
+	if (rank == 0) {
+		rank = 1;
+	}
+	uint64_t seen = 0;
+	for (uint32_t i = 0; i < FRAMETIME_BUCKETS; i++) {
+		seen += stats->buckets[i];
+		if (seen >= rank) {
+			uint32_t value = bucketValue(i);
+			// the ends of the distribution are known exactly
+			if (value < stats->minNs) {
+				return stats->minNs;
+			}
+			if (value > stats->maxNs) {
+				return stats->maxNs;
+			}
+			return value;
+		}
+	}
+	return stats->maxNs;
+}
+
+uint32_t frameTime_meanNs(const FrameTimeStats *stats) {
+	if (stats->count == 0) {
+		return 0;
+	}
+	return stats->totalNs / stats->count;
+}
+
+int frameTime_formatHeader(char *buf, size_t len) {
+	return snprintf(buf, len, "%-17s %6s %8s %8s %8s %8s\n", "menu (us)", "frames", "min", "p50", "p99", "max");
+}
+
+int frameTime_formatRow(char *buf, size_t len, const char *name, const FrameTimeStats *stats) {
+	return snprintf(buf, len, "%-17s %6u %8.1f %8.1f %8.1f %8.1f\n", name, (unsigned int) stats->count,
+	                stats->minNs / 1000.0, frameTime_percentile(stats, 50) / 1000.0,
+	                frameTime_percentile(stats, 99) / 1000.0, stats->maxNs / 1000.0);
+}
@@ -0,0 +1,43 @@
+//
+// Created on 2026/10/18.
+//
+
+// frame time distributions in constant memory
+// times go into log-linear buckets, 32 per power of two, so percentiles are within ~3% of the real value
+// min and max are exact
+
+#ifndef GTS_FRAMETIME_H
+#define GTS_FRAMETIME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FRAMETIME_SUB_BITS 5
+#define FRAMETIME_SUB_BUCKETS (1 << FRAMETIME_SUB_BITS)
+// values under FRAMETIME_SUB_BUCKETS get a bucket each, then 32 buckets for each power of two up to 2^31
+#define FRAMETIME_BUCKETS ((32 - FRAMETIME_SUB_BITS + 1) * FRAMETIME_SUB_BUCKETS)
+
+// times are in nanoseconds, so the same code works for the console's milliseconds and a pc's microseconds
+typedef struct FrameTimeStats {
+	uint32_t count;
+	uint32_t minNs;
+	uint32_t maxNs;
+	uint64_t totalNs;
+	uint32_t buckets[FRAMETIME_BUCKETS];
+} FrameTimeStats;
+
+void frameTime_reset(FrameTimeStats *stats);
+
+void frameTime_add(FrameTimeStats *stats, uint32_t ns);
+
+// percent is 0 to 100, returns 0 if nothing was added
+uint32_t frameTime_percentile(const FrameTimeStats *stats, uint32_t percent);
+
+uint32_t frameTime_meanNs(const FrameTimeStats *stats);
+
+// report lines, in microseconds, so the console and pc reports line up
+// both return what snprintf does
+int frameTime_formatHeader(char *buf, size_t len);
+int frameTime_formatRow(char *buf, size_t len, const char *name, const FrameTimeStats *stats);
+
+#endif //GTS_FRAMETIME_H
@@ -1,10 +0,0 @@
-//
-// Created on 2025/02/12.
-//
-
-#ifndef GTS_GECKO_H
-#define GTS_GECKO_H
-
-void sendMessage(char *msg);
-
-#endif //GTS_GECKO_H
@@ -0,0 +1,66 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "history.h"
+
+#define HISTORY_SLOTS (HISTORY_LEN + 1)
+
+static WaveformData slots[HISTORY_SLOTS];
+// slot history_begin hands out, the newest kept capture is the one before it
+static int next = 0;
+static int count = 0;
+static int age = 0;
+
+static int slotFor(int captureAge) {
+	return (next - 1 - captureAge + HISTORY_SLOTS) % HISTORY_SLOTS;
+}
+
+WaveformData *history_begin() {
+	WaveformData *slot = &slots[next];
+	slot->endPoint = 0;
+	slot->totalTimeUs = 0;
+	slot->isDataReady = false;
+	slot->fullMeasure = false;
+	slot->exported = false;
+	slot->testType = -1;
+	return slot;
+}
+
+void history_commit() {
+	next = (next + 1) % HISTORY_SLOTS;
+	if (count < HISTORY_LEN) {
+		count++;
+	}
+	age = 0;
+}
+
+void history_clear() {
+	for (int i = 0; i < HISTORY_SLOTS; i++) {
+		slots[i].isDataReady = false;
+	}
+	count = 0;
+	age = 0;
+}
+
+WaveformData *history_view() {
+	if (count == 0) {
+		return &slots[next];
+	}
+	return &slots[slotFor(age)];
+}
+
+void history_step(int amount) {
+	if (count == 0) {
+		return;
+	}
+	age = ((age + amount) % count + count) % count;
+}
+
+int history_age() {
+	return age;
+}
+
+int history_count() {
+	return count;
+}
@@ -0,0 +1,41 @@
+//
+// Created on 2026/10/18.
+//
+
+// the last few captures, kept so repeated attempts can be compared without exporting each one
+// captures live in a fixed arena of slots used as a ring, starting a capture hands out the slot after the newest,
+// so it's never more than an index bump, and the oldest capture is written over once they're all used
+// nothing is cleared when a slot is reused, only the header, everything reads up to endPoint anyway
+// there's one more slot than captures that can be looked at, so a capture being recorded never lands on one on screen
+
+#ifndef GTS_HISTORY_H
+#define GTS_HISTORY_H
+
+#include <stdbool.h>
+#include "waveform.h"
+
+#define HISTORY_LEN 10
+
+// the slot for the next capture, it isn't kept until history_commit is called
+// calling this again before then hands out the same slot
+WaveformData *history_begin();
+
+// keeps the capture from history_begin as the newest one, and goes to it
+void history_commit();
+
+// forgets every capture
+void history_clear();
+
+// the capture being looked at, never NULL
+// with nothing kept yet it's the slot the first capture goes into, which isn't ready
+WaveformData *history_view();
+
+// moves to an older capture with a positive amount, a newer one with a negative one, wrapping around
+void history_step(int amount);
+
+// how many captures back the one being looked at is, 0 for the newest
+int history_age();
+
+int history_count();
+
+#endif //GTS_HISTORY_H
@@ -0,0 +1,117 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "hitmap.h"
+#include <string.h>
+
+#define HITMAP_ONE (1u << HITMAP_FRAC_BITS)
+// log2 with this many fractional bits, for the color scale
+#define HITMAP_LOG_FRAC 4
+
+void hitmap_clear(HitMap *map) {
+	memset(map, 0, sizeof(HitMap));
+}
+
+void hitmap_add(HitMap *map, int8_t x, int8_t y) {
+	// flip y so row 0 is the top of the plot
+	uint32_t *cell = &map->hits[127 - y][x + 128];
+	if (*cell == 0) {
+		map->used++;
+	}
+	// a coordinate held for hours just stays at the top
+	if (*cell <= UINT32_MAX - HITMAP_ONE) {
+		*cell += HITMAP_ONE;
+	}
+	if (*cell > map->peak) {
+		map->peak = *cell;
+	}
+	map->samples++;
+}
+
+void hitmap_decay(HitMap *map, uint8_t shift) {
+	uint32_t peak = 0;
+	uint32_t used = 0;
+	uint32_t *cell = &map->hits[0][0];
+	for (int i = 0; i < HITMAP_SIZE * HITMAP_SIZE; i++, cell++) {
+		uint32_t count = *cell;
+		if (count == 0) {
+			continue;
+		}
+		uint32_t step = (count >> shift) + 1;
+		count = count > step ? count - step : 0;
+		*cell = count;
+		if (count != 0) {
+			used++;
+			if (count > peak) {
+				peak = count;
+			}
+		}
+	}
+	map->peak = peak;
+	map->used = used;
+}
+
+static uint32_t log2Fixed(uint32_t value) {
+	uint32_t msb = 31 - __builtin_clz(value);
+	uint32_t frac;
+	if (msb >= HITMAP_LOG_FRAC) {
+		frac = value >> (msb - HITMAP_LOG_FRAC);
+	} else {
+		frac = value << (HITMAP_LOG_FRAC - msb);
+	}
+	return (msb << HITMAP_LOG_FRAC) + (frac & ((1 << HITMAP_LOG_FRAC) - 1));
+}
+
+uint8_t hitmap_level(const HitMap *map, uint32_t count) {
+	if (count == 0) {
+		return 0;
+	}
+	// log2(1) is 0, so start one above it to keep the dimmest fractions visible
+	uint32_t top = log2Fixed(map->peak + 1);
+	if (top == 0) {
+		return HITMAP_LEVELS;
+	}
+	uint32_t level = 1 + ((log2Fixed(count + 1) * (HITMAP_LEVELS - 1)) / top);
+	return level > HITMAP_LEVELS ? HITMAP_LEVELS : level;
+}
+
+// two pixels of the same color, in the layout the framebuffer uses (Y Cb Y Cr)
+static uint32_t rgbToYCbCr(int r, int g, int b) {
+	int y = 16 + (((66 * r) + (129 * g) + (25 * b) + 128) >> 8);
+	int cb = 128 + (((-38 * r) - (74 * g) + (112 * b) + 128) >> 8);
+	int cr = 128 + (((112 * r) - (94 * g) - (18 * b) + 128) >> 8);
+	return ((uint32_t) y << 24) | ((uint32_t) cb << 16) | ((uint32_t) y << 8) | (uint32_t) cr;
+}
+
+void hitmap_buildPalette(uint32_t *palette, enum HITMAP_STYLE style) {
+	for (int i = 0; i < HITMAP_LEVELS; i++) {
+		// 0 to 255 across the palette
+		int t = (i * 255) / (HITMAP_LEVELS - 1);
+		int r, g, b;
+		switch (style) {
+			case HITMAP_HEAT:
+				// dark blue, red, yellow, then white
+				if (t < 85) {
+					r = t * 3;
+					g = 0;
+					b = 96 + (t / 2);
+				} else if (t < 170) {
+					r = 255;
+					g = (t - 85) * 3;
+					b = 138 - ((t - 85) * 138 / 85);
+				} else {
+					r = 255;
+					g = 255;
+					b = (t - 170) * 3;
+				}
+				break;
+			case HITMAP_INTENSITY:
+			default:
+				// starts above black so one hit is still visible
+				r = g = b = 48 + ((t * (255 - 48)) / 255);
+				break;
+		}
+		palette[i] = rgbToYCbCr(r, g, b);
+	}
+}
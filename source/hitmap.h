@@ -0,0 +1,51 @@
+//
+// Created on 2026/10/18.
+//
+
+// per-coordinate hit counts for the persistence (phosphor) plot
+// every stick value from -128 to 127 on both axes has a counter, so adding a sample is one increment
+// and drawing the plot costs the same no matter how many samples went in
+// counts are fixed point, so decay can fade a single hit out smoothly instead of dropping it at once
+
+#ifndef GTS_HITMAP_H
+#define GTS_HITMAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define HITMAP_SIZE 256
+// fractional bits in a count, one sample adds 1 << HITMAP_FRAC_BITS
+#define HITMAP_FRAC_BITS 8
+// colors in a palette, the brightest is used for the most hit coordinate
+#define HITMAP_LEVELS 32
+
+enum HITMAP_STYLE { HITMAP_INTENSITY, HITMAP_HEAT, HITMAP_STYLE_LEN };
+
+typedef struct HitMap {
+	// [y][x], with -128 at index 0
+	uint32_t hits[HITMAP_SIZE][HITMAP_SIZE];
+	// highest count anywhere, for scaling the colors
+	uint32_t peak;
+	// samples added since the last clear, not affected by decay
+	uint64_t samples;
+	// coordinates with a nonzero count
+	uint32_t used;
+} HitMap;
+
+void hitmap_clear(HitMap *map);
+
+// x and y are stick values, right and up are positive
+void hitmap_add(HitMap *map, int8_t x, int8_t y);
+
+// takes 1/2^shift off every count, plus the smallest step so nothing sticks around forever
+// this is the one operation that touches every coordinate
+void hitmap_decay(HitMap *map, uint8_t shift);
+
+// 0 for a coordinate that was never hit, otherwise 1 to HITMAP_LEVELS
+// the scale is logarithmic, so a few hits out at the gate still show up next to a center with thousands
+uint8_t hitmap_level(const HitMap *map, uint32_t count);
+
+// fills palette[HITMAP_LEVELS] with ycbcr words for the framebuffer, dimmest first
+void hitmap_buildPalette(uint32_t *palette, enum HITMAP_STYLE style);
+
+#endif //GTS_HITMAP_H
@@ -0,0 +1,71 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "input.h"
+#include <ogc/lwp_watchdog.h>
+
+// the producer only ever writes writeIndex, and the consumer only ever writes readIndex
+// both run on the same core, so volatile is enough to keep the ordering of the slot write and the index update
+static volatile InputEvent queue[INPUT_QUEUE_LEN];
+static volatile u32 writeIndex = 0;
+static volatile u32 readIndex = 0;
+
+// producer state
+static u16 prevHeld = 0;
+// presses that didn't fit in the queue, merged into the next event that does
+static u16 pendingDown = 0;
+static volatile u16 latestHeld = 0;
+static volatile u32 overflows = 0;
+
+void input_reset() {
+	prevHeld = PAD_ButtonsHeld(0);
+	pendingDown = 0;
+	latestHeld = prevHeld;
+	readIndex = writeIndex;
+}
+
+u16 input_update() {
+	u16 held = PAD_ButtonsHeld(0);
+	latestHeld = held;
+	if (held == prevHeld && pendingDown == 0) {
+		return held;
+	}
+
+	u16 down = (held & ~prevHeld) | pendingDown;
+	prevHeld = held;
+
+	u32 currWrite = writeIndex;
+	if (currWrite - readIndex >= INPUT_QUEUE_LEN) {
+		// queue is full, hold onto the presses until there's room again
+		pendingDown = down;
+		overflows++;
+		return held;
+	}
+	pendingDown = 0;
+	queue[currWrite & (INPUT_QUEUE_LEN - 1)].down = down;
+	queue[currWrite & (INPUT_QUEUE_LEN - 1)].held = held;
+	queue[currWrite & (INPUT_QUEUE_LEN - 1)].timeUs = ticks_to_microsecs(gettime());
+	writeIndex = currWrite + 1;
+
+	return held;
+}
+
+void input_drain(u32 *pressed, u32 *held) {
+	u32 currRead = readIndex;
+	u32 currWrite = writeIndex;
+	u32 down = 0;
+
+	while (currRead != currWrite) {
+		down |= queue[currRead & (INPUT_QUEUE_LEN - 1)].down;
+		currRead++;
+	}
+	readIndex = currRead;
+
+	*pressed = down;
+	*held = latestHeld;
+}
+
+u32 input_overflowCount() {
+	return overflows;
+}
@@ -0,0 +1,42 @@
+//
+// Created on 2026/10/18.
+//
+
+// queue of button state changes for port 1
+// whichever context is polling the pads (the main loop, or a sampling callback) pushes into it,
+// and the menu code drains it once per frame, so every press is seen exactly once
+
+#ifndef GTS_INPUT_H
+#define GTS_INPUT_H
+
+#include <gccore.h>
+
+// must be a power of two
+#define INPUT_QUEUE_LEN 256
+
+typedef struct InputEvent {
+	// buttons that went down since the previous event
+	u16 down;
+	// full held state when the event was recorded
+	u16 held;
+	// time the poll happened, in microseconds
+	u32 timeUs;
+} InputEvent;
+
+// reset the queue and take the current held state as the starting point
+void input_reset();
+
+// read the buttons from the last PAD_ScanPads and queue an event if they changed
+// only one context should be calling this at a time
+// returns the current held state
+u16 input_update();
+
+// combine everything queued since the last call
+// pressed gets every button that went down, held gets the newest held state
+void input_drain(u32 *pressed, u32 *held);
+
+// number of times the queue was full when a change came in
+// presses aren't lost when this happens, they get merged into the next event
+u32 input_overflowCount();
+
+#endif //GTS_INPUT_H
@@ -0,0 +1,295 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "logging.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdatomic.h>
+
+typedef struct LogSlot {
+	// set by the writer once the text is complete, cleared by the drain
+	atomic_bool ready;
+	enum LOG_LEVEL level;
+	uint32_t len;
+	char text[LOG_MSG_LEN];
+} LogSlot;
+
+typedef struct LogSink {
+	LogSinkWrite write;
+	LogSinkFlush flush;
+	void *ctx;
+	enum LOG_LEVEL minLevel;
+} LogSink;
+
+static LogSlot slots[LOG_SLOTS];
+// next slot to claim, and next slot to drain, both only ever count up
+static atomic_uint head = 0;
+static atomic_uint tail = 0;
+static atomic_uint dropped = 0;
+// drops the drain hasn't reported yet
+static uint32_t droppedReported = 0;
+
+static LogSink sinks[LOG_MAX_SINKS];
+static volatile uint32_t sinkCount = 0;
+
+bool log_addSink(LogSinkWrite write, LogSinkFlush flush, void *ctx, enum LOG_LEVEL minLevel) {
+	if (sinkCount == LOG_MAX_SINKS) {
+		return false;
+	}
+	sinks[sinkCount].write = write;
+	sinks[sinkCount].flush = flush;
+	sinks[sinkCount].ctx = ctx;
+	sinks[sinkCount].minLevel = minLevel;
+	sinkCount++;
+	return true;
+}
+
+void log_removeSinks() {
+	sinkCount = 0;
+}
+
+// writes into a message, anything past the end is cut off
+typedef struct LogText {
+	char *text;
+	uint32_t len;
+} LogText;
+
+static void putChar(LogText *out, char c) {
+	if (out->len < LOG_MSG_LEN - 1) {
+		out->text[out->len++] = c;
+	}
+}
+
+static void putPadded(LogText *out, const char *str, uint32_t len, uint32_t width, bool left, char pad) {
+	uint32_t padding = len < width ? width - len : 0;
+	if (!left) {
+		// zero padding goes after the sign
+		if (pad == '0' && len != 0 && str[0] == '-') {
+			putChar(out, '-');
+			str++;
+			len--;
+		}
+		for (uint32_t i = 0; i < padding; i++) {
+			putChar(out, pad);
+		}
+	}
+	for (uint32_t i = 0; i < len; i++) {
+		putChar(out, str[i]);
+	}
+	if (left) {
+		for (uint32_t i = 0; i < padding; i++) {
+			putChar(out, ' ');
+		}
+	}
+}
+
+// digits of value, right aligned in buf, returns where they start
+static char *putDigits(char *end, unsigned long long value, uint32_t base, bool upper) {
+	const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+	char *pos = end;
+	do {
+		*--pos = digits[value % base];
+		value /= base;
+	} while (value != 0);
+	return pos;
+}
+
+// the subset of printf the logs need, newlib's vsnprintf can take the reent lock or malloc,
+// which isn't safe from the sampling interrupt
+// knows %d %i %u %x %X %c %s %p %%, with the -, 0 and width flags and the hh, h, l, ll and z lengths
+// floats and anything else are copied into the message as written, so the arguments after them still line up
+static uint32_t format(char *text, const char *fmt, va_list args) {
+	LogText out = { text, 0 };
+	for (const char *c = fmt; *c != '\0'; c++) {
+		if (*c != '%') {
+			putChar(&out, *c);
+			continue;
+		}
+		const char *spec = c++;
+		bool left = false;
+		char pad = ' ';
+		for (; *c == '-' || *c == '0'; c++) {
+			if (*c == '-') {
+				left = true;
+			} else {
+				pad = '0';
+			}
+		}
+		uint32_t width = 0;
+		for (; *c >= '0' && *c <= '9'; c++) {
+			width = (width * 10) + (*c - '0');
+		}
+		// 0 is int, 1 is long, 2 is long long, 3 is size_t
+		int length = 0;
+		for (; *c == 'h' || *c == 'l' || *c == 'z'; c++) {
+			if (*c == 'l') {
+				length++;
+			} else if (*c == 'z') {
+				length = 3;
+			}
+		}
+
+		char buf[24];
+		char *end = buf + sizeof(buf);
+		switch (*c) {
+			case 'd':
+			case 'i': {
+				long long value = length == 0 ? va_arg(args, int) : length == 1 ? va_arg(args, long) :
+				                  length == 2 ? va_arg(args, long long) : (long long) va_arg(args, size_t);
+				// negated as unsigned, so the smallest value doesn't overflow
+				char *start = putDigits(end, value < 0 ? -(unsigned long long) value : (unsigned long long) value,
+				                        10, false);
+				if (value < 0) {
+					*--start = '-';
+				}
+				putPadded(&out, start, end - start, width, left, pad);
+				break;
+			}
+			case 'u':
+			case 'x':
+			case 'X': {
+				unsigned long long value = length == 0 ? va_arg(args, unsigned int) :
+				                           length == 1 ? va_arg(args, unsigned long) :
+				                           length == 2 ? va_arg(args, unsigned long long) : va_arg(args, size_t);
+				char *start = putDigits(end, value, *c == 'u' ? 10 : 16, *c == 'X');
+				putPadded(&out, start, end - start, width, left, pad);
+				break;
+			}
+			case 'p': {
+				char *start = putDigits(end, (uintptr_t) va_arg(args, void *), 16, false);
+				*--start = 'x';
+				*--start = '0';
+				putPadded(&out, start, end - start, width, left, ' ');
+				break;
+			}
+			case 'c':
+				buf[0] = (char) va_arg(args, int);
+				putPadded(&out, buf, 1, width, left, ' ');
+				break;
+			case 's': {
+				const char *str = va_arg(args, const char *);
+				if (str == NULL) {
+					str = "(null)";
+				}
+				uint32_t len = 0;
+				while (str[len] != '\0' && len < LOG_MSG_LEN) {
+					len++;
+				}
+				putPadded(&out, str, len, width, left, ' ');
+				break;
+			}
+			case '%':
+				putChar(&out, '%');
+				break;
+			case '\0':
+				c--;
+				// fall through
+			default:
+				if (*c == 'f' || *c == 'F' || *c == 'e' || *c == 'E' || *c == 'g' || *c == 'G' ||
+				    *c == 'a' || *c == 'A') {
+					(void) va_arg(args, double);
+				}
+				for (const char *copy = spec; copy <= c && *copy != '\0'; copy++) {
+					putChar(&out, *copy);
+				}
+				break;
+		}
+	}
+	out.text[out.len] = '\0';
+	return out.len;
+}
+
+bool log_write(enum LOG_LEVEL level, const char *fmt, ...) {
+	if (sinkCount == 0) {
+		return true;
+	}
+
+	// claim a slot, or give up if the drain is a full ring behind
+	unsigned int claimed = atomic_load_explicit(&head, memory_order_relaxed);
+	do {
+		if (claimed - atomic_load_explicit(&tail, memory_order_acquire) >= LOG_SLOTS) {
+			atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+			return false;
+		}
+	} while (!atomic_compare_exchange_weak_explicit(&head, &claimed, claimed + 1, memory_order_acq_rel,
+	                                                memory_order_relaxed));
+
+	LogSlot *slot = &slots[claimed & (LOG_SLOTS - 1)];
+	va_list args;
+	va_start(args, fmt);
+	// long messages are cut off
+	slot->len = format(slot->text, fmt, args);
+	va_end(args);
+	slot->level = level;
+	atomic_store_explicit(&slot->ready, true, memory_order_release);
+	return true;
+}
+
+static void sendToSinks(enum LOG_LEVEL level, const char *msg, uint32_t len) {
+	for (uint32_t i = 0; i < sinkCount; i++) {
+		if (level >= sinks[i].minLevel) {
+			sinks[i].write(sinks[i].ctx, level, msg, len);
+		}
+	}
+}
+
+uint32_t log_drain() {
+	uint32_t handled = 0;
+	unsigned int pos = atomic_load_explicit(&tail, memory_order_relaxed);
+	while (pos != atomic_load_explicit(&head, memory_order_acquire)) {
+		LogSlot *slot = &slots[pos & (LOG_SLOTS - 1)];
+		// claimed, but the writer hasn't finished, everything after it waits for the next drain
+		if (!atomic_load_explicit(&slot->ready, memory_order_acquire)) {
+			break;
+		}
+		sendToSinks(slot->level, slot->text, slot->len);
+		atomic_store_explicit(&slot->ready, false, memory_order_relaxed);
+		pos++;
+		atomic_store_explicit(&tail, pos, memory_order_release);
+		handled++;
+	}
+
+	bool wrote = handled != 0;
+	uint32_t droppedNow = atomic_load_explicit(&dropped, memory_order_relaxed);
+	if (droppedNow != droppedReported) {
+		char msg[64];
+		int len = snprintf(msg, sizeof(msg), "%u messages dropped, log ring was full",
+		                   (unsigned int) (droppedNow - droppedReported));
+		sendToSinks(LOG_LEVEL_WARN, msg, len);
+		droppedReported = droppedNow;
+		wrote = true;
+	}
+
+	if (wrote) {
+		for (uint32_t i = 0; i < sinkCount; i++) {
+			if (sinks[i].flush != NULL) {
+				sinks[i].flush(sinks[i].ctx);
+			}
+		}
+	}
+	return handled;
+}
+
+uint32_t log_droppedTotal() {
+	return atomic_load_explicit(&dropped, memory_order_relaxed);
+}
+
+char log_levelChar(enum LOG_LEVEL level) {
+	switch (level) {
+		case LOG_LEVEL_DEBUG:
+			return 'D';
+		case LOG_LEVEL_INFO:
+			return 'I';
+		case LOG_LEVEL_WARN:
+			return 'W';
+		case LOG_LEVEL_ERROR:
+			return 'E';
+		default:
+			return '?';
+	}
+}
+
+void log_stdoutSink(void *ctx, enum LOG_LEVEL level, const char *msg, uint32_t len) {
+	printf("[%c] %.*s\n", log_levelChar(level), (int) len, msg);
+}
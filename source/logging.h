@@ -0,0 +1,67 @@
+//
+// Created on 2026/10/18.
+//
+
+// leveled logging that never blocks the caller
+// messages are formatted straight into a fixed ring of slots, and something else drains them to the sinks later,
+// on the console that's a background thread (logthread.c), on a pc it can be called directly
+// writers claim slots with a compare-and-swap, so the main thread, other threads and interrupts can all log
+// formatting is done here instead of with newlib's printf, which can lock, so only integers, chars, strings
+// and pointers are formatted, floats are left in the message as written
+// if the ring is full, the message is dropped and counted, and the next drain reports how many were lost
+// the LOG_* macros only do something in DEBUGLOG builds (make debuglog), otherwise they compile to nothing
+
+#ifndef GTS_LOGGING_H
+#define GTS_LOGGING_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// needs to be a power of two
+#define LOG_SLOTS 64
+#define LOG_MSG_LEN 128
+#define LOG_MAX_SINKS 4
+
+enum LOG_LEVEL { LOG_LEVEL_DEBUG, LOG_LEVEL_INFO, LOG_LEVEL_WARN, LOG_LEVEL_ERROR };
+
+#ifdef DEBUGLOG
+#define LOG_DEBUG(...) log_write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) log_write(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) log_write(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) log_write(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void) 0)
+#define LOG_INFO(...) ((void) 0)
+#define LOG_WARN(...) ((void) 0)
+#define LOG_ERROR(...) ((void) 0)
+#endif
+
+// msg is a full line without the newline, len doesn't count the terminator
+typedef void (*LogSinkWrite)(void *ctx, enum LOG_LEVEL level, const char *msg, uint32_t len);
+// called once a drain has written everything it had, can be NULL
+typedef void (*LogSinkFlush)(void *ctx);
+
+// returns false if there's no room for another sink
+// messages below minLevel aren't sent to this sink
+bool log_addSink(LogSinkWrite write, LogSinkFlush flush, void *ctx, enum LOG_LEVEL minLevel);
+
+void log_removeSinks();
+
+// printf style (see format in logging.c for what's supported), returns false if the message was dropped
+// with no sinks added this returns right away without formatting anything
+bool log_write(enum LOG_LEVEL level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// hand every finished message to the sinks, returns the number handed over
+// only one thread should drain at a time
+uint32_t log_drain();
+
+// messages dropped because the ring was full, since the start
+uint32_t log_droppedTotal();
+
+// one letter for each level, for sinks that prefix lines
+char log_levelChar(enum LOG_LEVEL level);
+
+// writes to stdout, for running on a pc
+void log_stdoutSink(void *ctx, enum LOG_LEVEL level, const char *msg, uint32_t len);
+
+#endif //GTS_LOGGING_H
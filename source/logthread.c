@@ -0,0 +1,96 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "logthread.h"
+#include <stdio.h>
+#include <gccore.h>
+#include <fat.h>
+#include <ogc/lwp.h>
+#include <ogc/usbgecko.h>
+#include "logging.h"
+
+// below the menus, it only needs to keep up over a few frames
+#define LOG_THREAD_PRIORITY 40
+#define LOG_THREAD_STACK_SIZE (16 * 1024)
+
+static lwp_t logThread = LWP_THREAD_NULL;
+static lwpq_t logQueue = LWP_TQUEUE_NULL;
+static volatile bool logStop = false;
+static FILE *logFile = NULL;
+
+// a lot pulled from https://github.com/DacoTaco/priiloader/blob/master/src/priiloader/source/gecko.cpp
+static void geckoWrite(void *ctx, enum LOG_LEVEL level, const char *msg, uint32_t len) {
+	char prefix[4] = { '[', log_levelChar(level), ']', ' ' };
+	usb_sendbuffer(EXI_CHANNEL_1, prefix, sizeof(prefix));
+	usb_sendbuffer(EXI_CHANNEL_1, msg, len);
+	usb_sendbuffer(EXI_CHANNEL_1, "\n", 1);
+}
+
+static void geckoFlush(void *ctx) {
+	usb_flush(EXI_CHANNEL_1);
+}
+
+static void fileWrite(void *ctx, enum LOG_LEVEL level, const char *msg, uint32_t len) {
+	fprintf(ctx, "[%c] %.*s\n", log_levelChar(level), (int) len, msg);
+}
+
+static void fileFlush(void *ctx) {
+	fflush(ctx);
+}
+
+static void *logMain(void *arg) {
+	while (true) {
+		log_drain();
+		if (logStop) {
+			break;
+		}
+		// kicked every frame, so a missed wakeup only costs a frame
+		LWP_ThreadSleep(logQueue);
+	}
+	// anything logged while stopping
+	log_drain();
+	return NULL;
+}
+
+void logThread_start() {
+	if (logThread != LWP_THREAD_NULL) {
+		return;
+	}
+	if (usb_isgeckoalive(EXI_CHANNEL_1)) {
+		usb_flush(EXI_CHANNEL_1);
+		log_addSink(geckoWrite, geckoFlush, NULL, LOG_LEVEL_DEBUG);
+	}
+	if (fatInitDefault()) {
+		logFile = fopen(LOG_FILE_PATH, "a");
+		if (logFile != NULL) {
+			log_addSink(fileWrite, fileFlush, logFile, LOG_LEVEL_INFO);
+		}
+	}
+	logStop = false;
+	LWP_InitQueue(&logQueue);
+	LWP_CreateThread(&logThread, logMain, NULL, NULL, LOG_THREAD_STACK_SIZE, LOG_THREAD_PRIORITY);
+}
+
+void logThread_kick() {
+	if (logThread != LWP_THREAD_NULL) {
+		LWP_ThreadSignal(logQueue);
+	}
+}
+
+void logThread_stop() {
+	if (logThread == LWP_THREAD_NULL) {
+		return;
+	}
+	logStop = true;
+	LWP_ThreadSignal(logQueue);
+	LWP_JoinThread(logThread, NULL);
+	LWP_CloseQueue(logQueue);
+	logThread = LWP_THREAD_NULL;
+	logQueue = LWP_TQUEUE_NULL;
+	log_removeSinks();
+	if (logFile != NULL) {
+		fclose(logFile);
+		logFile = NULL;
+	}
+}
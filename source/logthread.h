@@ -0,0 +1,22 @@
+//
+// Created on 2026/10/18.
+//
+
+// drains logging.c's ring from a background thread, to the usb gecko and a file on the sd card
+// nothing here runs on the caller's path, so a slow gecko or card never holds up the menus or polling
+
+#ifndef GTS_LOGTHREAD_H
+#define GTS_LOGTHREAD_H
+
+#define LOG_FILE_PATH "/GTS/log.txt"
+
+// adds the gecko sink if one is plugged into slot b, the sd sink if the card mounts, then starts the thread
+void logThread_start();
+
+// wake the thread, the main loop calls this once a frame
+void logThread_kick();
+
+// drain whatever is left and stop the thread
+void logThread_stop();
+
+#endif //GTS_LOGTHREAD_H
@@ -4,19 +4,31 @@
 #include <ogc/video.h>
 #include <ogc/lwp_watchdog.h>
 #include "menu.h"
-#include "gecko.h"
+#include "logging.h"
 #include "polling.h"
 #include "print.h"
+#include "input.h"
+#include "profiler.h"
 
 
 #ifdef DEBUGLOG
-#include <ogc/lwp_watchdog.h>
+#include "logthread.h"
 #endif
 
 #ifdef DEBUGGDB
 #include <debug.h>
 #endif
 
+#ifdef PROFILE
+#include <fat.h>
+#endif
+
+#ifdef SESSION
+#include <fat.h>
+#include "sessionpad.h"
+#include "frametime.h"
+#endif
+
 // basic stuff from the template
 static void *xfb1 = NULL;
 static void *xfb2 = NULL;
@@ -27,8 +39,39 @@ static VIRetraceCallback cb;
 
 void retraceCallback() {
 	setSamplingRate();
+	#ifdef SESSION
+	sessionPad_onRetrace();
+	#endif
 }
 
+#ifdef SESSION
+// per menu, only filled while replaying
+static FrameTimeStats menuTimes[ERR + 1];
+static char sessionReport[(ERR + 2) * 64];
+static const char *sessionStatus = "";
+
+// build the replay report, and save it next to the session
+static void finishReplay() {
+	int len = frameTime_formatHeader(sessionReport, sizeof(sessionReport));
+	for (int i = 0; i <= ERR && len < sizeof(sessionReport); i++) {
+		if (menuTimes[i].count != 0) {
+			len += frameTime_formatRow(sessionReport + len, sizeof(sessionReport) - len, menu_getMenuName(i),
+			                           &menuTimes[i]);
+		}
+	}
+	sessionStatus = "Couldn't write " SESSION_REPORT_PATH;
+	if (fatInitDefault()) {
+		FILE *fptr = fopen(SESSION_REPORT_PATH, "w");
+		if (fptr != NULL) {
+			fputs(sessionReport, fptr);
+			if (fclose(fptr) == 0) {
+				sessionStatus = "Saved to " SESSION_REPORT_PATH;
+			}
+		}
+	}
+}
+#endif
+
 #if defined(HW_RVL)
 static bool powerButtonPressed = false;
 void powerButtonCallback() {
@@ -52,6 +95,7 @@ int main(int argc, char **argv) {
 	VIDEO_Init();
 	PAD_Init();
 	PAD_ScanPads();
+	input_reset();
 
 	rmode = VIDEO_GetPreferredMode(NULL);
 
@@ -86,11 +130,12 @@ int main(int argc, char **argv) {
 	
 	// there is a makefile target that will enable this
 	#ifdef DEBUGLOG
-	sendMessage("USB Gecko Debug output enabled");
+	logThread_start();
+	LOG_INFO("Debug output enabled");
 	#ifdef HW_RVL
-	sendMessage("Running on Wii");
+	LOG_INFO("Running on Wii");
 	#elifdef HW_DOL
-	sendMessage("Running on GC");
+	LOG_INFO("Running on GC");
 	#endif
 	#endif
 	
@@ -160,22 +205,20 @@ int main(int argc, char **argv) {
 	int us = 0;
 	#endif
 	
+	#ifdef SESSION
+	bool replayReportShown = false;
+	#endif
+	
 	switch (VIDEO_GetCurrentTvMode()) {
 		case VI_NTSC:
 		case VI_EURGB60:
-			#ifdef DEBUGLOG
-			sendMessage("Video mode is NTSC/EURGB60");
-			#endif
+			LOG_INFO("Video mode is NTSC/EURGB60");
 			break;
 		case VI_MPAL: // no idea if this should be a supported mode...
-			#ifdef DEBUGLOG
-			sendMessage("Video mode is MPAL");
-			#endif
+			LOG_INFO("Video mode is MPAL");
 			break;
 		case VI_PAL:
-			#ifdef DEBUGLOG
-			sendMessage("Video mode is PAL");
-			#endif
+			LOG_WARN("Video mode is PAL");
 		default:
 			VIDEO_SetNextFramebuffer(xfb2);
 			VIDEO_Flush();
@@ -202,6 +245,41 @@ int main(int argc, char **argv) {
 		return 0;
 	}
 	
+	// there is a makefile target that will enable this
+	// hold Z while booting to replay the last session, otherwise this session is recorded
+	#ifdef SESSION
+	for (int i = 0; i < 3; i++) {
+		PAD_ScanPads();
+		VIDEO_WaitVSync();
+	}
+	PAD_ScanPads();
+	int sessionRet;
+	if (PAD_ButtonsHeld(0) & PAD_TRIGGER_Z) {
+		sessionRet = fatInitDefault() ? sessionPad_startReplay(SESSION_PATH) : 1;
+		switch (sessionRet) {
+			case 0:
+				break;
+			case 1:
+				sessionStatus = "Couldn't open " SESSION_PATH;
+				break;
+			case 2:
+				sessionStatus = SESSION_PATH " isn't a session";
+				break;
+			case 3:
+				sessionStatus = "Session was recorded in another scan mode";
+				break;
+			default:
+				sessionStatus = "Not enough memory for the session";
+				break;
+		}
+	} else if (sessionPad_startRecording() != 0) {
+		sessionStatus = "Not enough memory to record";
+	}
+	for (int i = 0; i <= ERR; i++) {
+		frameTime_reset(&menuTimes[i]);
+	}
+	#endif
+	
 	// main loop of the program
 	while (true) {
 		#if defined(HW_RVL)
@@ -232,7 +310,36 @@ int main(int argc, char **argv) {
 		}
 
 		// run menu
+		#ifdef SESSION
+		if (sessionPad_replayFinished()) {
+			if (!replayReportShown) {
+				finishReplay();
+				replayReportShown = true;
+			}
+			// the controller is live again, start leaves
+			PAD_ScanPads();
+			resetCursor();
+			printStr("Replay finished\n\n", currXfb);
+			printStr(sessionReport, currXfb);
+			printStr("\n", currXfb);
+			printStr(sessionStatus, currXfb);
+			printStr("\nPress Start to exit", currXfb);
+			shouldExit = (PAD_ButtonsDown(0) & PAD_BUTTON_START);
+		} else {
+			enum CURRENT_MENU sessionMenu = menu_getCurrentMenu();
+			u64 sessionStart = gettime();
+			PROFILE_BEGIN(PROFILE_MENU);
+			shouldExit = menu_runMenu(currXfb);
+			PROFILE_END(PROFILE_MENU);
+			if (sessionPad_isReplaying()) {
+				frameTime_add(&menuTimes[sessionMenu], ticks_to_nanosecs(gettime() - sessionStart));
+			}
+		}
+		#else
+		PROFILE_BEGIN(PROFILE_MENU);
 		shouldExit = menu_runMenu(currXfb);
+		PROFILE_END(PROFILE_MENU);
+		#endif
 
 		// change framebuffer for next frame
 		if (xfbSwitch) {
@@ -251,6 +358,32 @@ int main(int argc, char **argv) {
 		printStrColor(msg, currXfb, COLOR_WHITE, COLOR_BLACK);
 		#endif
 		
+		#ifdef PROFILE
+		profile_endFrame();
+		profile_drawOverlay(currXfb);
+		// the last PROFILE_RING_FRAMES frames are saved on the way out
+		if ((shouldExit || SYS_ResetButtonDown()) && fatInitDefault()) {
+			profile_dump(PROFILE_PATH);
+		}
+		#endif
+		
+		#ifdef SESSION
+		if (!sessionPad_replayFinished()) {
+			const char *sessionTag = sessionStatus;
+			if (sessionPad_isRecording()) {
+				sessionTag = sessionPad_isFull() ? "REC FULL" : "REC";
+			} else if (sessionPad_isReplaying()) {
+				sessionTag = "REPLAY";
+			}
+			setCursorPos(22, 0);
+			printStrColor(sessionTag, currXfb, COLOR_WHITE, COLOR_BLACK);
+		}
+		// the recording is saved on the way out
+		if ((shouldExit || SYS_ResetButtonDown()) && sessionPad_isRecording() && fatInitDefault()) {
+			sessionPad_save(SESSION_PATH);
+		}
+		#endif
+		
 		
 		if (SYS_ResetButtonDown()) {
 			VIDEO_ClearFrameBuffer(rmode, currXfb, COLOR_BLACK);
@@ -261,10 +394,18 @@ int main(int argc, char **argv) {
 			break;
 		}
 
+		#ifdef DEBUGLOG
+		logThread_kick();
+		#endif
+
 		// Wait for the next frame
 		VIDEO_Flush();
 		VIDEO_WaitVSync();
 	}
+	
+	#ifdef DEBUGLOG
+	logThread_stop();
+	#endif
 
 	return 0;
 }
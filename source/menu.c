@@ -13,17 +13,28 @@
 #include "images/stickmaps.h"
 #include "draw.h"
 #include "print.h"
+#include "input.h"
 #include "file/file.h"
 #include "stickmap_coordinates.h"
+#include "analysis/analysis.h"
+#include "analysis/reference.h"
+#include "history.h"
+#include "hitmap.h"
+#include "coordtracker.h"
 
 #include "oscilloscope/oscilloscope.h"
 #include "oscilloscope/continuous.h"
+#include "oscilloscope/trigger.h"
+#include "oscilloscope/timeline.h"
+#include "oscilloscope/soak.h"
+#include "oscilloscope/record.h"
+#include "oscilloscope/phosphor.h"
 
 #ifndef VERSION_NUMBER
 #define VERSION_NUMBER "NOVERS_DEV"
 #endif
 
-#define MENUITEMS_LEN 6
+#define MENUITEMS_LEN 12
 #define TEST_LEN 5
 
 // 500 values displayed at once, SCREEN_POS_CENTER_X +/- 250
@@ -52,6 +63,8 @@ static int map2dStartIndex = 0;
 static enum STICKMAP_LIST selectedStickmap = NONE;
 // will be casted to whichever stickmap is selected
 static int selectedStickmapSub = 0;
+// colors for the coordinate viewer's hit overlay
+static u32 trackerPalette[HITMAP_LEVELS];
 
 // main menu counter
 static u8 mainMenuSelection = 0;
@@ -59,8 +72,10 @@ static u8 mainMenuSelection = 0;
 // counter for how many frames b or start have been held
 static u8 bHeldCounter = 0;
 
-// data for drawing a waveform
-static WaveformData data = { {{ 0 }}, 0, 500, false, false };
+// data for drawing a waveform, whichever capture in the history is being looked at
+static WaveformData *data = NULL;
+// the capture the scroll positions and export result below belong to
+static WaveformData *shownData = NULL;
 
 // vars for what buttons are pressed or held
 static u32 pressed = 0;
@@ -72,7 +87,9 @@ static u8 stickheld = 0;
 // menu item strings
 //static const char* menuItems[MENUITEMS_LEN] = { "Controller Test", "Stick Oscilloscope", "Coordinate Viewer", "2D Plot", "Export Data", "Continuous Waveform" };
 static const char* menuItems[MENUITEMS_LEN] = { "Controller Test", "Stick Oscilloscope", "Continuous Oscilloscope",
-                                                "Coordinate Viewer", "2D Plot", "Export Data"};
+                                                "Trigger Oscilloscope", "Button Timeline", "Soak Test", "SD Recorder",
+                                                "Coordinate Viewer", "2D Plot", "Export Data", "Import Data",
+                                                "Stick Persistence"};
 
 
 static bool displayedWaitingInputMessage = false;
@@ -84,6 +101,28 @@ static int dataScrollOffset = 0;
 
 static int exportReturnCode = -1;
 
+// capture browser, reads /GTS/index.bin instead of opening every capture
+#define IMPORT_LIST_ROWS 12
+static CaptureIndex captureIndex;
+// entries that pass the filter, in sorted order
+static u16 importView[INDEX_MAX_ENTRIES];
+static int importCount = 0;
+// the list is read on the frame after "Reading..." is drawn, since it can take a while
+static bool importListRead = false;
+static bool importListWaiting = false;
+static int importListReturnCode = 0;
+static int importSelection = 0;
+static int importReturnCode = -1;
+static u64 importTimeUs = 0;
+// the last capture loaded went to the reference instead of the main buffer
+static bool importedReference = false;
+static enum INDEX_SORT importSort = INDEX_SORT_NEWEST;
+static const char *importSortNames[] = { "Newest", "Oldest", "Samples", "Duration" };
+// 0 shows everything, then one per test type, then captures with no known test
+static int importFilter = 0;
+static const char *importFilterNames[] = { "All", "Snapback", "Pivot", "Dashback", "None", "Unknown" };
+#define IMPORT_FILTER_LEN 6
+
 static u32 padsConnected = 0;
 
 static PADStatus origin[PAD_CHANMAX];
@@ -121,24 +160,41 @@ bool menu_runMenu(void *currXfb) {
 	if ((padsConnected & 1) == 0) {
 		setCursorPos(0, 38);
 		printStr("Controller Disconnected!", currXfb);
-		data.isDataReady = false;
+		history_clear();
 		originRead = false;
 	}
 	
-	if (data.isDataReady) {
+	// anything pointing into the last capture shown doesn't apply to a different one
+	data = history_view();
+	if (data != shownData) {
+		shownData = data;
+		dataScrollOffset = 0;
+		lastDrawPoint = -1;
+		map2dStartIndex = 0;
+		exportReturnCode = -1;
+	}
+	
+	if (data->isDataReady) {
 		setCursorPos(0, 31);
-		printStr("Oscilloscope Capture in memory!", currXfb);
+		if (history_count() > 1) {
+			sprintf(strBuffer, "Capture %d of %d in memory!", history_age() + 1, history_count());
+			printStr(strBuffer, currXfb);
+		} else {
+			printStr("Oscilloscope Capture in memory!", currXfb);
+		}
 	} else {
 		exportReturnCode = -1;
 	}
 	setCursorPos(2, 0);
 	
 	// check for any buttons pressed/held
-	// don't update if we are on a menu with its own callback
-	if (currentMenu != WAVEFORM && currentMenu != CONTINUOUS_WAVEFORM) {
-		pressed = PAD_ButtonsDown(0);
-		held = PAD_ButtonsHeld(0);
+	// menus with their own callback queue inputs from there, so only poll here if we aren't in one
+	if (currentMenu != WAVEFORM && currentMenu != CONTINUOUS_WAVEFORM && currentMenu != TRIGGER_WAVEFORM &&
+	    currentMenu != BUTTON_TIMELINE && currentMenu != SOAK_TEST && currentMenu != RECORDER &&
+	    currentMenu != PHOSPHOR_PLOT && !(currentMenu == COORD_MAP && coordTracker_isRunning())) {
+		input_update();
 	}
+	input_drain(&pressed, &held);
 
 	// determine what menu we are in
 	switch (currentMenu) {
@@ -149,7 +205,7 @@ bool menu_runMenu(void *currXfb) {
 			menu_controllerTest(currXfb);
 			break;
 		case WAVEFORM:
-			menu_oscilloscope(currXfb, &data, &pressed, &held);
+			menu_oscilloscope(currXfb, data, &pressed, &held);
 			break;
 		case PLOT_2D:
 			if (displayInstructions) {
@@ -157,7 +213,8 @@ bool menu_runMenu(void *currXfb) {
 					   "what the last point drawn is.\nInformation on the last chosen point is "
 					   "displayed\nat the bottom. Hold R to add or remove points faster.\n"
 					   "Hold L to move one point at a time.\n\nHold Y to move the \"starting sample\" with the\n"
-					   "same controls as above. Information for the selected\nrange is shown on the left.", currXfb);
+					   "same controls as above. Information for the selected\nrange is shown on the left.\n\n"
+					   "Press Start to go back through the last 10 captures,\nhold R to go forward.", currXfb);
 			} else {
 				menu_2dPlot(currXfb);
 			}
@@ -165,6 +222,9 @@ bool menu_runMenu(void *currXfb) {
 		case FILE_EXPORT:
 			menu_fileExport(currXfb);
 			break;
+		case FILE_IMPORT:
+			menu_fileImport(currXfb);
+			break;
 		case WAITING_MEASURE:
 			menu_waitingMeasure(currXfb);
 			break;
@@ -173,7 +233,8 @@ bool menu_runMenu(void *currXfb) {
 				printStr("Press X to cycle the stickmap being tested, and Y to cycle\nwhich "
 					   "category of points.\nMelee Coordinates are shown in thetop-left.\n\n"
 					   "The white line represents the analog stick.\n"
-					   "The yellow line represents the c-stick.\n\n"
+					   "The yellow line represents the c-stick.\n"
+					   "Press A to track every poll against the stickmap, hits are\nshown on the map.\n\n"
 					   "Current Stickmap: ", currXfb);
 				switch (selectedStickmap) {
 					case FF_WD:
@@ -196,6 +257,21 @@ bool menu_runMenu(void *currXfb) {
 		case CONTINUOUS_WAVEFORM:
 			menu_continuousWaveform(currXfb, &pressed, &held);
 			break;
+		case TRIGGER_WAVEFORM:
+			menu_triggerOscilloscope(currXfb, &pressed, &held);
+			break;
+		case BUTTON_TIMELINE:
+			menu_buttonTimeline(currXfb, &pressed, &held);
+			break;
+		case SOAK_TEST:
+			menu_soakTest(currXfb, &pressed, &held);
+			break;
+		case RECORDER:
+			menu_recorder(currXfb, &pressed, &held);
+			break;
+		case PHOSPHOR_PLOT:
+			menu_phosphorPlot(currXfb, &pressed, &held);
+			break;
 		default:
 			printStr("HOW DID WE END UP HERE?\n", currXfb);
 			break;
@@ -280,6 +356,28 @@ bool menu_runMenu(void *currXfb) {
 				case CONTINUOUS_WAVEFORM:
 					menu_continuousEnd();
 					break;
+				case TRIGGER_WAVEFORM:
+					menu_triggerOscilloscopeEnd();
+					break;
+				case BUTTON_TIMELINE:
+					menu_buttonTimelineEnd();
+					break;
+				case SOAK_TEST:
+					menu_soakTestEnd();
+					break;
+				case RECORDER:
+					menu_recorderEnd();
+					break;
+				case PHOSPHOR_PLOT:
+					menu_phosphorPlotEnd();
+					break;
+				case COORD_MAP:
+					coordTracker_stop();
+					break;
+				case FILE_IMPORT:
+					// read the list again next time, in case the card changed
+					importListRead = false;
+					break;
 				default:
 					break;
 			}
@@ -325,6 +423,23 @@ bool menu_runMenu(void *currXfb) {
 	return false;
 }
 
+enum CURRENT_MENU menu_getCurrentMenu() {
+	return currentMenu;
+}
+
+// names for enum CURRENT_MENU, in order
+static const char *MENU_NAMES[] = { "main", "controller_test", "oscilloscope", "2d_plot", "image_test", "export",
+                                    "waiting_measure", "coordinate_viewer", "continuous", "trigger", "button_timeline",
+                                    "soak_test", "recorder", "import", "phosphor", "err" };
+_Static_assert(sizeof(MENU_NAMES) / sizeof(MENU_NAMES[0]) == ERR + 1, "MENU_NAMES needs to match enum CURRENT_MENU");
+
+const char *menu_getMenuName(enum CURRENT_MENU menu) {
+	if (menu > ERR) {
+		return "unknown";
+	}
+	return MENU_NAMES[menu];
+}
+
 void menu_mainMenu(void *currXfb) {
 	int stickY = PAD_StickY(0);
 
@@ -377,14 +492,32 @@ void menu_mainMenu(void *currXfb) {
 				currentMenu = CONTINUOUS_WAVEFORM;
 				break;
 			case 3:
-				currentMenu = COORD_MAP;
+				currentMenu = TRIGGER_WAVEFORM;
 				break;
 			case 4:
-				currentMenu = PLOT_2D;
+				currentMenu = BUTTON_TIMELINE;
 				break;
 			case 5:
+				currentMenu = SOAK_TEST;
+				break;
+			case 6:
+				currentMenu = RECORDER;
+				break;
+			case 7:
+				currentMenu = COORD_MAP;
+				break;
+			case 8:
+				currentMenu = PLOT_2D;
+				break;
+			case 9:
 				currentMenu = FILE_EXPORT;
 				break;
+			case 10:
+				currentMenu = FILE_IMPORT;
+				break;
+			case 11:
+				currentMenu = PHOSPHOR_PLOT;
+				break;
 		}
 	}
 
@@ -732,15 +865,15 @@ void menu_2dPlot(void *currXfb) {
 	printStr("Press A to start read, press Z for instructions", currXfb);
 
 	// do we have data that we can display?
-	if (data.isDataReady) {
-		if (lastDrawPoint == -1) {
-			lastDrawPoint = data.endPoint - 1;
+	if (data->isDataReady) {
+		if (lastDrawPoint == -1 || lastDrawPoint >= (int) data->endPoint) {
+			lastDrawPoint = data->endPoint - 1;
 		}
-		convertedCoords = convertStickValues(&data.data[lastDrawPoint]);
+		convertedCoords = convertStickValues(&data->data[lastDrawPoint]);
 		// TODO: move instructions under different prompt, so I don't have to keep messing with text placement
 		
 		setCursorPos(5, 0);
-		sprintf(strBuffer, "Total samples: %04u\n", data.endPoint);
+		sprintf(strBuffer, "Total samples: %04u\n", data->endPoint);
 		printStr(strBuffer, currXfb);
 		sprintf(strBuffer, "Start sample: %04u\n", map2dStartIndex + 1);
 		printStr(strBuffer, currXfb);
@@ -749,7 +882,7 @@ void menu_2dPlot(void *currXfb) {
 		
 		u64 timeFromStart = 0;
 		for (int i = map2dStartIndex + 1; i <= lastDrawPoint; i++) {
-			timeFromStart += data.data[i].timeDiffUs;
+			timeFromStart += data->data[i].timeDiffUs;
 		}
 		float timeFromStartMs = timeFromStart / 1000.0;
 		sprintf(strBuffer, "Total MS: %6.2f\n", timeFromStartMs);
@@ -760,11 +893,11 @@ void menu_2dPlot(void *currXfb) {
 		// print coordinates of last drawn point
 		// raw stick coordinates
 		setCursorPos(19, 0);
-		sprintf(strBuffer, "Raw XY: (%04d,%04d)\n", data.data[lastDrawPoint].ax, data.data[lastDrawPoint].ay);
+		sprintf(strBuffer, "Raw XY: (%04d,%04d)\n", data->data[lastDrawPoint].ax, data->data[lastDrawPoint].ay);
 		printStr(strBuffer, currXfb);
 		printStr("Melee XY: (", currXfb);
 		// is the value negative?
-		if (data.data[lastDrawPoint].ax < 0) {
+		if (data->data[lastDrawPoint].ax < 0) {
 			printStr("-", currXfb);
 		} else {
 			printStr("0", currXfb);
@@ -779,7 +912,7 @@ void menu_2dPlot(void *currXfb) {
 		printStr(",", currXfb);
 		
 		// is the value negative?
-		if (data.data[lastDrawPoint].ay < 0) {
+		if (data->data[lastDrawPoint].ay < 0) {
 			printStr("-", currXfb);
 		} else {
 			printStr("0", currXfb);
@@ -832,14 +965,24 @@ void menu_2dPlot(void *currXfb) {
 				COLOR_WHITE, currXfb);
 		
 		
+		// the pinned reference goes under the capture
+		const WaveformData *ref = reference_get();
+		if (ref != NULL) {
+			for (int i = 0; i < ref->endPoint; i++) {
+				DrawDot(COORD_CIRCLE_CENTER_X + ref->data[i].ax, SCREEN_POS_CENTER_Y - ref->data[i].ay, COLOR_TEAL, currXfb);
+			}
+			setCursorPos(11, 0);
+			printStr("Reference in teal", currXfb);
+		}
+
 		// draw plot
 		// y is negated because of how the graph is drawn
 		// TODO: why does this need to be <= to avoid an off-by-one? step through logic later this is bugging me
 		for (int i = 0; i <= lastDrawPoint; i++) {
 			if (i >= map2dStartIndex) {
-				DrawDot(COORD_CIRCLE_CENTER_X + data.data[i].ax, SCREEN_POS_CENTER_Y - data.data[i].ay, COLOR_WHITE, currXfb);
+				DrawDot(COORD_CIRCLE_CENTER_X + data->data[i].ax, SCREEN_POS_CENTER_Y - data->data[i].ay, COLOR_WHITE, currXfb);
 			} else {
-				DrawDot(COORD_CIRCLE_CENTER_X + data.data[i].ax, SCREEN_POS_CENTER_Y - data.data[i].ay, COLOR_GRAY, currXfb);
+				DrawDot(COORD_CIRCLE_CENTER_X + data->data[i].ax, SCREEN_POS_CENTER_Y - data->data[i].ay, COLOR_GRAY, currXfb);
 			}
 		}
 
@@ -855,10 +998,10 @@ void menu_2dPlot(void *currXfb) {
 						map2dStartIndex = lastDrawPoint;
 					}
 				} else {
-					if (lastDrawPoint + 1 < data.endPoint) {
+					if (lastDrawPoint + 1 < data->endPoint) {
 						lastDrawPoint++;
 					} else {
-						lastDrawPoint = data.endPoint - 1;
+						lastDrawPoint = data->endPoint - 1;
 					}
 				}
 			} else if (pressed & PAD_BUTTON_LEFT) {
@@ -881,10 +1024,10 @@ void menu_2dPlot(void *currXfb) {
 						map2dStartIndex = lastDrawPoint;
 					}
 				} else {
-					if (lastDrawPoint + 5 < data.endPoint) {
+					if (lastDrawPoint + 5 < data->endPoint) {
 						lastDrawPoint += 5;
 					} else {
-						lastDrawPoint = data.endPoint - 1;
+						lastDrawPoint = data->endPoint - 1;
 					}
 				}
 			} else {
@@ -893,7 +1036,7 @@ void menu_2dPlot(void *currXfb) {
 						map2dStartIndex++;
 					}
 				} else {
-					if (lastDrawPoint + 1 < data.endPoint) {
+					if (lastDrawPoint + 1 < data->endPoint) {
 						lastDrawPoint++;
 					}
 				}
@@ -940,12 +1083,16 @@ void menu_2dPlot(void *currXfb) {
 				selectedImage = NO_IMAGE;
 			}
 		}
+
+		// older captures with start, newer ones with R held
+		if (pressed & PAD_BUTTON_START) {
+			history_step((held & PAD_TRIGGER_R) ? -1 : 1);
+		}
 	}
 
 	// only start reading if A is pressed
 	// TODO: figure out if this can be removed without having to gut the current poll logic, would be better for the user to not have to do this
 	if (pressed & PAD_BUTTON_A) {
-		data.fullMeasure = false;
 		previousMenu = PLOT_2D;
 		currentMenu = WAITING_MEASURE;
 	}
@@ -954,8 +1101,8 @@ void menu_2dPlot(void *currXfb) {
 void menu_fileExport(void *currXfb) {
 	// run if we have a result
 	//if (exportReturnCode >= 0) {
-	if (data.isDataReady) {
-		if (data.exported) {
+	if (data->isDataReady) {
+		if (data->exported) {
 			switch (exportReturnCode) {
 				case 0:
 					printStr("File exported successfully.", currXfb);
@@ -978,13 +1125,172 @@ void menu_fileExport(void *currXfb) {
 			}
 		} else {
 			printStr("Attempting to export data...", currXfb);
-			exportReturnCode = exportData(&data);
+			exportReturnCode = exportData(data);
 		}
 	} else {
 		printStr("No data to export, record an input first.", currXfb);
 	}
 }
 
+// rebuild the filtered view after the index or filter changes
+static void filterCaptureIndex() {
+	index_sort(&captureIndex, importSort);
+	importCount = 0;
+	for (int i = 0; i < captureIndex.count; i++) {
+		int testType = captureIndex.entries[i].testType;
+		bool show;
+		if (importFilter == 0) {
+			show = true;
+		} else if (importFilter == IMPORT_FILTER_LEN - 1) {
+			show = testType < 0 || testType > NO_TEST;
+		} else {
+			show = testType == importFilter - 1;
+		}
+		if (show) {
+			importView[importCount] = i;
+			importCount++;
+		}
+	}
+	if (importSelection >= importCount) {
+		importSelection = importCount == 0 ? 0 : importCount - 1;
+	}
+}
+
+void menu_fileImport(void *currXfb) {
+	if (!importListRead) {
+		// draw first, reading (and possibly rebuilding) can take a few seconds
+		if (!importListWaiting) {
+			printStr("Reading capture index...", currXfb);
+			importListWaiting = true;
+			return;
+		}
+		importListReturnCode = loadCaptureIndex(&captureIndex);
+		// captures exported before the index existed, or the index was deleted
+		if (importListReturnCode != 2 && captureIndex.count == 0) {
+			importListReturnCode = rebuildCaptureIndex(&captureIndex);
+		}
+		importSelection = 0;
+		importReturnCode = -1;
+		filterCaptureIndex();
+		importListWaiting = false;
+		importListRead = true;
+	}
+	
+	if (importListReturnCode == 2) {
+		printStr("Failed to init filesystem.", currXfb);
+		return;
+	}
+	
+	switch (importReturnCode) {
+		case -1:
+			if (importListReturnCode != 0) {
+				sprintf(strBuffer, "Index could not be read (error %d), press Z to rebuild.", importListReturnCode);
+				printStr(strBuffer, currXfb);
+			} else {
+				printStr("Select a capture and press A to load it.", currXfb);
+			}
+			break;
+		case 0:
+			if (importedReference) {
+				sprintf(strBuffer, "Loaded %u samples as the reference in %llu ms.", reference_get()->endPoint, importTimeUs / 1000);
+			} else {
+				sprintf(strBuffer, "Loaded %u samples in %llu ms.", data->endPoint, importTimeUs / 1000);
+			}
+			printStr(strBuffer, currXfb);
+			break;
+		case 1:
+			printStr("Failed to read capture, the file is malformed.", currXfb);
+			break;
+		case 2:
+			printStr("Failed to open file.", currXfb);
+			break;
+		default:
+			printStr("How did we get here?", currXfb);
+			break;
+	}
+	
+	setCursorPos(3, 0);
+	sprintf(strBuffer, "Sort (X): %s | Test (Y): %s | %d of %u", importSortNames[importSort],
+	        importFilterNames[importFilter], importCount, captureIndex.count);
+	printStr(strBuffer, currXfb);
+	
+	if (importCount == 0) {
+		setCursorPos(5, 0);
+		printStr("No captures found in /GTS/.", currXfb);
+	}
+	
+	// only draw the part of the list around the selection
+	int start = 0;
+	if (importSelection >= IMPORT_LIST_ROWS) {
+		start = importSelection - IMPORT_LIST_ROWS + 1;
+	}
+	for (int i = start; i < importCount && i < start + IMPORT_LIST_ROWS; i++) {
+		CaptureSummary *entry = &captureIndex.entries[importView[i]];
+		setCursorPos(5 + i - start, 0);
+		if (importSelection == i) {
+			printStr("> ", currXfb);
+		} else {
+			setCursorPos(5 + i - start, 2);
+		}
+		int filterIndex = (entry->testType >= 0 && entry->testType <= NO_TEST) ? entry->testType + 1 : IMPORT_FILTER_LEN - 1;
+		sprintf(strBuffer, "%-27s %4u %7.1fms %s", entry->name, entry->samples, entry->durationUs / 1000.0,
+		        importFilterNames[filterIndex]);
+		printStr(strBuffer, currXfb);
+	}
+	
+	// results stored for the selected capture
+	if (importCount != 0) {
+		CaptureSummary *entry = &captureIndex.entries[importView[importSelection]];
+		setCursorPos(5 + IMPORT_LIST_ROWS + 1, 0);
+		sprintf(strBuffer, "X: %d to %d | Y: %d to %d", entry->minX, entry->maxX, entry->minY, entry->maxY);
+		printStr(strBuffer, currXfb);
+		if (entry->flags & INDEX_FLAG_PIVOT) {
+			sprintf(strBuffer, " | Pivot: %0.2fms", entry->pivotUs / 1000.0);
+			printStr(strBuffer, currXfb);
+		}
+	}
+	
+	setCursorPos(5 + IMPORT_LIST_ROWS + 3, 0);
+	printStr("Z: Rescan /GTS/ | L: Load as the reference", currXfb);
+	
+	if (pressed & PAD_BUTTON_UP && importSelection > 0) {
+		importSelection--;
+	} else if (pressed & PAD_BUTTON_DOWN && importSelection < importCount - 1) {
+		importSelection++;
+	} else if (pressed & PAD_BUTTON_X) {
+		importSort = (importSort + 1) % INDEX_SORT_LEN;
+		filterCaptureIndex();
+	} else if (pressed & PAD_BUTTON_Y) {
+		importFilter = (importFilter + 1) % IMPORT_FILTER_LEN;
+		importSelection = 0;
+		filterCaptureIndex();
+	} else if (pressed & PAD_TRIGGER_Z) {
+		importListReturnCode = rebuildCaptureIndex(&captureIndex);
+		importSelection = 0;
+		filterCaptureIndex();
+	} else if (pressed & PAD_BUTTON_A && importCount != 0) {
+		CaptureSummary *entry = &captureIndex.entries[importView[importSelection]];
+		WaveformData *slot = history_begin();
+		u64 startTick = gettime();
+		importReturnCode = importData(entry->name, slot);
+		importTimeUs = ticks_to_microsecs(gettime() - startTick);
+		importedReference = false;
+		// the test type isn't stored in the capture, only in the index
+		if (importReturnCode == 0) {
+			slot->testType = entry->testType;
+			history_commit();
+		}
+	} else if (pressed & PAD_TRIGGER_L && importCount != 0) {
+		// straight into the reference, the capture in memory stays as it is
+		CaptureSummary *entry = &captureIndex.entries[importView[importSelection]];
+		u64 startTick = gettime();
+		importReturnCode = importData(entry->name, reference_buffer());
+		importTimeUs = ticks_to_microsecs(gettime() - startTick);
+		reference_setPinned(importReturnCode == 0);
+		importedReference = true;
+	}
+}
+
 
 void menu_waitingMeasure(void *currXfb) {
 	if (!displayedWaitingInputMessage) {
@@ -992,16 +1298,80 @@ void menu_waitingMeasure(void *currXfb) {
 		displayedWaitingInputMessage = true;
 		return;
 	}
-	measureWaveform(&data);
-	dataScrollOffset = 0;
-	lastDrawPoint = data.endPoint - 1;
-	map2dStartIndex = 0;
-	assert(data.endPoint < 5000);
+	WaveformData *slot = history_begin();
+	measureWaveform(slot);
+	assert(slot->endPoint < 5000);
+	history_commit();
 	currentMenu = previousMenu;
 	displayedWaitingInputMessage = false;
 }
 
 
+// every raw position the tracker saw, placed the same way as the stick line
+static void drawTrackerHits(void *currXfb) {
+	const HitMap *map = coordTracker_map();
+	for (int row = 0; row < HITMAP_SIZE; row++) {
+		for (int col = 0; col < HITMAP_SIZE; col++) {
+			u32 count = map->hits[row][col];
+			if (count == 0) {
+				continue;
+			}
+			// the map has the top row first
+			WaveformDatapoint raw = { .ax = col - 128, .ay = 127 - row };
+			WaveformDatapoint melee = convertStickValues(&raw);
+			int x = (melee.ax / 125) * 2;
+			if (raw.ax < 0) {
+				x *= -1;
+			}
+			int y = (melee.ay / 125) * 2;
+			if (raw.ay > 0) {
+				y *= -1;
+			}
+			x += COORD_CIRCLE_CENTER_X;
+			y += SCREEN_POS_CENTER_Y;
+			DrawFilledBox(x - 1, y - 1, x, y, trackerPalette[hitmap_level(map, count) - 1], currXfb);
+		}
+	}
+}
+
+// share of the tracked polls that landed in each category of the stickmap
+static void printTrackerStats(void *currXfb) {
+	CoordTrackerStats stats;
+	coordTracker_stats(&stats);
+	setCursorPos(11, 0);
+	sprintf(strBuffer, "Tracking: %llu polls\n", stats.polls);
+	printStr(strBuffer, currXfb);
+
+	const char **names;
+	const u32 (*colors)[2];
+	int len;
+	switch (selectedStickmap) {
+		case FF_WD:
+			names = STICKMAP_FF_WD_RETVALS;
+			colors = STICKMAP_FF_WD_RETCOLORS;
+			len = STICKMAP_FF_WD_ENUM_LEN;
+			break;
+		case SHIELDDROP:
+			names = STICKMAP_SHIELDDROP_RETVALS;
+			colors = STICKMAP_SHIELDDROP_RETCOLORS;
+			len = STICKMAP_SHIELDDROP_ENUM_LEN;
+			break;
+		case NONE:
+		default:
+			printStr("No stickmap selected", currXfb);
+			return;
+	}
+	for (int i = 0; i < len; i++) {
+		printStrColor(names[i], currXfb, colors[i][0], colors[i][1]);
+		float percent = 0;
+		if (stats.polls != 0) {
+			percent = (stats.results[i] * 100.0) / stats.polls;
+		}
+		sprintf(strBuffer, ": %0.1f%%\n", percent);
+		printStr(strBuffer, currXfb);
+	}
+}
+
 void menu_coordinateViewer(void *currXfb) {
 	// melee stick coordinates stuff
 	// a lot of this comes from github.com/phobgcc/phobconfigtool
@@ -1146,6 +1516,11 @@ void menu_coordinateViewer(void *currXfb) {
 	
 	DrawStickmapOverlay(selectedStickmap, selectedStickmapSub, currXfb);
 
+	if (coordTracker_isRunning()) {
+		drawTrackerHits(currXfb);
+		printTrackerStats(currXfb);
+	}
+
 	// draw analog stick line
 	DrawLine(COORD_CIRCLE_CENTER_X, SCREEN_POS_CENTER_Y, xfbCoordX, xfbCoordY, COLOR_WHITE, currXfb);
 	DrawBox(xfbCoordX - 4, xfbCoordY - 4, xfbCoordX + 4, xfbCoordY + 4, COLOR_WHITE, currXfb);
@@ -1154,12 +1529,24 @@ void menu_coordinateViewer(void *currXfb) {
 	DrawLine(COORD_CIRCLE_CENTER_X, SCREEN_POS_CENTER_Y, xfbCoordCX, xfbCoordCY, COLOR_YELLOW, currXfb);
 	DrawFilledBox(xfbCoordCX - 2, xfbCoordCY - 2, xfbCoordCX + 2, xfbCoordCY + 2, COLOR_YELLOW, currXfb);
 	
+	if (pressed & PAD_BUTTON_A) {
+		if (coordTracker_isRunning()) {
+			coordTracker_stop();
+		} else {
+			hitmap_buildPalette(trackerPalette, HITMAP_HEAT);
+			coordTracker_start(selectedStickmap);
+		}
+	}
 	if (pressed & PAD_BUTTON_X) {
 		selectedStickmap++;
 		selectedStickmapSub = 0;
 		if (selectedStickmap == 3) {
 			selectedStickmap = 0;
 		}
+		// counts from the old stickmap don't mean anything for the new one
+		if (coordTracker_isRunning()) {
+			coordTracker_setStickmap(selectedStickmap);
+		}
 	}
 	if (pressed & PAD_BUTTON_Y) {
 		selectedStickmapSub++;
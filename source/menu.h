@@ -8,14 +8,19 @@
 #include <stdbool.h>
 
 // enum for keeping track of the currently displayed menu
-enum CURRENT_MENU { MAIN_MENU, CONTROLLER_TEST, WAVEFORM, PLOT_2D, IMAGE_TEST, FILE_EXPORT, WAITING_MEASURE, COORD_MAP, CONTINUOUS_WAVEFORM, ERR };
+enum CURRENT_MENU { MAIN_MENU, CONTROLLER_TEST, WAVEFORM, PLOT_2D, IMAGE_TEST, FILE_EXPORT, WAITING_MEASURE, COORD_MAP, CONTINUOUS_WAVEFORM, TRIGGER_WAVEFORM, BUTTON_TIMELINE, SOAK_TEST, RECORDER, FILE_IMPORT, PHOSPHOR_PLOT, ERR };
 
 // functions for drawing the individual menus
 bool menu_runMenu(void *currXfb);
+// which menu menu_runMenu will draw next
+enum CURRENT_MENU menu_getCurrentMenu();
+// short name for reports, no spaces
+const char *menu_getMenuName(enum CURRENT_MENU menu);
 void menu_mainMenu(void *currXfb);
 void menu_controllerTest(void *currXfb);
 void menu_2dPlot(void *currXfb);
 void menu_fileExport(void *currXfb);
+void menu_fileImport(void *currXfb);
 void menu_waitingMeasure(void *currXfb);
 void menu_coordinateViewer(void *currXfb);
 
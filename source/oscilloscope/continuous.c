@@ -6,11 +6,16 @@
 #include "../print.h"
 
 #include <stdio.h>
+#include <string.h>
 #include <gccore.h>
 #include <ogc/lwp_watchdog.h>
 #include "../polling.h"
+#include "../input.h"
 #include "../draw.h"
 #include "../waveform.h"
+#include "../profiler.h"
+#include "../hitmap.h"
+#include "../analysis/events.h"
 
 char strBuffer[100];
 
@@ -19,25 +24,48 @@ const static u8 SCREEN_TIMEPLOT_START = 70;
 static const uint32_t COLOR_RED_C = 0x846084d7;
 static const uint32_t COLOR_BLUE_C = 0x6dd26d72;
 
+// xy plot, top left is stick (-128, 127)
+#define XY_PLOT_X (COORD_CIRCLE_CENTER_X - 128)
+#define XY_PLOT_Y (SCREEN_POS_CENTER_Y - 127)
+#define XY_FADE_LEN 4
+static const u32 XY_FADE_MS[XY_FADE_LEN] = { 100, 250, 500, 1000 };
+
 static enum CONT_MENU_STATE state = CONT_SETUP;
 static enum CONT_STATE cState = INPUT;
 
-static WaveformData data = { {{ 0 }}, 0, 500, true, false, false };
+static WaveformData data = { .totalTimeUs = 500, .isDataReady = true, .testType = -1 };
 static int dataIndex = 0;
 
 static int waveformScaleFactor = 6;
 static int dataScrollOffset = 0;
-static bool pressLocked = false;
 static bool freeze = false;
 static bool showCStick = false;
 
-static bool buttonLock = false;
+// every sample since the layer was cleared, in the framebuffer's format, two pixels per word
+// only new samples get drawn into it, then it gets copied to the screen
+static u32 xyLayer[256][128];
+// next sample to add to the layer
+static int xyLayerIndex = 0;
+static bool xyView = false;
+static int xyFadeSelection = 2;
+// grays for the trail, dimmest first
+static u32 xyPalette[HITMAP_LEVELS];
+
+// built once when the buffer gets locked, positions count from the oldest sample
+static EventIndex events;
+static bool eventsReady = false;
+// event the view was last moved to, -1 after scrolling by hand
+static int selectedEvent = -1;
+#define EVENT_FILTER_LEN 4
+static const int EVENT_FILTER_MASKS[EVENT_FILTER_LEN] = { EVENTS_MASK_ALL, EVENTS_MASK_ZONES, EVENTS_MASK_PEAKS, EVENTS_MASK_RESTS };
+static const char *EVENT_FILTER_NAMES[EVENT_FILTER_LEN] = { "all", "zones", "peaks", "rests" };
+static int eventFilter = 0;
+
 static u32 *pressed;
 static u32 *held;
 
 static u64 prevSampleCallbackTick = 0;
 static u64 sampleCallbackTick = 0;
-static u64 pressedTimer = 0;
 
 static sampling_callback cb;
 
@@ -51,28 +79,19 @@ static void contSamplingCallback() {
 	
 	PAD_ScanPads();
 	
-	// keep buttons in a "pressed" state long enough for code to see it
-	// TODO: I don't like this implementation
-	if (!pressLocked) {
-		*pressed = PAD_ButtonsDown(0);
-		if ((*pressed) != 0) {
-			pressLocked = true;
-			pressedTimer = gettime();
-		}
-	} else {
-		if (ticks_to_millisecs(gettime() - pressedTimer) > 32) {
-			pressLocked = false;
-		}
-	}
-	
-	*held = PAD_ButtonsHeld(0);
-	
-	
+	// queue button changes for the menu code
+	u16 currHeld = input_update();
+
 	if (!freeze) {
 		data.data[dataIndex].ax = PAD_StickX(0);
 		data.data[dataIndex].ay = PAD_StickY(0);
 		data.data[dataIndex].cx = PAD_SubStickX(0);
 		data.data[dataIndex].cy = PAD_SubStickY(0);
+		data.data[dataIndex].tl = PAD_TriggerL(0);
+		data.data[dataIndex].tr = PAD_TriggerR(0);
+		data.data[dataIndex].isDigitalLPressed = (currHeld & PAD_TRIGGER_L) != 0;
+		data.data[dataIndex].isDigitalRPressed = (currHeld & PAD_TRIGGER_R) != 0;
+		data.data[dataIndex].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
 		dataIndex++;
 		if (dataIndex == WAVEFORM_SAMPLES) {
 			dataIndex = 0;
@@ -80,9 +99,167 @@ static void contSamplingCallback() {
 	}
 }
 
+static void clearXYLayer() {
+	memset(xyLayer, 0, sizeof(xyLayer));
+	xyLayerIndex = dataIndex;
+}
+
+// draw whatever arrived since last frame into the layer, this doesn't depend on how much is already there
+static void updateXYLayer() {
+	int currIndex = dataIndex;
+	while (xyLayerIndex != currIndex) {
+		int x, y;
+		if (!showCStick) {
+			x = data.data[xyLayerIndex].ax;
+			y = data.data[xyLayerIndex].ay;
+		} else {
+			x = data.data[xyLayerIndex].cx;
+			y = data.data[xyLayerIndex].cy;
+		}
+		xyLayer[127 - y][(x + 128) >> 1] = xyPalette[0];
+		xyLayerIndex++;
+		if (xyLayerIndex == WAVEFORM_SAMPLES) {
+			xyLayerIndex = 0;
+		}
+	}
+}
+
+// everything in the layer, then the last few hundred ms on top of it, brighter the newer it is
+// all ~1400 samples a second are drawn, nothing gets skipped like in the waveform
+static void drawXYPlot(void *currXfb) {
+	u32 fadeUs = XY_FADE_MS[xyFadeSelection] * 1000;
+	DrawBox(XY_PLOT_X - 1, XY_PLOT_Y - 1, XY_PLOT_X + 256, XY_PLOT_Y + 256, COLOR_WHITE, currXfb);
+	DrawOctagonalGate(COORD_CIRCLE_CENTER_X, SCREEN_POS_CENTER_Y, 1, COLOR_GRAY, currXfb);
+	drawLayer(currXfb, &xyLayer[0][0], 128, 256, XY_PLOT_X, XY_PLOT_Y);
+
+	// walk back from the newest sample to find where the trail starts
+	int newest = dataIndex - 1;
+	if (newest < 0) {
+		newest += WAVEFORM_SAMPLES;
+	}
+	int index = newest;
+	u32 ageUs = 0;
+	int count = 1;
+	while (count < WAVEFORM_SAMPLES) {
+		u32 stepUs = data.data[index].timeDiffUs;
+		if (ageUs + stepUs > fadeUs) {
+			break;
+		}
+		ageUs += stepUs;
+		index--;
+		if (index < 0) {
+			index += WAVEFORM_SAMPLES;
+		}
+		count++;
+	}
+
+	// then draw it oldest first, so newer samples end up on top
+	PROFILE_BEGIN(PROFILE_WAVEFORM);
+	for (int i = 0; i < count; i++) {
+		int x, y;
+		if (!showCStick) {
+			x = data.data[index].ax;
+			y = data.data[index].ay;
+		} else {
+			x = data.data[index].cx;
+			y = data.data[index].cy;
+		}
+		int level = 1 + (((fadeUs - ageUs) * (HITMAP_LEVELS - 2)) / fadeUs);
+		DrawDot(COORD_CIRCLE_CENTER_X + x, SCREEN_POS_CENTER_Y - y, xyPalette[level], currXfb);
+		index++;
+		if (index == WAVEFORM_SAMPLES) {
+			index = 0;
+		}
+		if (i + 1 < count) {
+			u32 stepUs = data.data[index].timeDiffUs;
+			ageUs = ageUs > stepUs ? ageUs - stepUs : 0;
+		}
+	}
+	PROFILE_END(PROFILE_WAVEFORM);
+
+	setCursorPos(20, 0);
+	sprintf(strBuffer, "Trail: %u ms\n", XY_FADE_MS[xyFadeSelection]);
+	printStr(strBuffer, currXfb);
+	printStr("X: waveform | Up/Down: trail | R: clear", currXfb);
+
+	if (*pressed & PAD_BUTTON_UP && xyFadeSelection < XY_FADE_LEN - 1) {
+		xyFadeSelection++;
+	}
+	if (*pressed & PAD_BUTTON_DOWN && xyFadeSelection > 0) {
+		xyFadeSelection--;
+	}
+	if (*pressed & PAD_TRIGGER_R) {
+		clearXYLayer();
+	}
+}
+
+static void buildEvents() {
+	// the oldest sample is the one that gets written next
+	PROFILE_BEGIN(PROFILE_ANALYSIS);
+	events_build(&events, &data, dataIndex, WAVEFORM_SAMPLES, showCStick);
+	PROFILE_END(PROFILE_ANALYSIS);
+	eventsReady = true;
+	selectedEvent = -1;
+}
+
+// position of the first sample shown, counting from the oldest
+static int viewStart() {
+	return WAVEFORM_SAMPLES - (500 * waveformScaleFactor) - dataScrollOffset;
+}
+
+// puts the event in the middle of the view, as far as the scroll bounds allow
+static void jumpToEvent(int event) {
+	if (event < 0) {
+		return;
+	}
+	selectedEvent = event;
+	dataScrollOffset = WAVEFORM_SAMPLES - (250 * waveformScaleFactor) - (int) events.events[event].position;
+	if (dataScrollOffset > (WAVEFORM_SAMPLES - (500 * waveformScaleFactor))) {
+		dataScrollOffset = (WAVEFORM_SAMPLES - (500 * waveformScaleFactor));
+	} else if (dataScrollOffset < 0) {
+		dataScrollOffset = 0;
+	}
+}
+
+// a tick under every event in view, and a line through the selected one
+static void drawEvents(void *currXfb) {
+	int start = viewStart();
+	int end = start + (500 * waveformScaleFactor);
+	int mask = EVENT_FILTER_MASKS[eventFilter];
+	for (int i = events_lowerBound(&events, start); i < events.count && (int) events.events[i].position < end; i++) {
+		if (!(mask & (1 << events.events[i].type))) {
+			continue;
+		}
+		int x = SCREEN_TIMEPLOT_START + ((events.events[i].position - start) / waveformScaleFactor);
+		if (i == selectedEvent) {
+			DrawVLine(x, SCREEN_POS_CENTER_Y - 127, SCREEN_POS_CENTER_Y + 127, COLOR_YELLOW, currXfb);
+		} else {
+			DrawVLine(x, SCREEN_POS_CENTER_Y + 120, SCREEN_POS_CENTER_Y + 127, COLOR_YELLOW, currXfb);
+		}
+	}
+
+	setCursorPos(3, 14);
+	if (selectedEvent != -1) {
+		const StickEvent *event = &events.events[selectedEvent];
+		if (event->axis == EVENT_AXIS_BOTH) {
+			sprintf(strBuffer, "| %d/%d: %s, %0.1f ms", selectedEvent + 1, events.count,
+			        events_typeName(event->type), event->timeUs / 1000.0f);
+		} else {
+			sprintf(strBuffer, "| %d/%d: %c %s at %d, %0.1f ms", selectedEvent + 1, events.count,
+			        event->axis == EVENT_AXIS_X ? 'X' : 'Y', events_typeName(event->type), event->value,
+			        event->timeUs / 1000.0f);
+		}
+	} else {
+		sprintf(strBuffer, "| %d events%s", events.count, events.dropped != 0 ? " (full)" : "");
+	}
+	printStr(strBuffer, currXfb);
+}
+
 static void setup(u32 *p, u32 *h) {
 	pressed = p;
 	held = h;
+	hitmap_buildPalette(xyPalette, HITMAP_INTENSITY);
+	clearXYLayer();
 	data.endPoint = WAVEFORM_SAMPLES - 1;
 	setSamplingRateHigh();
 	cb = PAD_SetSamplingCallback(contSamplingCallback);
@@ -105,11 +282,19 @@ void menu_continuousWaveform(void *currXfb, u32 *p, u32 *h) {
 				freeze = true;
 				setCursorPos(2, 28);
 				printStrColor("LOCKED", currXfb, COLOR_WHITE, COLOR_BLACK);
+				// the buffer won't change until it's unlocked, so this only has to happen once
+				if (!eventsReady) {
+					buildEvents();
+				}
 			} else {
 				freeze = false;
+				eventsReady = false;
 			}
 
-			if (data.isDataReady) {
+			updateXYLayer();
+			if (xyView) {
+				drawXYPlot(currXfb);
+			} else if (data.isDataReady) {
 				// draw guidelines based on selected test
 				DrawBox(SCREEN_TIMEPLOT_START - 1, SCREEN_POS_CENTER_Y - 128, SCREEN_TIMEPLOT_START + 500,
 				        SCREEN_POS_CENTER_Y + 128, COLOR_WHITE, currXfb);
@@ -141,10 +326,11 @@ void menu_continuousWaveform(void *currXfb, u32 *p, u32 *h) {
 				sprintf(strBuffer, "Scaling Factor: %d\n", waveformScaleFactor);
 				printStr(strBuffer, currXfb);
 				if (cState == INPUT_LOCK) {
-					sprintf(strBuffer, "Offset: %d", dataScrollOffset);
+					sprintf(strBuffer, "Offset: %d | L/R: event | Z: %s", dataScrollOffset, EVENT_FILTER_NAMES[eventFilter]);
 					printStr(strBuffer, currXfb);
 				}
 				
+				PROFILE_BEGIN(PROFILE_WAVEFORM);
 				for (int i = 0; i < 500; i++) {
 					int currX, currY;
 					if (!showCStick) {
@@ -170,51 +356,67 @@ void menu_continuousWaveform(void *currXfb, u32 *p, u32 *h) {
 					waveformPrevXPos = waveformXPos;
 					waveformXPos++;
 				}
-				
-				if (!buttonLock){
-					if (*pressed & PAD_BUTTON_A && !buttonLock) {
-						if (cState == INPUT_LOCK) {
-							cState = INPUT;
-							waveformScaleFactor = 6;
-							dataScrollOffset = 0;
-						} else {
-							cState = INPUT_LOCK;
-						}
-						buttonLock = true;
-					}
-					if (*pressed & PAD_BUTTON_Y && !buttonLock) {
-						showCStick = !showCStick;
-						buttonLock = true;
+				PROFILE_END(PROFILE_WAVEFORM);
+
+				if (cState == INPUT_LOCK && eventsReady) {
+					drawEvents(currXfb);
+					int mask = EVENT_FILTER_MASKS[eventFilter];
+					// from the selected event, or from the middle of the view if there isn't one
+					int center = viewStart() + (250 * waveformScaleFactor);
+					if (*pressed & PAD_TRIGGER_R) {
+						jumpToEvent(selectedEvent != -1 ? events_nextFrom(&events, selectedEvent, mask) : events_next(&events, center, mask));
+					} else if (*pressed & PAD_TRIGGER_L) {
+						jumpToEvent(selectedEvent != -1 ? events_prevFrom(&events, selectedEvent, mask) : events_prev(&events, center, mask));
 					}
-					if (*pressed & PAD_BUTTON_UP && !buttonLock && cState == INPUT_LOCK) {
-						waveformScaleFactor--;
-						if (waveformScaleFactor < 1) {
-							waveformScaleFactor = 1;
-						}
-						buttonLock = true;
+					if (*pressed & PAD_TRIGGER_Z) {
+						eventFilter = (eventFilter + 1) % EVENT_FILTER_LEN;
+						selectedEvent = -1;
 					}
-					if (*pressed & PAD_BUTTON_DOWN && !buttonLock && cState == INPUT_LOCK) {
-						waveformScaleFactor++;
-						if (waveformScaleFactor > 6) {
-							waveformScaleFactor = 6;
-						}
-						buttonLock = true;
+				}
+				
+				if (*pressed & PAD_BUTTON_UP && cState == INPUT_LOCK) {
+					waveformScaleFactor--;
+					if (waveformScaleFactor < 1) {
+						waveformScaleFactor = 1;
 					}
-					
-					// bounds checks happen above, since they need to be adjusted depending on scale factor anyways
-					if (*held & PAD_BUTTON_LEFT && cState == INPUT_LOCK) {
-						dataScrollOffset += 25;
-					} else if (*held & PAD_BUTTON_RIGHT && cState == INPUT_LOCK) {
-						dataScrollOffset -= 25;
+				}
+				if (*pressed & PAD_BUTTON_DOWN && cState == INPUT_LOCK) {
+					waveformScaleFactor++;
+					if (waveformScaleFactor > 6) {
+						waveformScaleFactor = 6;
 					}
 				}
+				
+				// bounds checks happen above, since they need to be adjusted depending on scale factor anyways
+				if (*held & PAD_BUTTON_LEFT && cState == INPUT_LOCK) {
+					dataScrollOffset += 25;
+					selectedEvent = -1;
+				} else if (*held & PAD_BUTTON_RIGHT && cState == INPUT_LOCK) {
+					dataScrollOffset -= 25;
+					selectedEvent = -1;
+				}
+			}
+
+			if (*pressed & PAD_BUTTON_A) {
+				if (cState == INPUT_LOCK) {
+					cState = INPUT;
+					waveformScaleFactor = 6;
+					dataScrollOffset = 0;
+				} else {
+					cState = INPUT_LOCK;
+				}
+			}
+			if (*pressed & PAD_BUTTON_Y) {
+				showCStick = !showCStick;
+				// the layer only has one stick in it
+				clearXYLayer();
+				eventsReady = false;
+			}
+			if (*pressed & PAD_BUTTON_X) {
+				xyView = !xyView;
 			}
 			break;
 	}
-	
-	if ((*held) == 0 && buttonLock) {
-		buttonLock = false;
-	}
 }
 
 void menu_continuousEnd() {
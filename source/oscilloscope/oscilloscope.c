@@ -8,7 +8,13 @@
 #include "../print.h"
 #include "../draw.h"
 #include "../polling.h"
+#include "../input.h"
 #include "../stickmap_coordinates.h"
+#include "../profiler.h"
+#include "../analysis/reference.h"
+#include "../history.h"
+#include "../analysis/attempts.h"
+#include "../file/file.h"
 //#include "../waveform.h"
 
 const static u8 STICK_MOVEMENT_THRESHOLD = 5;
@@ -24,8 +30,11 @@ static const uint32_t COLOR_BLUE_C = 0x6dd26d72;
 static enum OSC_MENU_STATE state = OSC_SETUP;
 static enum OSC_STATE oState = PRE_INPUT;
 
-static WaveformData *data = NULL; // = { {{ 0 }}, 0, 500, false, false };
-static enum OSCILLOSCOPE_TEST currentTest = SNAPBACK;
+// the capture on screen, and the one the callback is recording into
+// they're different slots in the history, so going through older captures doesn't touch a recording
+static WaveformData *data = NULL;
+static WaveformData *capture = NULL;
+static enum OSCILLOSCOPE_TEST currentTest = AUTO;
 static int waveformScaleFactor = 1;
 static int dataScrollOffset = 0;
 static char strBuffer[100];
@@ -33,13 +42,49 @@ static char strBuffer[100];
 static u8 stickCooldown = 0;
 static s8 snapbackStartPosX = 0, snapbackStartPosY = 0;
 static s8 snapbackPrevPosX = 0, snapbackPrevPosY = 0;
-static bool pressLocked = false;
 static bool stickMove = false;
 static bool showCStick = false;
 static bool display = false;
+// spectrum of the ringing instead of the waveform, snapback only
+static bool showSpectrum = false;
+static SpectrumResult spectrum;
+static bool spectrumReady = false;
+// what AUTO decided the current capture was, and the results that go with it
+static AnalysisReport autoReport;
+static bool autoReportReady = false;
+
+// two measurement cursors, sample numbers in the capture, D-pad moves whichever one is selected
+enum CURSOR_MODE { CURSOR_OFF, CURSOR_A, CURSOR_B, CURSOR_MODE_LEN };
+static enum CURSOR_MODE cursorMode = CURSOR_OFF;
+static int cursorA = 0, cursorB = 0;
+// built the first time the cursors are shown for a capture, so the readouts don't depend on how far apart they are
+static RangeIndex cursorIndex;
+static bool cursorIndexReady = false;
+// the capture against the pinned reference, redone when either of them changes
+static ReferenceDiff referenceDiff;
+static bool referenceDiffReady = false;
+static uint32_t referenceDiffGeneration = 0;
+
+// practice session, every capture kept while it's on is an attempt at a test
+static bool sessionOn = false;
+static AttemptSession session;
+static AttemptRow lastAttempt;
+static int sessionExportCode = -1;
+// set by the callback when it keeps a capture, the attempt is added from the menu
+static volatile bool captureFinished = false;
+
+// for anything worked out from the capture in memory, once it changes
+static void captureChanged() {
+	cursorIndexReady = false;
+	referenceDiffReady = false;
+	spectrumReady = false;
+}
+
+_Static_assert((int) MOTION_SNAPBACK == SNAPBACK && (int) MOTION_PIVOT == PIVOT &&
+               (int) MOTION_DASHBACK == DASHBACK && (int) MOTION_NONE == NO_TEST,
+               "enum MOTION_TYPE needs to line up with enum OSCILLOSCOPE_TEST");
 
 static u8 ellipseCounter = 0;
-static u64 pressedTimer = 0;
 static u64 prevSampleCallbackTick = 0;
 static u64 sampleCallbackTick = 0;
 static u64 timeStickInOrigin = 0;
@@ -47,10 +92,20 @@ static u64 timeStoppedMoving = 0;
 
 static u32 *pressed;
 static u32 *held;
-static bool buttonLock = false;
-static u8 buttonPressCooldown = 0;
 
 static sampling_callback cb;
+// keeps the capture that was just recorded in the history
+static void finishCapture() {
+	// every test's capture is labeled here, AUTO ones get relabeled once the menu works out what they were
+	capture->testType = currentTest;
+	capture->totalTimeUs = 0;
+	for (int i = 1; i < capture->endPoint; i++) {
+		capture->totalTimeUs += capture->data[i].timeDiffUs;
+	}
+	history_commit();
+	captureFinished = true;
+}
+
 static void oscilloscopeCallback() {
 	// time from last call of this function calculation
 	prevSampleCallbackTick = sampleCallbackTick;
@@ -60,23 +115,13 @@ static void oscilloscopeCallback() {
 	}
 
 	static s8 x, y, cx, cy;
+	static u8 tl, tr;
+	// the whole sample, written over every field of a slot that can still hold an older capture
+	static WaveformDatapoint sample;
 	PAD_ScanPads();
 
-	// keep buttons in a "pressed" state long enough for code to see it
-	// TODO: I don't like this implementation
-	if (!pressLocked) {
-		*pressed = PAD_ButtonsDown(0);
-		if ((*pressed) != 0) {
-			pressLocked = true;
-			pressedTimer = gettime();
-		}
-	} else {
-		if (ticks_to_millisecs(gettime() - pressedTimer) > 32) {
-			pressLocked = false;
-		}
-	}
-
-	*held = PAD_ButtonsHeld(0);
+	// queue button changes for the menu code
+	input_update();
 
 	// read stick position if not locked
 	if (oState != POST_INPUT_LOCK) {
@@ -84,18 +129,24 @@ static void oscilloscopeCallback() {
 		y = PAD_StickY(0);
 		cx = PAD_SubStickX(0);
 		cy = PAD_SubStickY(0);
+		tl = PAD_TriggerL(0);
+		tr = PAD_TriggerR(0);
+		u32 held = PAD_ButtonsHeld(0);
+		sample = (WaveformDatapoint) {
+			.ax = x, .ay = y, .cx = cx, .cy = cy, .tl = tl, .tr = tr,
+			.isDigitalLPressed = (held & PAD_TRIGGER_L) != 0,
+			.isDigitalRPressed = (held & PAD_TRIGGER_R) != 0
+		};
 		
 		// handle stick recording differently based on the selected test
 		switch (currentTest) {
 			case SNAPBACK:
+			case AUTO:
 				// we're already recording an input
 				if (stickMove) {
-					data->data[data->endPoint].ax = x;
-					data->data[data->endPoint].ay = y;
-					data->data[data->endPoint].cx = cx;
-					data->data[data->endPoint].cy = cy;
-					data->data[data->endPoint].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-					data->endPoint++;
+					capture->data[capture->endPoint] = sample;
+					capture->data[capture->endPoint].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+					capture->endPoint++;
 					
 					// has the stick stopped moving?
 					if (!showCStick) {
@@ -119,13 +170,14 @@ static void oscilloscopeCallback() {
 					}
 					
 					// have we either run out of data, or has the stick stopped moving for long enough?
-					if (data->endPoint == WAVEFORM_SAMPLES || ((timeStoppedMoving / 1000)) >= STICK_MOVEMENT_TIME_THRESHOLD_MS) {
+					if (capture->endPoint == WAVEFORM_SAMPLES || ((timeStoppedMoving / 1000)) >= STICK_MOVEMENT_TIME_THRESHOLD_MS) {
 						if (!showCStick) {
 							// are we stopped near the origin?
 							if ((x < STICK_MOVEMENT_THRESHOLD && x > -STICK_MOVEMENT_THRESHOLD) &&
 							    (y < STICK_MOVEMENT_THRESHOLD && y > -STICK_MOVEMENT_THRESHOLD)) {
 								// normal procedure, make data ready
-								data->isDataReady = true;
+								capture->isDataReady = true;
+								finishCapture();
 								stickMove = false;
 								display = true;
 								oState = POST_INPUT_LOCK;
@@ -135,7 +187,7 @@ static void oscilloscopeCallback() {
 							} else {
 								// go back in the loop, we're holding a position somewhere outside origin
 								// this will also reset if we're out of datapoints? not sure how this'll work
-								data->endPoint = 0;
+								capture->endPoint = 0;
 								stickMove = false;
 								snapbackStartPosX = x;
 								snapbackStartPosY = y;
@@ -143,7 +195,8 @@ static void oscilloscopeCallback() {
 						} else {
 							if ((cx < STICK_MOVEMENT_THRESHOLD && cx > -STICK_MOVEMENT_THRESHOLD) &&
 							    (cy < STICK_MOVEMENT_THRESHOLD && cy > -STICK_MOVEMENT_THRESHOLD)) {
-								data->isDataReady = true;
+								capture->isDataReady = true;
+								finishCapture();
 								stickMove = false;
 								display = true;
 								oState = POST_INPUT_LOCK;
@@ -151,7 +204,7 @@ static void oscilloscopeCallback() {
 								snapbackStartPosX = 0;
 								snapbackStartPosY = 0;
 							} else {
-								data->endPoint = 0;
+								capture->endPoint = 0;
 								stickMove = false;
 								snapbackStartPosX = cx;
 								snapbackStartPosY = cy;
@@ -165,47 +218,29 @@ static void oscilloscopeCallback() {
 					if (!showCStick) {
 						if ((x > snapbackStartPosX + STICK_MOVEMENT_THRESHOLD || x < snapbackStartPosX - STICK_MOVEMENT_THRESHOLD) ||
 						    (y > snapbackStartPosY + STICK_MOVEMENT_THRESHOLD) || (y < snapbackStartPosY - STICK_MOVEMENT_THRESHOLD)) {
-							// reset data
-							for (int i = 1; i < WAVEFORM_SAMPLES; i++) {
-								data->data[i].ax = 0;
-								data->data[i].ay = 0;
-								data->data[i].cx = 0;
-								data->data[i].cy = 0;
-								data->data[i].timeDiffUs = 0;
-							}
+							// a fresh slot, the last capture stays in the history
+							capture = history_begin();
 							stickMove = true;
-							data->data[0].ax = x;
-							data->data[0].ay = y;
-							data->data[0].cx = cx;
-							data->data[0].cy = cy;
-							data->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
-							//data->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-							data->endPoint = 1;
-							data->isDataReady = false;
-							data->exported = false;
+							capture->data[0] = sample;
+							capture->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
+							//capture->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+							capture->endPoint = 1;
+							capture->isDataReady = false;
+							capture->exported = false;
 							oState = PRE_INPUT;
 						}
 					} else {
 						if ((cx > snapbackStartPosX + STICK_MOVEMENT_THRESHOLD || cx < snapbackStartPosX - STICK_MOVEMENT_THRESHOLD) ||
 						    (cy > snapbackStartPosY + STICK_MOVEMENT_THRESHOLD) || (cy < snapbackStartPosY - STICK_MOVEMENT_THRESHOLD)) {
-							// reset data
-							for (int i = 1; i < WAVEFORM_SAMPLES; i++) {
-								data->data[i].ax = 0;
-								data->data[i].ay = 0;
-								data->data[i].cx = 0;
-								data->data[i].cy = 0;
-								data->data[i].timeDiffUs = 0;
-							}
+							// a fresh slot, the last capture stays in the history
+							capture = history_begin();
 							stickMove = true;
-							data->data[0].ax = x;
-							data->data[0].ay = y;
-							data->data[0].cx = cx;
-							data->data[0].cy = cy;
-							data->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
-							//data->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-							data->endPoint = 1;
-							data->isDataReady = false;
-							data->exported = false;
+							capture->data[0] = sample;
+							capture->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
+							//capture->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+							capture->endPoint = 1;
+							capture->isDataReady = false;
+							capture->exported = false;
 							oState = PRE_INPUT;
 						}
 					}
@@ -214,12 +249,9 @@ static void oscilloscopeCallback() {
 			case PIVOT:
 				// we're already recording an input
 				if (stickMove) {
-					data->data[data->endPoint].ax = x;
-					data->data[data->endPoint].ay = y;
-					data->data[data->endPoint].cx = cx;
-					data->data[data->endPoint].cy = cy;
-					data->data[data->endPoint].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-					data->endPoint++;
+					capture->data[capture->endPoint] = sample;
+					capture->data[capture->endPoint].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+					capture->endPoint++;
 					// are we close to the origin?
 					if ((x < STICK_MOVEMENT_THRESHOLD && x > -STICK_MOVEMENT_THRESHOLD) &&
 					    (y < STICK_MOVEMENT_THRESHOLD && y > -STICK_MOVEMENT_THRESHOLD)) {
@@ -227,7 +259,7 @@ static void oscilloscopeCallback() {
 					} else {
 						timeStickInOrigin = 0;
 					}
-					if (data->endPoint == WAVEFORM_SAMPLES || (timeStickInOrigin / 1000) >= STICK_ORIGIN_TIME_THRESHOLD_MS) {
+					if (capture->endPoint == WAVEFORM_SAMPLES || (timeStickInOrigin / 1000) >= STICK_ORIGIN_TIME_THRESHOLD_MS) {
 						// TODO: replace this with something proper, wip is already there with the switch case
 						// this will truncate the recording to just the pivot input
 						u64 timeFromOriginCross = 0;
@@ -235,18 +267,18 @@ static void oscilloscopeCallback() {
 						s8 inputSign = 0;
 						int pivotStartIndex = 0;
 						bool hasCrossedOrigin = false;
-						for (int i = data->endPoint - 1; i >= 0; i--) {
+						for (int i = capture->endPoint - 1; i >= 0; i--) {
 							if (!crossed64Range) {
-								if (data->data[i].ax >= 64 || data->data[i].ax <= -64) {
+								if (capture->data[i].ax >= 64 || capture->data[i].ax <= -64) {
 									crossed64Range = true;
-									inputSign = data->data[i].ax;
+									inputSign = capture->data[i].ax;
 								}
 							} else if (!hasCrossedOrigin) {
-								if (inputSign * data->data[i].ax < 0) {
+								if (inputSign * capture->data[i].ax < 0) {
 									hasCrossedOrigin = true;
 								}
 							} else {
-								timeFromOriginCross += data->data[i].timeDiffUs;
+								timeFromOriginCross += capture->data[i].timeDiffUs;
 								if (timeFromOriginCross / 1000 >= 50) {
 									pivotStartIndex = i;
 									break;
@@ -255,18 +287,15 @@ static void oscilloscopeCallback() {
 						}
 						
 						// rewrite data with new starting index
-						for (int i = 0; i < data->endPoint - 1 - pivotStartIndex; i++) {
-							data->data[i].ax = data->data[i + pivotStartIndex].ax;
-							data->data[i].ay = data->data[i + pivotStartIndex].ay;
-							data->data[i].cx = data->data[i + pivotStartIndex].cx;
-							data->data[i].cy = data->data[i + pivotStartIndex].cy;
-							data->data[i].timeDiffUs = data->data[i + pivotStartIndex].timeDiffUs;
+						for (int i = 0; i < capture->endPoint - 1 - pivotStartIndex; i++) {
+							capture->data[i] = capture->data[i + pivotStartIndex];
 						}
-						data->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
-						data->endPoint = data->endPoint - pivotStartIndex - 1;
+						capture->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
+						capture->endPoint = capture->endPoint - pivotStartIndex - 1;
 						
 						// normal stuff
-						data->isDataReady = true;
+						capture->isDataReady = true;
+						finishCapture();
 						stickMove = false;
 						display = true;
 						oState = POST_INPUT_LOCK;
@@ -277,24 +306,15 @@ static void oscilloscopeCallback() {
 					// does the stick move outside the threshold?
 					if ((x > STICK_MOVEMENT_THRESHOLD || x < -STICK_MOVEMENT_THRESHOLD) ||
 					    (y > STICK_MOVEMENT_THRESHOLD) || (y < -STICK_MOVEMENT_THRESHOLD)) {
-						// reset data
-						for (int i = 1; i < WAVEFORM_SAMPLES; i++) {
-							data->data[i].ax = 0;
-							data->data[i].ay = 0;
-							data->data[i].cx = 0;
-							data->data[i].cy = 0;
-							data->data[i].timeDiffUs = 0;
-						}
+						// a fresh slot, the last capture stays in the history
+						capture = history_begin();
 						stickMove = true;
-						data->data[0].ax = x;
-						data->data[0].ay = y;
-						data->data[0].cx = cx;
-						data->data[0].cy = cy;
-						data->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
-						//data->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-						data->endPoint = 1;
-						data->isDataReady = false;
-						data->exported = false;
+						capture->data[0] = sample;
+						capture->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
+						//capture->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+						capture->endPoint = 1;
+						capture->isDataReady = false;
+						capture->exported = false;
 						oState = PRE_INPUT;
 					}
 				}
@@ -302,12 +322,9 @@ static void oscilloscopeCallback() {
 			default:
 				// we're already recording an input
 				if (stickMove) {
-					data->data[data->endPoint].ax = x;
-					data->data[data->endPoint].ay = y;
-					data->data[data->endPoint].cx = cx;
-					data->data[data->endPoint].cy = cy;
-					data->data[data->endPoint].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-					data->endPoint++;
+					capture->data[capture->endPoint] = sample;
+					capture->data[capture->endPoint].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+					capture->endPoint++;
 					// are we close to the origin?
 					if (!showCStick) {
 						if ((x < STICK_MOVEMENT_THRESHOLD && x > -STICK_MOVEMENT_THRESHOLD) &&
@@ -324,8 +341,9 @@ static void oscilloscopeCallback() {
 							timeStickInOrigin = 0;
 						}
 					}
-					if (data->endPoint == WAVEFORM_SAMPLES || (timeStickInOrigin / 1000) >= STICK_ORIGIN_TIME_THRESHOLD_MS) {
-						data->isDataReady = true;
+					if (capture->endPoint == WAVEFORM_SAMPLES || (timeStickInOrigin / 1000) >= STICK_ORIGIN_TIME_THRESHOLD_MS) {
+						capture->isDataReady = true;
+						finishCapture();
 						stickMove = false;
 						display = true;
 						oState = POST_INPUT_LOCK;
@@ -337,47 +355,29 @@ static void oscilloscopeCallback() {
 					if (!showCStick) {
 						if ((x > STICK_MOVEMENT_THRESHOLD || x < -STICK_MOVEMENT_THRESHOLD) ||
 						    (y > STICK_MOVEMENT_THRESHOLD) || (y < -STICK_MOVEMENT_THRESHOLD)) {
-							// reset data
-							for (int i = 1; i < WAVEFORM_SAMPLES; i++) {
-								data->data[i].ax = 0;
-								data->data[i].ay = 0;
-								data->data[i].cx = 0;
-								data->data[i].cy = 0;
-								data->data[i].timeDiffUs = 0;
-							}
+							// a fresh slot, the last capture stays in the history
+							capture = history_begin();
 							stickMove = true;
-							data->data[0].ax = x;
-							data->data[0].ay = y;
-							data->data[0].cx = cx;
-							data->data[0].cy = cy;
-							data->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
-							//data->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-							data->endPoint = 1;
-							data->isDataReady = false;
-							data->exported = false;
+							capture->data[0] = sample;
+							capture->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
+							//capture->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+							capture->endPoint = 1;
+							capture->isDataReady = false;
+							capture->exported = false;
 							oState = PRE_INPUT;
 						}
 					} else {
 						if ((cx > STICK_MOVEMENT_THRESHOLD || cx < -STICK_MOVEMENT_THRESHOLD) ||
 						    (cy > STICK_MOVEMENT_THRESHOLD) || (cy < -STICK_MOVEMENT_THRESHOLD)) {
-							// reset data
-							for (int i = 1; i < WAVEFORM_SAMPLES; i++) {
-								data->data[i].ax = 0;
-								data->data[i].ay = 0;
-								data->data[i].cx = 0;
-								data->data[i].cy = 0;
-								data->data[i].timeDiffUs = 0;
-							}
+							// a fresh slot, the last capture stays in the history
+							capture = history_begin();
 							stickMove = true;
-							data->data[0].ax = x;
-							data->data[0].ay = y;
-							data->data[0].cx = cx;
-							data->data[0].cy = cy;
-							data->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
-							//data->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
-							data->endPoint = 1;
-							data->isDataReady = false;
-							data->exported = false;
+							capture->data[0] = sample;
+							capture->data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
+							//capture->data[0].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+							capture->endPoint = 1;
+							capture->isDataReady = false;
+							capture->exported = false;
 							oState = PRE_INPUT;
 						}
 					}
@@ -392,7 +392,14 @@ static void printInstructions(void *currXfb) {
 	printStr("Press X to cycle the current test, results will show above the\n"
 			"waveform. Press Y to cycle between Analog Stick and C-Stick.\n"
 			"Use DPAD left/right to scroll waveform when it is\n"
-			"larger than the displayed area, hold R to move faster.", currXfb);
+			"larger than the displayed area, hold R to move faster.\n"
+			"Press Up for two measurement cursors, DPAD then moves the\n"
+			"selected one, and Up selects the other one or turns them off.\n"
+			"Press Down to pin the capture as a reference, it's drawn under\n"
+			"new captures with the difference in results. Down again unpins.\n"
+			"Press Start to go back through the last 10 captures, hold R to\n"
+			"go forward. R+Z starts a practice session, with totals for\n"
+			"every attempt at each test, logged to the SD card.", currXfb);
 	printStr("\n\nCURRENT TEST: ", currXfb);
 	switch (currentTest) {
 		case SNAPBACK:
@@ -400,7 +407,9 @@ static void printInstructions(void *currXfb) {
 					"Check the min/max value on a given axis depending on where\n"
 					"the stick started. The range in which Melee will not register\n"
 					"a directional input is -22 to +22. Anything outside that range\n"
-					"risks the game registering a non-neutral stick input.", currXfb);
+					"risks the game registering a non-neutral stick input.\n"
+					"Press L for the spectrum of the ringing after the release,\n"
+					"with its frequency, decay time and noise floor.", currXfb);
 			break;
 		case PIVOT:
 			printStr("PIVOT\n"
@@ -415,39 +424,380 @@ static void printInstructions(void *currXfb) {
 					"get polled between 23 and 64, or -23 and -64.\n"
 					"Less time in this range is better.", currXfb);
 			break;
+		case AUTO:
+			printStr("AUTO\n"
+					"The test is picked from the capture. A release from a held\n"
+					"position is a snapback, going past +64/-64 on one side is a\n"
+					"dashback, and going past it on one side then briefly the\n"
+					"other is a pivot. The results for that test are shown.", currXfb);
+			break;
 		default:
 			printStr("NO TEST SELECTED", currXfb);
 			break;
 	}
-	if (!buttonLock) {
-		if (*pressed & PAD_TRIGGER_Z) {
-			state = OSC_POST_SETUP;
-			buttonLock = true;
-			buttonPressCooldown = 5;
+	if (*pressed & PAD_TRIGGER_Z) {
+		state = OSC_POST_SETUP;
+	}
+}
+
+// 60 db from the top of the box to the bottom, two pixels per bin
+#define SPECTRUM_DB_RANGE 60
+static void drawSpectrum(void *currXfb) {
+	// the capture can't change while it's shown, switching sticks goes through captureChanged
+	if (!spectrumReady) {
+		PROFILE_BEGIN(PROFILE_ANALYSIS);
+		spectrum_analyze(data, showCStick, &spectrum);
+		PROFILE_END(PROFILE_ANALYSIS);
+		spectrumReady = true;
+	}
+
+	const int bottom = SCREEN_POS_CENTER_Y + 127;
+	DrawBox(SCREEN_TIMEPLOT_START - 1, SCREEN_POS_CENTER_Y - 128, SCREEN_TIMEPLOT_START + 500, SCREEN_POS_CENTER_Y + 128, COLOR_WHITE, currXfb);
+	// a mark every 50 hz
+	for (int hz = 50; spectrum_binHz(1) * 249 >= hz; hz += 50) {
+		int x = SCREEN_TIMEPLOT_START + (int) ((hz / spectrum_binHz(1)) * 2);
+		DrawVLine(x, bottom - 6, bottom, COLOR_GRAY, currXfb);
+	}
+
+	setCursorPos(3, 0);
+	sprintf(strBuffer, "%s %s spectrum | 0 - %0.0f Hz, 50 Hz marks, %d dB\n", showCStick ? "C-Stick" : "Stick",
+	        spectrum.yAxis ? "Y" : "X", spectrum_binHz(249), SPECTRUM_DB_RANGE);
+	printStr(strBuffer, currXfb);
+	if (!spectrum.found) {
+		setCursorPos(20, 0);
+		printStr("No release found in this capture.", currXfb);
+		return;
+	}
+
+	PROFILE_BEGIN(PROFILE_WAVEFORM);
+	for (int i = 0; i < 250; i++) {
+		int height = (int) (((spectrum.binDb[i] + SPECTRUM_DB_RANGE) * 255) / SPECTRUM_DB_RANGE);
+		if (height <= 0) {
+			continue;
 		}
+		if (height > 255) {
+			height = 255;
+		}
+		DrawVLine(SCREEN_TIMEPLOT_START + (i * 2), bottom - height, bottom,
+		          spectrum.yAxis ? COLOR_BLUE_C : COLOR_RED_C, currXfb);
+	}
+	PROFILE_END(PROFILE_WAVEFORM);
+
+	setCursorPos(20, 0);
+	sprintf(strBuffer, "Ringing: %0.1f Hz | Decay: ", spectrum.peakHz);
+	printStr(strBuffer, currXfb);
+	if (spectrum.decayMs != 0) {
+		sprintf(strBuffer, "%0.1f ms", spectrum.decayMs);
+	} else {
+		sprintf(strBuffer, "-");
 	}
+	printStr(strBuffer, currXfb);
+	sprintf(strBuffer, " | Noise: %0.0f dB", spectrum.noiseFloorDb);
+	printStr(strBuffer, currXfb);
 }
 
 // only run once
-static void setup(WaveformData *d, u32 *p, u32 *h) {
+static void setup(u32 *p, u32 *h) {
 	setSamplingRateHigh();
 	pressed = p;
 	held = h;
 	cb = PAD_SetSamplingCallback(oscilloscopeCallback);
 	state = OSC_POST_SETUP;
-	if(data == NULL) {
-		data = d;
-	}
 	if (data->isDataReady && oState == PRE_INPUT) {
 		oState = POST_INPUT_LOCK;
 	}
+	autoReportReady = false;
+	captureChanged();
+}
+
+// moves the selected cursor, and scrolls to keep it on screen
+static void moveCursor(int amount) {
+	int *cursor = (cursorMode == CURSOR_A) ? &cursorA : &cursorB;
+	*cursor += amount;
+	if (*cursor >= (int) data->endPoint) {
+		*cursor = data->endPoint - 1;
+	}
+	if (*cursor < 0) {
+		*cursor = 0;
+	}
+	if (*cursor < dataScrollOffset) {
+		dataScrollOffset = *cursor;
+	} else if (*cursor >= dataScrollOffset + 500) {
+		dataScrollOffset = *cursor - 499;
+	}
+}
+
+static void printCursorCoords(const char *name, bool selected, int cursor, void *currXfb) {
+	WaveformDatapoint melee = convertStickValues(&data->data[cursor]);
+	int x = showCStick ? melee.cx : melee.ax;
+	int y = showCStick ? melee.cy : melee.ay;
+	bool xNegative = showCStick ? melee.isCXNegative : melee.isAXNegative;
+	bool yNegative = showCStick ? melee.isCYNegative : melee.isAYNegative;
+	sprintf(strBuffer, "%s%s %d: %s%0.4f, %s%0.4f", selected ? "*" : "", name, cursor + 1,
+	        xNegative ? "-" : "", x / 10000.0f, yNegative ? "-" : "", y / 10000.0f);
+	printStr(strBuffer, currXfb);
+}
+
+// lines at both cursors and what's between them, instead of the totals and test results
+static void printTestName(enum OSCILLOSCOPE_TEST test, void *currXfb) {
+	switch (test) {
+		case SNAPBACK:
+			printStr("Snapback", currXfb);
+			break;
+		case PIVOT:
+			printStr("Pivot", currXfb);
+			break;
+		case DASHBACK:
+			printStr("Dashback", currXfb);
+			break;
+		case NO_TEST:
+			printStr("None", currXfb);
+			break;
+		case AUTO:
+			printStr("Auto", currXfb);
+			break;
+		default:
+			printStr("Error", currXfb);
+			break;
+	}
+}
+
+// adds the capture that was just kept to the session, as the selected test or whatever AUTO thinks it is
+static void addAttempt(const WaveformData *attempt) {
+	enum MOTION_TYPE test;
+	if (currentTest == AUTO) {
+		PROFILE_BEGIN(PROFILE_ANALYSIS);
+		test = analysis_classify(attempt, showCStick, NULL);
+		PROFILE_END(PROFILE_ANALYSIS);
+	} else {
+		test = (enum MOTION_TYPE) currentTest;
+	}
+	attempts_add(&session, attempt, showCStick, test, &lastAttempt);
+	if (sessionExportCode == 0) {
+		sessionExportCode = exportAttempt(&lastAttempt);
+	}
+}
+
+#define SESSION_BAR_WIDTH (500 / ATTEMPT_BINS)
+#define SESSION_HISTOGRAM_HEIGHT 120
+// totals for every test, and the histogram for the last one that was attempted
+static void drawSession(void *currXfb) {
+	setCursorPos(3, 0);
+	sprintf(strBuffer, "Practice session: %u attempts | ", session.attempts);
+	printStr(strBuffer, currXfb);
+	if (sessionExportCode == 0) {
+		printStr("Logging to SD", currXfb);
+	} else {
+		sprintf(strBuffer, "Not logged (error %d)", sessionExportCode);
+		printStr(strBuffer, currXfb);
+	}
+
+	DrawBox(SCREEN_TIMEPLOT_START - 1, SCREEN_POS_CENTER_Y - 128, SCREEN_TIMEPLOT_START + 500, SCREEN_POS_CENTER_Y + 128, COLOR_WHITE, currXfb);
+	setCursorPos(5, 8);
+	printStr("Test      Tries Success   Mean    SD  Range", currXfb);
+	for (int i = 0; i < ATTEMPT_TESTS; i++) {
+		const AttemptTotals *totals = &session.tests[i];
+		setCursorPos(6 + i, 8);
+		printTestName(i, currXfb);
+		setCursorPos(6 + i, 18);
+		if (totals->attempts == 0) {
+			printStr("    -", currXfb);
+			continue;
+		}
+		sprintf(strBuffer, "%5u %6.0f%%", totals->attempts, (100.0f * totals->successes) / totals->attempts);
+		printStr(strBuffer, currXfb);
+		if (totals->measured != 0) {
+			sprintf(strBuffer, " %6.1f %5.1f  %0.1f-%0.1f", totals->mean, attempts_stdDev(totals), totals->min, totals->max);
+			printStr(strBuffer, currXfb);
+		}
+	}
+	setCursorPos(9, 8);
+	sprintf(strBuffer, "Other: %u | Snapback in units, others in ms", session.unknown);
+	printStr(strBuffer, currXfb);
+
+	if (session.lastTest >= 0) {
+		const AttemptTotals *totals = &session.tests[session.lastTest];
+		setCursorPos(10, 8);
+		printTestName(session.lastTest, currXfb);
+		sprintf(strBuffer, " histogram, %0.0f %s bins, last one past %0.0f", ATTEMPT_BIN_WIDTH[session.lastTest],
+		        ATTEMPT_UNITS[session.lastTest], ATTEMPT_BIN_WIDTH[session.lastTest] * (ATTEMPT_BINS - 1));
+		printStr(strBuffer, currXfb);
+
+		uint32_t peak = 0;
+		for (int i = 0; i < ATTEMPT_BINS; i++) {
+			if (totals->histogram[i] > peak) {
+				peak = totals->histogram[i];
+			}
+		}
+		int lastBin = lastAttempt.measured ? attempts_bin(lastAttempt.test, lastAttempt.value) : -1;
+		const int bottom = SCREEN_POS_CENTER_Y + 126;
+		PROFILE_BEGIN(PROFILE_WAVEFORM);
+		for (int i = 0; i < ATTEMPT_BINS && peak != 0; i++) {
+			if (totals->histogram[i] == 0) {
+				continue;
+			}
+			int height = (totals->histogram[i] * SESSION_HISTOGRAM_HEIGHT) / peak;
+			int x = SCREEN_TIMEPLOT_START + (i * SESSION_BAR_WIDTH) + 2;
+			DrawFilledBox(x, bottom - height, x + SESSION_BAR_WIDTH - 5, bottom,
+			              i == lastBin ? COLOR_YELLOW : COLOR_TEAL, currXfb);
+		}
+		PROFILE_END(PROFILE_WAVEFORM);
+	}
+
+	if (session.attempts != 0) {
+		setCursorPos(20, 0);
+		sprintf(strBuffer, "Last: #%u ", lastAttempt.number);
+		printStr(strBuffer, currXfb);
+		printTestName((enum OSCILLOSCOPE_TEST) lastAttempt.test, currXfb);
+		if (lastAttempt.test != MOTION_NONE) {
+			if (lastAttempt.measured) {
+				sprintf(strBuffer, ", %0.1f %s", lastAttempt.value, ATTEMPT_UNITS[lastAttempt.test]);
+				printStr(strBuffer, currXfb);
+			}
+			printStr(lastAttempt.success ? ", success" : ", miss", currXfb);
+		}
+	}
+}
+
+static void drawCursors(void *currXfb) {
+	// a new capture can be shorter than the last one
+	if (cursorA >= (int) data->endPoint) {
+		cursorA = data->endPoint - 1;
+	}
+	if (cursorB >= (int) data->endPoint) {
+		cursorB = data->endPoint - 1;
+	}
+	if (!cursorIndexReady) {
+		PROFILE_BEGIN(PROFILE_ANALYSIS);
+		rangeindex_build(&cursorIndex, data, showCStick);
+		PROFILE_END(PROFILE_ANALYSIS);
+		cursorIndexReady = true;
+	}
+	if (cursorA >= dataScrollOffset && cursorA < dataScrollOffset + 500) {
+		DrawVLine(SCREEN_TIMEPLOT_START + ((cursorA - dataScrollOffset) * waveformScaleFactor),
+		          SCREEN_POS_CENTER_Y - 127, SCREEN_POS_CENTER_Y + 127, COLOR_AQUA, currXfb);
+	}
+	if (cursorB >= dataScrollOffset && cursorB < dataScrollOffset + 500) {
+		DrawVLine(SCREEN_TIMEPLOT_START + ((cursorB - dataScrollOffset) * waveformScaleFactor),
+		          SCREEN_POS_CENTER_Y - 127, SCREEN_POS_CENTER_Y + 127, COLOR_FUCHSIA, currXfb);
+	}
+
+	setCursorPos(3, 0);
+	printCursorCoords("A", cursorMode == CURSOR_A, cursorA, currXfb);
+	printStr(" | ", currXfb);
+	printCursorCoords("B", cursorMode == CURSOR_B, cursorB, currXfb);
+
+	RangeStats stats;
+	rangeindex_query(&cursorIndex, cursorA, cursorB, &stats);
+	int ax = showCStick ? data->data[cursorA].cx : data->data[cursorA].ax;
+	int ay = showCStick ? data->data[cursorA].cy : data->data[cursorA].ay;
+	int bx = showCStick ? data->data[cursorB].cx : data->data[cursorB].ax;
+	int by = showCStick ? data->data[cursorB].cy : data->data[cursorB].ay;
+	// signed, so it's negative when b is before a
+	float dt = (rangeindex_timeAt(&cursorIndex, cursorB) / 1000.0f) - (rangeindex_timeAt(&cursorIndex, cursorA) / 1000.0f);
+	setCursorPos(20, 0);
+	sprintf(strBuffer, "dt: %0.3f ms | dX: %d | dY: %d | Mean: %0.1f, %0.1f\n", dt, bx - ax, by - ay,
+	        stats.meanX, stats.meanY);
+	printStr(strBuffer, currXfb);
+	sprintf(strBuffer, "Min: %d, %d | Max: %d, %d | Up: next cursor", stats.minX, stats.minY, stats.maxX, stats.maxY);
+	printStr(strBuffer, currXfb);
+}
+
+// the reference under the capture, moved by the alignment, one point for each point of the capture that's drawn
+static void drawReference(void *currXfb, int drawEnd) {
+	const WaveformData *ref = reference_get();
+	int64_t timeUs = 0;
+	for (int i = 1; i <= dataScrollOffset; i++) {
+		timeUs += data->data[i].timeDiffUs;
+	}
+	unsigned int j = 0;
+	int64_t refTimeUs = 0;
+	bool started = false;
+	int prevX = 0, prevY = 0, prevPos = 0;
+	for (int i = dataScrollOffset; i < drawEnd; i++) {
+		if (i != dataScrollOffset) {
+			timeUs += data->data[i].timeDiffUs;
+		}
+		int64_t targetUs = timeUs + referenceDiff.lagUs;
+		// before the reference starts
+		if (targetUs < 0) {
+			continue;
+		}
+		while (j + 1 < ref->endPoint && refTimeUs + (int64_t) ref->data[j + 1].timeDiffUs <= targetUs) {
+			refTimeUs += ref->data[j + 1].timeDiffUs;
+			j++;
+		}
+		// past the end of it
+		if (j + 1 >= ref->endPoint) {
+			break;
+		}
+		int currX = showCStick ? ref->data[j].cx : ref->data[j].ax;
+		int currY = showCStick ? ref->data[j].cy : ref->data[j].ay;
+		int pos = (i - dataScrollOffset) * waveformScaleFactor;
+		if (started) {
+			DrawLine(SCREEN_TIMEPLOT_START + prevPos, SCREEN_POS_CENTER_Y - prevY,
+			         SCREEN_TIMEPLOT_START + pos, SCREEN_POS_CENTER_Y - currY, COLOR_NAVY, currXfb);
+			DrawLine(SCREEN_TIMEPLOT_START + prevPos, SCREEN_POS_CENTER_Y - prevX,
+			         SCREEN_TIMEPLOT_START + pos, SCREEN_POS_CENTER_Y - currX, COLOR_MAROON, currXfb);
+		}
+		started = true;
+		prevX = currX;
+		prevY = currY;
+		prevPos = pos;
+	}
+}
+
+// the result that matters most for the test, against the reference's
+static void printReferenceDiff(enum OSCILLOSCOPE_TEST test, void *currXfb) {
+	const ReferenceMetrics *curr = &referenceDiff.capture, *ref = &referenceDiff.reference;
+	switch (test) {
+		case SNAPBACK:
+			if (referenceDiff.yAxis) {
+				sprintf(strBuffer, " | vs ref: Y %+d, %+d", curr->range.minY - ref->range.minY, curr->range.maxY - ref->range.maxY);
+			} else {
+				sprintf(strBuffer, " | vs ref: X %+d, %+d", curr->range.minX - ref->range.minX, curr->range.maxX - ref->range.maxX);
+			}
+			break;
+		case PIVOT:
+			if (curr->pivotFound && ref->pivotFound) {
+				sprintf(strBuffer, " | vs ref: %+0.2f ms", curr->pivot.timeInRangeMs - ref->pivot.timeInRangeMs);
+			} else {
+				sprintf(strBuffer, " | vs ref: no pivot");
+			}
+			break;
+		case DASHBACK:
+			sprintf(strBuffer, " | vs ref: %+0.0f%%, UCF %+0.0f%%", curr->dashback.vanillaPercent - ref->dashback.vanillaPercent,
+			        curr->dashback.ucfPercent - ref->dashback.ucfPercent);
+			break;
+		default:
+			sprintf(strBuffer, " | vs ref: %+0.1f ms", ((int64_t) curr->durationUs - (int64_t) ref->durationUs) / 1000.0f);
+			break;
+	}
+	printStr(strBuffer, currXfb);
 }
 
 // function called from outside
-void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
+void menu_oscilloscope(void *currXfb, WaveformData *d, u32 *p, u32 *h) {
+	// the capture the callback just kept is left alone until the next one starts, after the cooldown
+	if (captureFinished) {
+		captureFinished = false;
+		if (sessionOn) {
+			addAttempt(capture);
+		}
+	}
+	// a new capture, or a different one from the history
+	if (d != data) {
+		data = d;
+		dataScrollOffset = 0;
+		captureChanged();
+		autoReportReady = false;
+		if (currentTest == AUTO) {
+			showSpectrum = false;
+		}
+	}
 	switch (state) {
 		case OSC_SETUP:
-			setup(data, p, h);
+			setup(p, h);
 			break;
 		case OSC_POST_SETUP:
 			switch (oState) {
@@ -464,25 +814,21 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 						ellipseCounter = 0;
 					}
 					
+					// a new capture is coming, whatever was decided for the last one is stale
+					captureChanged();
+					if (autoReportReady) {
+						autoReportReady = false;
+						if (currentTest == AUTO) {
+							showSpectrum = false;
+						}
+					}
+
+					if (sessionOn) {
+						drawSession(currXfb);
+					}
 					setCursorPos(21,0);
 					printStr("Current test: ", currXfb);
-					switch (currentTest) {
-						case SNAPBACK:
-							printStr("Snapback", currXfb);
-							break;
-						case PIVOT:
-							printStr("Pivot", currXfb);
-							break;
-						case DASHBACK:
-							printStr("Dashback", currXfb);
-							break;
-						case NO_TEST:
-							printStr("None", currXfb);
-							break;
-						default:
-							printStr("Error", currXfb);
-							break;
-					}
+					printTestName(currentTest, currXfb);
 					break;
 				case POST_INPUT_LOCK:
 					// dont allow new input until cooldown elapses
@@ -496,13 +842,46 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 						printStrColor("LOCKED", currXfb, COLOR_WHITE, COLOR_BLACK);
 					}
 				case POST_INPUT:
-					if (data->isDataReady) {
+					if (data->isDataReady && sessionOn) {
+						drawSession(currXfb);
+						setCursorPos(21, 0);
+						printStr("Current test: ", currXfb);
+						printTestName(currentTest, currXfb);
+						printStr(" | R+Z ends the session", currXfb);
+					} else if (data->isDataReady && showSpectrum) {
+						drawSpectrum(currXfb);
+					} else if (data->isDataReady) {
+						// the test to show results for, AUTO decides once per capture
+						enum OSCILLOSCOPE_TEST shownTest = currentTest;
+						if (currentTest == AUTO) {
+							if (!autoReportReady) {
+								PROFILE_BEGIN(PROFILE_ANALYSIS);
+								analysis_runAll(data, showCStick, &autoReport);
+								PROFILE_END(PROFILE_ANALYSIS);
+								autoReportReady = true;
+								// label it, so exports and the capture browser know what it was
+								if (data->testType == AUTO || data->testType < 0) {
+									data->testType = autoReport.motion;
+								}
+							}
+							shownTest = (enum OSCILLOSCOPE_TEST) autoReport.motion;
+						}
+
+						bool hasReference = reference_get() != NULL;
+						if (hasReference && (!referenceDiffReady || referenceDiffGeneration != reference_generation())) {
+							PROFILE_BEGIN(PROFILE_ANALYSIS);
+							reference_compare(data, showCStick, &referenceDiff);
+							PROFILE_END(PROFILE_ANALYSIS);
+							referenceDiffReady = true;
+							referenceDiffGeneration = reference_generation();
+						}
+
 						// draw guidelines based on selected test
 						DrawBox(SCREEN_TIMEPLOT_START - 1, SCREEN_POS_CENTER_Y - 128, SCREEN_TIMEPLOT_START + 500, SCREEN_POS_CENTER_Y + 128, COLOR_WHITE, currXfb);
 						DrawHLine(SCREEN_TIMEPLOT_START, SCREEN_TIMEPLOT_START + 500, SCREEN_POS_CENTER_Y, COLOR_GRAY, currXfb);
 						// lots of the specific values are taken from:
 						// https://github.com/PhobGCC/PhobGCC-doc/blob/main/For_Users/Phobvision_Guide_Latest.md
-						switch (currentTest) {
+						switch (shownTest) {
 							case PIVOT:
 								DrawHLine(SCREEN_TIMEPLOT_START, SCREEN_TIMEPLOT_START + 500, SCREEN_POS_CENTER_Y + 64, COLOR_GREEN, currXfb);
 								DrawHLine(SCREEN_TIMEPLOT_START, SCREEN_TIMEPLOT_START + 500, SCREEN_POS_CENTER_Y - 64, COLOR_GREEN, currXfb);
@@ -529,9 +908,6 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 								break;
 						}
 
-						int minX, minY;
-						int maxX, maxY;
-
 						// show all data if it will fit
 						if (data->endPoint < 500) {
 							dataScrollOffset = 0;
@@ -540,20 +916,26 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 							dataScrollOffset = data->endPoint - 501;
 						}
 
+						if (hasReference) {
+							PROFILE_BEGIN(PROFILE_WAVEFORM);
+							drawReference(currXfb, data->endPoint < dataScrollOffset + 500 ? data->endPoint : dataScrollOffset + 500);
+							PROFILE_END(PROFILE_WAVEFORM);
+							setCursorPos(2, 0);
+							sprintf(strBuffer, "Ref: %+0.1f ms, %0.0f%% match", referenceDiff.lagUs / 1000.0f, referenceDiff.match * 100);
+							printStr(strBuffer, currXfb);
+						}
+
 						int prevX = data->data[dataScrollOffset].ax;
 						int prevY = data->data[dataScrollOffset].ay;
-
-						// initialize stat values to first point
-						minX = prevX;
-						maxX = prevX;
-						minY = prevY;
-						maxY = prevY;
+						// one past the last point drawn, for the snapback stats
+						int drawnEnd = dataScrollOffset + 1;
 
 						int waveformPrevXPos = 0;
 						int waveformXPos = waveformScaleFactor;
 						u64 drawnTicksUs = 0;
 
 						// draw 500 datapoints from the scroll offset
+						PROFILE_BEGIN(PROFILE_WAVEFORM);
 						for (int i = dataScrollOffset + 1; i < dataScrollOffset + 500; i++) {
 							// make sure we haven't gone outside our bounds
 							if (i == data->endPoint || waveformXPos >= 500) {
@@ -579,20 +961,7 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 									SCREEN_TIMEPLOT_START + waveformXPos, SCREEN_POS_CENTER_Y - currX,
 									COLOR_RED_C, currXfb);
 							prevX = currX;
-
-							// update stat values
-							if (minX > prevX) {
-								minX = prevX;
-							}
-							if (maxX < prevX) {
-								maxX = prevX;
-							}
-							if (minY > prevY) {
-								minY = prevY;
-							}
-							if (maxY < prevY) {
-								maxY = prevY;
-							}
+							drawnEnd = i + 1;
 
 							// adding time from drawn points, to show how long the current view is
 							drawnTicksUs += data->data[i].timeDiffUs;
@@ -601,10 +970,19 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 							waveformPrevXPos = waveformXPos;
 							waveformXPos += waveformScaleFactor;
 						}
+						PROFILE_END(PROFILE_WAVEFORM);
 
+						// the d-pad moves the cursor instead of the view while there is one
+						if (cursorMode != CURSOR_OFF) {
+							if (*held & PAD_BUTTON_RIGHT) {
+								moveCursor((*held & PAD_TRIGGER_R) ? 10 : 1);
+							} else if (*held & PAD_BUTTON_LEFT) {
+								moveCursor((*held & PAD_TRIGGER_R) ? -10 : -1);
+							}
+							drawCursors(currXfb);
 						// do we have enough data to enable scrolling?
 						// TODO: enable scrolling when scaled
-						if (data->endPoint >= 500 ) {
+						} else if (data->endPoint >= 500 ) {
 							// does the user want to scroll the waveform?
 							if (*held & PAD_BUTTON_RIGHT) {
 								if (*held & PAD_TRIGGER_R) {
@@ -629,211 +1007,72 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 							}
 						}
 
-						setCursorPos(3, 0);
-						// total time is stored in microseconds, divide by 1000 for milliseconds
-						if (!showCStick) {
-							printStr("Stick ", currXfb);
-						} else {
-							printStr("C-Stick ", currXfb);
-						}
-						sprintf(strBuffer, "total: %u, %0.3f ms | Start: %d, Shown: %0.3f ms\n", data->endPoint, (data->totalTimeUs / ((float) 1000)), dataScrollOffset + 1, (drawnTicksUs / ((float) 1000)));
-						printStr(strBuffer, currXfb);
-
-						// print test data
-						setCursorPos(20, 0);
-						switch (currentTest) {
-							case SNAPBACK:
-								sprintf(strBuffer, "Min X: %04d | Min Y: %04d   |   ", minX, minY);
-								printStr(strBuffer, currXfb);
-								sprintf(strBuffer, "Max X: %04d | Max Y: %04d\n", maxX, maxY);
-								printStr(strBuffer, currXfb);
-								break;
-							case PIVOT:
-								bool pivotHit80 = false;
-								bool prevPivotHit80 = false;
-								bool leftPivotRange = false;
-								bool prevLeftPivotRange = false;
-								int pivotStartIndex = -1, pivotEndIndex = -1;
-								int pivotStartSign = 0;
-								// start from the back of the list
-								for (int i = data->endPoint - 1; i >= 0; i--) {
-									// check x coordinate for +-64 (dash threshold)
-									if ( (data->data[i].ax >= 64 || data->data[i].ax <= -64) && !leftPivotRange) {
-										if (pivotEndIndex == -1) {
-											pivotEndIndex = i;
-										}
-										// pivot input must hit 80 on both sides
-										if (data->data[i].ax >= 80 || data->data[i].ax <= -80) {
-											pivotHit80 = true;
-										}
-									}
-
-									// are we outside the pivot range and have already logged data of being in range
-									if (pivotEndIndex != -1 && data->data[i].ax < 64 && data->data[i].ax > -64) {
-										leftPivotRange = true;
-										if (pivotStartIndex == -1) {
-											// need the "previous" poll since this one is out of the range
-											pivotStartIndex = i + 1;
-										}
-										if (prevLeftPivotRange || !pivotHit80) {
-											break;
-										}
-									}
-
-									// look for the initial input
-									if ( (data->data[i].ax >= 64 || data->data[i].ax <= -64) && leftPivotRange) {
-										// used to ensure starting input is from the opposite side
-										if (pivotStartSign == 0) {
-											pivotStartSign = data->data[i].ax;
-										}
-										prevLeftPivotRange = true;
-										if (data->data[i].ax >= 80 || data->data[i].ax <= -80) {
-											prevPivotHit80 = true;
-											break;
-										}
-									}
-								}
-
-								// phobvision doc says both sides need to hit 80 to succeed
-								// multiplication is to ensure signs are correct
-								if (prevPivotHit80 && pivotHit80 && (data->data[pivotEndIndex].ax * pivotStartSign < 0)) {
-									float noTurnPercent = 0;
-									float pivotPercent = 0;
-									float dashbackPercent = 0;
-
-									u64 timeInPivotRangeUs = 0;
-									for (int i = pivotStartIndex; i <= pivotEndIndex; i++) {
-										timeInPivotRangeUs += data->data[i].timeDiffUs;
-									}
-
-									// convert time to float in milliseconds
-									float timeInPivotRangeMs = (timeInPivotRangeUs / 1000.0);
-
-									// TODO: i think the calculation can be simplified here...
-									// how many milliseconds could a poll occur that would cause a miss
-									float diffFrameTimePoll = FRAME_TIME_MS - timeInPivotRangeMs;
-
-									// negative time difference, dashback
-									if (diffFrameTimePoll < 0) {
-										dashbackPercent = ((diffFrameTimePoll * -1) / FRAME_TIME_MS) * 100;
-										if (dashbackPercent > 100) {
-											dashbackPercent = 100;
-										}
-										pivotPercent = 100 - dashbackPercent;
-										// positive or 0 time diff, no turn
-									} else {
-										noTurnPercent = (diffFrameTimePoll / FRAME_TIME_MS) * 100;
-										if (noTurnPercent > 100) {
-											noTurnPercent = 100;
-										}
-										pivotPercent = 100 - noTurnPercent;
-									}
+						// the cursors have their own readouts
+						if (cursorMode == CURSOR_OFF) {
+							setCursorPos(3, 0);
+							// total time is stored in microseconds, divide by 1000 for milliseconds
+							if (!showCStick) {
+								printStr("Stick ", currXfb);
+							} else {
+								printStr("C-Stick ", currXfb);
+							}
+							sprintf(strBuffer, "total: %u, %0.3f ms | Start: %d, Shown: %0.3f ms\n", data->endPoint, (data->totalTimeUs / ((float) 1000)), dataScrollOffset + 1, (drawnTicksUs / ((float) 1000)));
+							printStr(strBuffer, currXfb);
 
-									sprintf(strBuffer, "MS: %2.2f | No turn: %2.0f%% | Pivot: %2.0f%% | Dashback: %2.0f%%",
-											timeInPivotRangeMs, noTurnPercent, pivotPercent, dashbackPercent);
+							// print test data
+							setCursorPos(20, 0);
+							PROFILE_BEGIN(PROFILE_ANALYSIS);
+							switch (shownTest) {
+								case SNAPBACK:
+									// only over what's on screen
+									StickRange range;
+									analysis_stickRange(data, dataScrollOffset, drawnEnd, showCStick, &range);
+									sprintf(strBuffer, "Min X: %04d | Min Y: %04d   |   ", range.minX, range.minY);
 									printStr(strBuffer, currXfb);
-									//printf("\nUS Total: %llu, Start index: %d, End index: %d", timeInPivotRangeUs, pivotStartIndex, pivotEndIndex);
-								} else {
-									printStr("No pivot input detected.", currXfb);
-								}
-								break;
-							case DASHBACK:
-								// go forward in list
-								int dashbackStartIndex = -1, dashbackEndIndex = -1;
-								u64 timeInRange = 0;
-								for (int i = 0; i < data->endPoint; i++) {
-									// is the stick in the range
-									if ((data->data[i].ax >= 23 && data->data[i].ax < 64) || (data->data[i].ax <= -23 && data->data[i].ax > -64)) {
-										timeInRange += data->data[i].timeDiffUs;
-										if (dashbackStartIndex == -1) {
-											dashbackStartIndex = i;
-										}
-									} else if (dashbackStartIndex != -1) {
-										dashbackEndIndex = i - 1;
-										break;
-									}
-								}
-								float dashbackPercent;
-								float ucfPercent;
-
-								if (dashbackEndIndex == -1) {
-									dashbackPercent = 0;
-									ucfPercent = 0;
-								} else {
-									// convert time in microseconds to float time in milliseconds
-									float timeInRangeMs = (timeInRange / 1000.0);
-
-									dashbackPercent = (1.0 - (timeInRangeMs / FRAME_TIME_MS)) * 100;
-
-									// ucf dashback is a little more involved
-									u64 ucfTimeInRange = timeInRange;
-									for (int i = dashbackStartIndex; i <= dashbackEndIndex; i++) {
-										// we're gonna assume that the previous frame polled around the origin, because i cant be bothered
-										// it also makes the math easier
-										u64 usFromPoll = 0;
-										int nextPollIndex = i;
-										// we need the sample that would occur around 1f after
-										while (usFromPoll < 16666) {
-											nextPollIndex++;
-											usFromPoll += data->data[nextPollIndex].timeDiffUs;
-										}
-										// the two frames need to move more than 75 units for UCF to convert it
-										if (data->data[i].ax + data->data[nextPollIndex].ax > 75 ||
-												data->data[i].ax + data->data[nextPollIndex].ax < -75) {
-											ucfTimeInRange -= data->data[i].timeDiffUs;
-										}
+									sprintf(strBuffer, "Max X: %04d | Max Y: %04d\n", range.maxX, range.maxY);
+									printStr(strBuffer, currXfb);
+									break;
+								case PIVOT:
+									PivotResult pivot = autoReport.pivot;
+									bool pivotFound = autoReport.pivotFound;
+									if (currentTest != AUTO) {
+										pivotFound = analysis_pivot(data, &pivot);
 									}
-
-									float ucfTimeInRangeMs = ucfTimeInRange / 1000.0;
-									if (ucfTimeInRangeMs <= 0) {
-										ucfPercent = 100;
+									if (pivotFound) {
+										sprintf(strBuffer, "MS: %2.2f | No turn: %2.0f%% | Pivot: %2.0f%% | Dashback: %2.0f%%",
+												pivot.timeInRangeMs, pivot.noTurnPercent, pivot.pivotPercent, pivot.dashbackPercent);
+										printStr(strBuffer, currXfb);
 									} else {
-										ucfPercent = (1.0 - (ucfTimeInRangeMs / FRAME_TIME_MS)) * 100;
-									}
-
-									// this shouldn't happen in theory, maybe on box?
-									if (dashbackPercent > 100) {
-										dashbackPercent = 100;
+										printStr("No pivot input detected.", currXfb);
 									}
-									if (ucfPercent > 100) {
-										ucfPercent = 100;
-									}
-									// this definitely can happen though
-									if (dashbackPercent < 0) {
-										dashbackPercent = 0;
-									}
-									if (ucfPercent < 0) {
-										ucfPercent = 0;
+									break;
+								case DASHBACK:
+									DashbackResult dashback = autoReport.dashback;
+									if (currentTest != AUTO) {
+										analysis_dashback(data, &dashback);
 									}
-								}
-								sprintf(strBuffer, "Vanilla Success: %2.0f%% | UCF Success: %2.0f%%", dashbackPercent, ucfPercent);
-								printStr(strBuffer, currXfb);
-								break;
-							case NO_TEST:
-								break;
-							default:
-								printStr("Error?", currXfb);
-								break;
+									sprintf(strBuffer, "Vanilla Success: %2.0f%% | UCF Success: %2.0f%%", dashback.vanillaPercent, dashback.ucfPercent);
+									printStr(strBuffer, currXfb);
+									break;
+								case NO_TEST:
+									break;
+								default:
+									printStr("Error?", currXfb);
+									break;
 
-						}
-						setCursorPos(21,0);
-						printStr("Current test: ", currXfb);
-						switch (currentTest) {
-							case SNAPBACK:
-								printStr("Snapback", currXfb);
-								break;
-							case PIVOT:
-								printStr("Pivot", currXfb);
-								break;
-							case DASHBACK:
-								printStr("Dashback", currXfb);
-								break;
-							case NO_TEST:
-								printStr("None", currXfb);
-								break;
-							default:
-								printStr("Error", currXfb);
-								break;
+							}
+							PROFILE_END(PROFILE_ANALYSIS);
+							setCursorPos(21,0);
+							printStr("Current test: ", currXfb);
+							printTestName(currentTest, currXfb);
+							if (currentTest == AUTO) {
+								printStr(" (", currXfb);
+								printTestName(shownTest, currXfb);
+								printStr(")", currXfb);
+							}
+							if (hasReference) {
+								printReferenceDiff(shownTest, currXfb);
+							}
 						}
 					} else {
 						oState = PRE_INPUT;
@@ -843,38 +1082,73 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 					printStr("How did we get here?", currXfb);
 					break;
 			}
-			if (!buttonLock) {
-				if (*pressed & PAD_BUTTON_A && !buttonLock && oState != PRE_INPUT) {
-					if (oState == POST_INPUT_LOCK && stickCooldown == 0) {
-						oState = POST_INPUT;
-					} else {
-						oState = POST_INPUT_LOCK;
-					}
-					buttonLock = true;
-					buttonPressCooldown = 5;
+			if (*pressed & PAD_BUTTON_A && oState != PRE_INPUT) {
+				if (oState == POST_INPUT_LOCK && stickCooldown == 0) {
+					oState = POST_INPUT;
+				} else {
+					oState = POST_INPUT_LOCK;
 				}
-				if (*pressed & PAD_BUTTON_X && !buttonLock && !stickMove) {
-					currentTest++;
-					// check if we overrun our test length
-					if (currentTest == OSCILLOSCOPE_TEST_LEN) {
-						currentTest = SNAPBACK;
+			}
+			if (*pressed & PAD_BUTTON_X && !stickMove) {
+				currentTest++;
+				// check if we overrun our test length
+				if (currentTest == OSCILLOSCOPE_TEST_LEN) {
+					currentTest = SNAPBACK;
+				}
+				if (showCStick && (currentTest != SNAPBACK && currentTest < NO_TEST)) {
+					currentTest = NO_TEST;
+				}
+				showSpectrum = false;
+			}
+			if (*pressed & PAD_TRIGGER_L && (currentTest == SNAPBACK ||
+			    (currentTest == AUTO && autoReportReady && autoReport.motion == MOTION_SNAPBACK))) {
+				showSpectrum = !showSpectrum;
+			}
+			// a fresh session each time one starts
+			if (*pressed & PAD_TRIGGER_Z && *held & PAD_TRIGGER_R) {
+				sessionOn = !sessionOn;
+				if (sessionOn) {
+					attempts_reset(&session);
+					sessionExportCode = startAttemptExport();
+				}
+			} else if (*pressed & PAD_TRIGGER_Z) {
+				state = OSC_INSTRUCTIONS;
+			}
+			// older captures with start, newer ones with R held
+			if (*pressed & PAD_BUTTON_START && oState != PRE_INPUT) {
+				history_step((*held & PAD_TRIGGER_R) ? -1 : 1);
+			}
+			// pins the capture as the reference, or unpins it
+			if (*pressed & PAD_BUTTON_DOWN && data->isDataReady) {
+				if (reference_get() != NULL) {
+					reference_clear();
+				} else {
+					reference_pin(data);
+				}
+			}
+			if (*pressed & PAD_BUTTON_UP && data->isDataReady && !showSpectrum) {
+				cursorMode = (cursorMode + 1) % CURSOR_MODE_LEN;
+				// start them a little way into what's on screen
+				if (cursorMode == CURSOR_A) {
+					cursorA = dataScrollOffset + 100;
+					cursorB = dataScrollOffset + 400;
+					if (cursorB >= (int) data->endPoint) {
+						cursorB = data->endPoint - 1;
 					}
-					if (showCStick && (currentTest != SNAPBACK && currentTest < NO_TEST)) {
-						currentTest = NO_TEST;
+					if (cursorA > cursorB) {
+						cursorA = cursorB / 4;
 					}
-					buttonLock = true;
-					buttonPressCooldown = 5;
 				}
-				if (*pressed & PAD_TRIGGER_Z && !buttonLock) {
-					state = OSC_INSTRUCTIONS;
-					buttonLock = true;
-					buttonPressCooldown = 5;
-				}
-				if (*pressed & PAD_BUTTON_Y && !buttonLock && !stickMove) {
-					showCStick = !showCStick;
+			}
+			if (*pressed & PAD_BUTTON_Y && !stickMove) {
+				showCStick = !showCStick;
+				captureChanged();
+				// the classification depends on which stick is shown
+				if (currentTest == AUTO) {
+					autoReportReady = false;
+					showSpectrum = false;
+				} else {
 					currentTest = SNAPBACK;
-					buttonLock = true;
-					buttonPressCooldown = 5;
 				}
 			}
 			// adjust scaling factor
@@ -891,16 +1165,6 @@ void menu_oscilloscope(void *currXfb, WaveformData *data, u32 *p, u32 *h) {
 			printStr("How did we get here?", currXfb);
 			break;
 	}
-	if (buttonLock) {
-		// don't allow button press until a number of frames has passed
-		if (buttonPressCooldown > 0) {
-			buttonPressCooldown--;
-		} else {
-			if ((*held) == 0) {
-				buttonLock = 0;
-			}
-		}
-	}
 }
 
 void menu_oscilloscopeEnd() {
@@ -7,14 +7,16 @@
 
 #include <gccore.h>
 #include "../waveform.h"
-
-static const float FRAME_TIME_MS = (1000/60.0);
+#include "../analysis/analysis.h"
+#include "../analysis/spectrum.h"
+#include "../analysis/rangeindex.h"
 
 enum OSC_MENU_STATE { OSC_SETUP, OSC_POST_SETUP, OSC_INSTRUCTIONS };
 enum OSC_STATE { PRE_INPUT, POST_INPUT, POST_INPUT_LOCK };
 
-static const u8 OSCILLOSCOPE_TEST_LEN = 4;
-enum OSCILLOSCOPE_TEST { SNAPBACK, PIVOT, DASHBACK, NO_TEST };
+static const u8 OSCILLOSCOPE_TEST_LEN = 5;
+// AUTO captures the same way SNAPBACK does, then picks one of the others from what the capture looks like
+enum OSCILLOSCOPE_TEST { SNAPBACK, PIVOT, DASHBACK, NO_TEST, AUTO };
 
 void menu_oscilloscope(void *currXfb, WaveformData *d, u32 *p, u32 *h);
 void menu_oscilloscopeEnd();
@@ -0,0 +1,242 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "phosphor.h"
+#include <stdio.h>
+#include <ogc/color.h>
+#include "../print.h"
+#include "../draw.h"
+#include "../polling.h"
+#include "../input.h"
+#include "../hitmap.h"
+#include "../analysis/notch.h"
+
+// stick positions waiting to be added to the map, must be a power of two
+#define PHOSPHOR_QUEUE_LEN 4096
+
+// top left of the plot, stick (-128, 127)
+#define PHOSPHOR_X (COORD_CIRCLE_CENTER_X - 128)
+#define PHOSPHOR_Y (SCREEN_POS_CENTER_Y - 127)
+
+enum PHOSPHOR_DECAY { DECAY_OFF, DECAY_SLOW, DECAY_FAST, DECAY_LEN };
+static const char *DECAY_NAMES[DECAY_LEN] = { "Off", "Slow", "Fast" };
+// applied once a frame, slow halves a count in about a second and a half, fast in about a fifth of a second
+static const u8 DECAY_SHIFT[DECAY_LEN] = { 0, 7, 4 };
+
+static const char *STYLE_NAMES[HITMAP_STYLE_LEN] = { "Intensity", "Heat" };
+
+// notches listed under the stats, the rest still count for the gate
+#define PHOSPHOR_NOTCH_ROWS 7
+// stickmap letter for enum STICKMAP_FF_WD_ENUM
+static const char FFWD_CHARS[] = { ' ', 'S', 'U' };
+
+typedef struct PhosphorSample {
+	s8 x;
+	s8 y;
+} PhosphorSample;
+
+static enum PHOSPHOR_MENU_STATE state = PHOSPHOR_SETUP;
+
+static HitMap map;
+static u32 palette[HITMAP_LEVELS];
+static enum HITMAP_STYLE style = HITMAP_INTENSITY;
+static enum PHOSPHOR_DECAY decay = DECAY_OFF;
+static bool showCStick = false;
+static bool showGate = true;
+
+static NotchTracker notches;
+static NotchResult notchResults[NOTCH_MAX_CLUSTERS];
+static GateFit gateFit;
+
+static char strBuffer[100];
+
+// filled by the callback, drained into the map once per frame
+static volatile PhosphorSample queue[PHOSPHOR_QUEUE_LEN];
+static volatile u32 writeIndex = 0;
+static volatile u32 readIndex = 0;
+static volatile u32 dropped = 0;
+
+static u32 *pressed;
+static u32 *held;
+
+static sampling_callback cb;
+static void phosphorCallback() {
+	PAD_ScanPads();
+
+	// queue button changes for the menu code
+	input_update();
+
+	u32 currWrite = writeIndex;
+	if (currWrite - readIndex >= PHOSPHOR_QUEUE_LEN) {
+		dropped++;
+		return;
+	}
+	volatile PhosphorSample *sample = &queue[currWrite & (PHOSPHOR_QUEUE_LEN - 1)];
+	if (showCStick) {
+		sample->x = PAD_SubStickX(0);
+		sample->y = PAD_SubStickY(0);
+	} else {
+		sample->x = PAD_StickX(0);
+		sample->y = PAD_StickY(0);
+	}
+	writeIndex = currWrite + 1;
+}
+
+static void resetMap() {
+	hitmap_clear(&map);
+	notch_reset(&notches);
+	readIndex = writeIndex;
+	dropped = 0;
+}
+
+static void setup(u32 *p, u32 *h) {
+	pressed = p;
+	held = h;
+	hitmap_buildPalette(palette, style);
+	resetMap();
+	setSamplingRateHigh();
+	cb = PAD_SetSamplingCallback(phosphorCallback);
+	state = PHOSPHOR_POST_SETUP;
+}
+
+// add everything the callback has queued since the last frame
+static void drainQueue() {
+	u32 currRead = readIndex;
+	u32 currWrite = writeIndex;
+	while (currRead != currWrite) {
+		PhosphorSample sample = queue[currRead & (PHOSPHOR_QUEUE_LEN - 1)];
+		hitmap_add(&map, sample.x, sample.y);
+		notch_add(&notches, sample.x, sample.y);
+		currRead++;
+	}
+	readIndex = currRead;
+}
+
+// the same 256x256 walk every frame, however many samples are in the map
+static void drawMap(void *currXfb) {
+	for (int row = 0; row < HITMAP_SIZE; row++) {
+		const u32 *hits = map.hits[row];
+		// interlaced drawing writes two pixels at a time, so each pair shows the brighter of the two
+		for (int col = 0; col < HITMAP_SIZE; col += 2) {
+			u32 count = hits[col] > hits[col + 1] ? hits[col] : hits[col + 1];
+			if (count == 0) {
+				continue;
+			}
+			u32 color = palette[hitmap_level(&map, count) - 1];
+			DrawDot(PHOSPHOR_X + col, PHOSPHOR_Y + row, color, currXfb);
+			DrawDot(PHOSPHOR_X + col + 1, PHOSPHOR_Y + row, color, currXfb);
+		}
+	}
+}
+
+// the fitted gate outline, and a box on each notch
+static void drawGate(int notchCount, void *currXfb) {
+	for (int i = 0; i < NOTCH_GATE_VERTICES; i++) {
+		GateVertex *curr = &gateFit.vertices[i];
+		GateVertex *next = &gateFit.vertices[(i + 1) % NOTCH_GATE_VERTICES];
+		if (!curr->found || !next->found) {
+			continue;
+		}
+		DrawLine(COORD_CIRCLE_CENTER_X + curr->x, SCREEN_POS_CENTER_Y - curr->y,
+		         COORD_CIRCLE_CENTER_X + next->x, SCREEN_POS_CENTER_Y - next->y, COLOR_YELLOW, currXfb);
+	}
+	for (int i = 0; i < notchCount; i++) {
+		DrawBox(COORD_CIRCLE_CENTER_X + (int) notchResults[i].x - 2, SCREEN_POS_CENTER_Y - (int) notchResults[i].y - 2,
+		        COORD_CIRCLE_CENTER_X + (int) notchResults[i].x + 2, SCREEN_POS_CENTER_Y - (int) notchResults[i].y + 2,
+		        COLOR_AQUA, currXfb);
+	}
+}
+
+static void printNotches(int notchCount, void *currXfb) {
+	setCursorPos(12, 0);
+	if (gateFit.binsUsed != 0) {
+		sprintf(strBuffer, "Gate: %0.1f avg %0.1f max\n", gateFit.meanError, gateFit.maxError);
+	} else {
+		sprintf(strBuffer, "Gate: -\n");
+	}
+	printStr(strBuffer, currXfb);
+	printStr("Notch    X      Y\n", currXfb);
+	for (int i = 0; i < notchCount && i < PHOSPHOR_NOTCH_ROWS; i++) {
+		NotchResult *curr = &notchResults[i];
+		sprintf(strBuffer, "%5.1f %6.4f %6.4f %c\n", curr->angle, curr->meleeX / 10000.0, curr->meleeY / 10000.0,
+		        FFWD_CHARS[curr->ffwd]);
+		printStr(strBuffer, currXfb);
+	}
+}
+
+void menu_phosphorPlot(void *currXfb, u32 *p, u32 *h) {
+	switch (state) {
+		case PHOSPHOR_SETUP:
+			setup(p, h);
+			break;
+		case PHOSPHOR_POST_SETUP:
+			drainQueue();
+			if (decay != DECAY_OFF) {
+				hitmap_decay(&map, DECAY_SHIFT[decay]);
+			}
+
+			setCursorPos(3, 0);
+			sprintf(strBuffer, "%s\n", showCStick ? "C-Stick" : "Analog Stick");
+			printStr(strBuffer, currXfb);
+			sprintf(strBuffer, "Samples: %llu\n", map.samples);
+			printStr(strBuffer, currXfb);
+			sprintf(strBuffer, "Coordinates: %u\n", map.used);
+			printStr(strBuffer, currXfb);
+			sprintf(strBuffer, "Peak hits: %u\n", map.peak >> HITMAP_FRAC_BITS);
+			printStr(strBuffer, currXfb);
+			sprintf(strBuffer, "Dropped: %u\n\n", dropped);
+			printStr(strBuffer, currXfb);
+			sprintf(strBuffer, "Colors: %s\n", STYLE_NAMES[style]);
+			printStr(strBuffer, currXfb);
+			sprintf(strBuffer, "Decay: %s\n", DECAY_NAMES[decay]);
+			printStr(strBuffer, currXfb);
+
+			// scale along the left edge of the plot, dimmest at the bottom
+			for (int i = 0; i < HITMAP_LEVELS; i++) {
+				int y = PHOSPHOR_Y + 255 - (i * 8);
+				DrawFilledBox(PHOSPHOR_X - 20, y - 7, PHOSPHOR_X - 12, y, palette[i], currXfb);
+			}
+
+			DrawBox(PHOSPHOR_X - 1, PHOSPHOR_Y - 1, PHOSPHOR_X + 256, PHOSPHOR_Y + 256, COLOR_WHITE, currXfb);
+			DrawOctagonalGate(COORD_CIRCLE_CENTER_X, SCREEN_POS_CENTER_Y, 1, COLOR_GRAY, currXfb);
+			drawMap(currXfb);
+
+			notch_fitGate(&notches, &gateFit);
+			int notchCount = notch_results(&notches, notchResults, NOTCH_MAX_CLUSTERS);
+			if (showGate) {
+				drawGate(notchCount, currXfb);
+			}
+			printNotches(notchCount, currXfb);
+
+			setCursorPos(21, 0);
+			printStr("X: colors | Y: switch stick | R: decay | A: clear | L: gate", currXfb);
+
+			if (*pressed & PAD_BUTTON_X) {
+				style = (style + 1) % HITMAP_STYLE_LEN;
+				hitmap_buildPalette(palette, style);
+			}
+			if (*pressed & PAD_BUTTON_Y) {
+				showCStick = !showCStick;
+				resetMap();
+			}
+			if (*pressed & PAD_TRIGGER_R) {
+				decay = (decay + 1) % DECAY_LEN;
+			}
+			if (*pressed & PAD_BUTTON_A) {
+				resetMap();
+			}
+			if (*pressed & PAD_TRIGGER_L) {
+				showGate = !showGate;
+			}
+			break;
+	}
+}
+
+void menu_phosphorPlotEnd() {
+	setSamplingRateNormal();
+	PAD_SetSamplingCallback(cb);
+	pressed = NULL;
+	held = NULL;
+	state = PHOSPHOR_SETUP;
+}
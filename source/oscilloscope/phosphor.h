@@ -0,0 +1,15 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_PHOSPHOR_H
+#define GTS_PHOSPHOR_H
+
+#include <gccore.h>
+
+enum PHOSPHOR_MENU_STATE { PHOSPHOR_SETUP, PHOSPHOR_POST_SETUP };
+
+void menu_phosphorPlot(void *currXfb, u32 *p, u32 *h);
+void menu_phosphorPlotEnd();
+
+#endif //GTS_PHOSPHOR_H
@@ -0,0 +1,230 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "record.h"
+#include <stdio.h>
+#include <ogc/lwp.h>
+#include <ogc/color.h>
+#include <ogc/lwp_watchdog.h>
+#include "../print.h"
+#include "../polling.h"
+#include "../input.h"
+#include "../recorder.h"
+#include "../file/file.h"
+
+// the writer only needs to run while the main thread is waiting on vsync
+#define RECORD_WRITER_PRIORITY 50
+#define RECORD_WRITER_STACK_SIZE (16 * 1024)
+
+static enum RECORD_MENU_STATE state = REC_SETUP;
+
+static Recorder recorder;
+static char strBuffer[100];
+
+static volatile bool recording = false;
+static int fileReturnCode = -1;
+static FILE *recordFile = NULL;
+static u64 recordStartTick = 0;
+
+// writer thread state
+static lwp_t writerThread = LWP_THREAD_NULL;
+static lwpq_t writerQueue = LWP_TQUEUE_NULL;
+static volatile bool writerStop = false;
+static volatile bool writerError = false;
+static volatile u64 bytesWritten = 0;
+static volatile u64 writeTicks = 0;
+static volatile u32 blocksWritten = 0;
+
+static u32 *pressed;
+static u32 *held;
+
+static u64 prevSampleCallbackTick = 0;
+static u64 sampleCallbackTick = 0;
+
+static sampling_callback cb;
+static void recordCallback() {
+	// time from last call of this function calculation
+	prevSampleCallbackTick = sampleCallbackTick;
+	sampleCallbackTick = gettime();
+	if (prevSampleCallbackTick == 0) {
+		prevSampleCallbackTick = sampleCallbackTick;
+	}
+
+	PAD_ScanPads();
+
+	// queue button changes for the menu code
+	u16 currHeld = input_update();
+
+	if (!recording) {
+		return;
+	}
+
+	u32 intervalUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+	RecordSample sample;
+	sample.ax = PAD_StickX(0);
+	sample.ay = PAD_StickY(0);
+	sample.cx = PAD_SubStickX(0);
+	sample.cy = PAD_SubStickY(0);
+	sample.tl = PAD_TriggerL(0);
+	sample.tr = PAD_TriggerR(0);
+	sample.buttons = currHeld;
+	sample.intervalUs = intervalUs > UINT16_MAX ? UINT16_MAX : intervalUs;
+	recorder_push(&recorder, &sample, (u32) ticks_to_microsecs(sampleCallbackTick));
+}
+
+// saves full blocks until told to stop, then saves whatever is left
+static void *writerMain(void *arg) {
+	while (true) {
+		RecorderBlock *block;
+		while ((block = recorder_nextFull(&recorder)) != NULL) {
+			if (!writerError) {
+				u64 start = gettime();
+				u32 len = recorder_writeBlock(recordFile, block);
+				writeTicks += gettime() - start;
+				if (len == 0) {
+					writerError = true;
+				}
+				bytesWritten += len;
+				blocksWritten++;
+			}
+			// blocks still get released on an error, so the callback doesn't back up
+			recorder_release(&recorder);
+		}
+		if (writerStop) {
+			break;
+		}
+		// the menu signals every frame, so a missed wakeup only costs a frame
+		LWP_ThreadSleep(writerQueue);
+	}
+	return NULL;
+}
+
+static void startRecording() {
+	fileReturnCode = openRecordingFile(&recordFile);
+	if (fileReturnCode != 0) {
+		return;
+	}
+	recorder_init(&recorder);
+	bytesWritten = 0;
+	writeTicks = 0;
+	blocksWritten = 0;
+	writerStop = false;
+	writerError = false;
+	LWP_InitQueue(&writerQueue);
+	LWP_CreateThread(&writerThread, writerMain, NULL, NULL, RECORD_WRITER_STACK_SIZE, RECORD_WRITER_PRIORITY);
+	recordStartTick = gettime();
+	recording = true;
+}
+
+static void stopRecording() {
+	if (!recording) {
+		return;
+	}
+	// the callback can't run in the middle of this, so it won't touch the recorder after this point
+	recording = false;
+	recorder_flushPartial(&recorder);
+	writerStop = true;
+	LWP_ThreadSignal(writerQueue);
+	LWP_JoinThread(writerThread, NULL);
+	LWP_CloseQueue(writerQueue);
+	writerThread = LWP_THREAD_NULL;
+	writerQueue = LWP_TQUEUE_NULL;
+	fclose(recordFile);
+	recordFile = NULL;
+}
+
+static void setup(u32 *p, u32 *h) {
+	pressed = p;
+	held = h;
+	prevSampleCallbackTick = 0;
+	sampleCallbackTick = 0;
+	fileReturnCode = -1;
+	setSamplingRateHigh();
+	cb = PAD_SetSamplingCallback(recordCallback);
+	state = REC_POST_SETUP;
+}
+
+static void printStatus(void *currXfb) {
+	setCursorPos(3, 0);
+	switch (fileReturnCode) {
+		case -1:
+			printStr("Press A to start recording to the SD card.\n", currXfb);
+			break;
+		case 0:
+			if (recording) {
+				printStrColor("RECORDING", currXfb, COLOR_WHITE, COLOR_BLACK);
+				printStr(" - press A to stop\n", currXfb);
+			} else {
+				printStr("Recording saved. Press A to start a new one.\n", currXfb);
+			}
+			break;
+		case 2:
+			printStr("No SD card found.\n", currXfb);
+			break;
+		default:
+			sprintf(strBuffer, "Couldn't create the recording file (error %d).\n", fileReturnCode);
+			printStr(strBuffer, currXfb);
+			break;
+	}
+	if (fileReturnCode != 0) {
+		return;
+	}
+
+	if (writerError) {
+		printStr("Write failed, the card may be full. Samples are no longer being saved.\n", currXfb);
+	}
+
+	u32 seconds = ticks_to_secs(gettime() - recordStartTick);
+	if (recording) {
+		sprintf(strBuffer, "\nTime: %02u:%02u:%02u\n", seconds / 3600, (seconds / 60) % 60, seconds % 60);
+		printStr(strBuffer, currXfb);
+	} else {
+		printStr("\n\n", currXfb);
+	}
+	sprintf(strBuffer, "Samples: %u | Dropped: %u\n", recorder.samplesTotal, recorder.droppedTotal);
+	printStr(strBuffer, currXfb);
+	sprintf(strBuffer, "Blocks written: %u | Waiting: %u/%u\n", blocksWritten, recorder_pending(&recorder), RECORDER_BLOCKS);
+	printStr(strBuffer, currXfb);
+
+	u64 bytes = bytesWritten;
+	u64 ticks = writeTicks;
+	sprintf(strBuffer, "Written: %0.1f KB", bytes / 1024.0);
+	printStr(strBuffer, currXfb);
+	if (ticks != 0) {
+		// speed while actually writing, not averaged over the whole recording
+		sprintf(strBuffer, " | Write speed: %0.1f KB/s", (bytes / 1024.0) / (ticks_to_microsecs(ticks) / 1000000.0));
+		printStr(strBuffer, currXfb);
+	}
+}
+
+void menu_recorder(void *currXfb, u32 *p, u32 *h) {
+	switch (state) {
+		case REC_SETUP:
+			setup(p, h);
+			break;
+		case REC_POST_SETUP:
+			if (recording) {
+				LWP_ThreadSignal(writerQueue);
+			}
+			printStatus(currXfb);
+
+			if (*pressed & PAD_BUTTON_A) {
+				if (recording) {
+					stopRecording();
+				} else {
+					startRecording();
+				}
+			}
+			break;
+	}
+}
+
+void menu_recorderEnd() {
+	stopRecording();
+	setSamplingRateNormal();
+	PAD_SetSamplingCallback(cb);
+	pressed = NULL;
+	held = NULL;
+	state = REC_SETUP;
+}
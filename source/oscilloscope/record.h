@@ -0,0 +1,15 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_RECORD_H
+#define GTS_RECORD_H
+
+#include <gccore.h>
+
+enum RECORD_MENU_STATE { REC_SETUP, REC_POST_SETUP };
+
+void menu_recorder(void *currXfb, u32 *p, u32 *h);
+void menu_recorderEnd();
+
+#endif //GTS_RECORD_H
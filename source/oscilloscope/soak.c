@@ -0,0 +1,280 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "soak.h"
+#include <stdio.h>
+#include <ogc/lwp_watchdog.h>
+#include "../print.h"
+#include "../draw.h"
+#include "../polling.h"
+#include "../input.h"
+#include "../soakstats.h"
+#include "../file/file.h"
+
+const static u8 SCREEN_TIMEPLOT_START = 70;
+
+// samples waiting to be added to the stats, must be a power of two
+// this needs to cover the time it takes to write a snapshot to the sd card
+#define SOAK_QUEUE_LEN 4096
+
+// how often a snapshot gets written
+#define SOAK_SNAPSHOT_INTERVAL_US 300000000ull
+
+// histogram and drift plot layout
+#define SOAK_HIST_BAR_WIDTH 7
+#define SOAK_HIST_HEIGHT 60
+#define SOAK_HIST_Y 338
+#define SOAK_DRIFT_Y 395
+// pixels per unit of drift
+#define SOAK_DRIFT_SCALE 10
+
+static const uint32_t COLOR_RED_C = 0x846084d7;
+static const uint32_t COLOR_BLUE_C = 0x6dd26d72;
+
+static const char* AXIS_NAMES[SOAK_AXES] = { "AX", "AY", "CX", "CY" };
+
+static enum SOAK_MENU_STATE state = SOAK_SETUP;
+
+static SoakStats stats;
+static char strBuffer[100];
+
+// filled by the callback, drained into stats once per frame
+static volatile SoakSample queue[SOAK_QUEUE_LEN];
+static volatile u32 writeIndex = 0;
+static volatile u32 readIndex = 0;
+static volatile u32 dropped = 0;
+
+static bool showCStick = false;
+static int exportReturnCode = -1;
+static u64 nextSnapshotUs = 0;
+
+static u32 *pressed;
+static u32 *held;
+
+static u64 prevSampleCallbackTick = 0;
+static u64 sampleCallbackTick = 0;
+
+static sampling_callback cb;
+static void soakCallback() {
+	// time from last call of this function calculation
+	prevSampleCallbackTick = sampleCallbackTick;
+	sampleCallbackTick = gettime();
+	if (prevSampleCallbackTick == 0) {
+		prevSampleCallbackTick = sampleCallbackTick;
+	}
+
+	PAD_ScanPads();
+
+	// queue button changes for the menu code
+	input_update();
+
+	u32 currWrite = writeIndex;
+	if (currWrite - readIndex >= SOAK_QUEUE_LEN) {
+		dropped++;
+		return;
+	}
+	volatile SoakSample *sample = &queue[currWrite & (SOAK_QUEUE_LEN - 1)];
+	sample->axis[SOAK_AX] = PAD_StickX(0);
+	sample->axis[SOAK_AY] = PAD_StickY(0);
+	sample->axis[SOAK_CX] = PAD_SubStickX(0);
+	sample->axis[SOAK_CY] = PAD_SubStickY(0);
+	sample->intervalUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+	writeIndex = currWrite + 1;
+}
+
+static void resetSoak() {
+	soakStats_reset(&stats);
+	readIndex = writeIndex;
+	dropped = 0;
+	nextSnapshotUs = SOAK_SNAPSHOT_INTERVAL_US;
+	exportReturnCode = startSoakExport();
+}
+
+static void setup(u32 *p, u32 *h) {
+	pressed = p;
+	held = h;
+	prevSampleCallbackTick = 0;
+	sampleCallbackTick = 0;
+	resetSoak();
+	setSamplingRateHigh();
+	cb = PAD_SetSamplingCallback(soakCallback);
+	state = SOAK_POST_SETUP;
+}
+
+// add everything the callback has queued since the last frame
+static void drainQueue() {
+	u32 currRead = readIndex;
+	u32 currWrite = writeIndex;
+	while (currRead != currWrite) {
+		SoakSample sample = queue[currRead & (SOAK_QUEUE_LEN - 1)];
+		soakStats_add(&stats, &sample);
+		currRead++;
+	}
+	readIndex = currRead;
+}
+
+static void writeSnapshot() {
+	// try again if the log couldn't be created earlier
+	if (exportReturnCode != 0) {
+		exportReturnCode = startSoakExport();
+		if (exportReturnCode != 0) {
+			return;
+		}
+	}
+	exportReturnCode = exportSoakSnapshot(&stats, dropped);
+}
+
+static void printSummary(void *currXfb) {
+	u32 seconds = stats.elapsedUs / 1000000;
+	setCursorPos(3, 0);
+	sprintf(strBuffer, "Elapsed: %02u:%02u:%02u | Samples: %llu | Dropped: %u\n",
+	        seconds / 3600, (seconds / 60) % 60, seconds % 60, stats.samples, dropped);
+	printStr(strBuffer, currXfb);
+
+	float mean, stdDev;
+	soakStats_interval(&stats, &mean, &stdDev);
+	sprintf(strBuffer, "Poll: %0.1f us avg | SD: %0.1f | Min: %u | Max: %u | Gaps: %u\n",
+	        mean, stdDev, stats.samples > 1 ? stats.intervalMinUs : 0, stats.intervalMaxUs, stats.gaps);
+	printStr(strBuffer, currXfb);
+
+	switch (exportReturnCode) {
+		case 0:
+			sprintf(strBuffer, "SD: logging, next snapshot in %llu s",
+			        (nextSnapshotUs - stats.elapsedUs) / 1000000);
+			break;
+		case 2:
+			sprintf(strBuffer, "SD: no card found, snapshots disabled");
+			break;
+		default:
+			sprintf(strBuffer, "SD: error %d, snapshots disabled", exportReturnCode);
+			break;
+	}
+	printStr(strBuffer, currXfb);
+
+	setCursorPos(7, 0);
+	printStr("Axis  Min  Max    P1   P50   P99   Rest  Noise  Drift\n", currXfb);
+	for (int i = 0; i < SOAK_AXES; i++) {
+		SoakAxisStats *curr = &stats.axis[i];
+		if (stats.samples == 0) {
+			break;
+		}
+		sprintf(strBuffer, "%-4s %4d %4d %5.1f %5.1f %5.1f ", AXIS_NAMES[i], curr->min, curr->max,
+		        p2_get(&curr->quantiles[0]), p2_get(&curr->quantiles[1]), p2_get(&curr->quantiles[2]));
+		printStr(strBuffer, currXfb);
+		if (soakStats_rest(&stats, i, &mean, &stdDev)) {
+			sprintf(strBuffer, "%6.2f %6.2f %6.2f\n", mean, stdDev, soakStats_driftRange(&stats, i));
+		} else {
+			sprintf(strBuffer, "  ----   ----   ----\n");
+		}
+		printStr(strBuffer, currXfb);
+	}
+}
+
+static void drawHistogram(enum SOAK_AXIS axis, int xStart, void *currXfb) {
+	const u32 *bins = stats.axis[axis].restHistogram;
+	u32 maxCount = 0;
+	for (int i = 0; i < SOAK_REST_BINS; i++) {
+		if (bins[i] > maxCount) {
+			maxCount = bins[i];
+		}
+	}
+	DrawHLine(xStart, xStart + (SOAK_REST_BINS * SOAK_HIST_BAR_WIDTH), SOAK_HIST_Y, COLOR_WHITE, currXfb);
+	// mark zero
+	DrawVLine(xStart + (SOAK_REST_RANGE * SOAK_HIST_BAR_WIDTH) + (SOAK_HIST_BAR_WIDTH / 2),
+	          SOAK_HIST_Y, SOAK_HIST_Y + 4, COLOR_WHITE, currXfb);
+	if (maxCount == 0) {
+		return;
+	}
+	for (int i = 0; i < SOAK_REST_BINS; i++) {
+		int height = (int) (((u64) bins[i] * SOAK_HIST_HEIGHT) / maxCount);
+		if (height == 0) {
+			continue;
+		}
+		int x = xStart + (i * SOAK_HIST_BAR_WIDTH);
+		DrawFilledBox(x, SOAK_HIST_Y - height, x + SOAK_HIST_BAR_WIDTH - 2, SOAK_HIST_Y - 1,
+		              axis % 2 == 0 ? COLOR_RED_C : COLOR_BLUE_C, currXfb);
+	}
+}
+
+// resting center per drift bucket, relative to the first bucket
+static void drawDrift(enum SOAK_AXIS axis, int xStart, void *currXfb) {
+	DrawHLine(xStart, xStart + (SOAK_DRIFT_BUCKETS * 2), SOAK_DRIFT_Y, COLOR_GRAY, currXfb);
+	float reference = 0;
+	bool haveReference = false;
+	for (u32 i = 0; i < stats.driftUsed; i++) {
+		float mean;
+		if (!soakStats_driftMean(&stats, i, axis, &mean)) {
+			continue;
+		}
+		if (!haveReference) {
+			reference = mean;
+			haveReference = true;
+		}
+		int offset = (int) ((mean - reference) * SOAK_DRIFT_SCALE);
+		if (offset > 25) {
+			offset = 25;
+		} else if (offset < -25) {
+			offset = -25;
+		}
+		DrawFilledBoxCenter(xStart + (i * 2), SOAK_DRIFT_Y - offset, 1,
+		                    axis % 2 == 0 ? COLOR_RED_C : COLOR_BLUE_C, currXfb);
+	}
+}
+
+void menu_soakTest(void *currXfb, u32 *p, u32 *h) {
+	switch (state) {
+		case SOAK_SETUP:
+			setup(p, h);
+			break;
+		case SOAK_POST_SETUP:
+			drainQueue();
+			if (exportReturnCode == 0 && stats.elapsedUs >= nextSnapshotUs) {
+				writeSnapshot();
+				nextSnapshotUs = stats.elapsedUs - (stats.elapsedUs % SOAK_SNAPSHOT_INTERVAL_US) + SOAK_SNAPSHOT_INTERVAL_US;
+			}
+
+			printSummary(currXfb);
+
+			enum SOAK_AXIS xAxis = showCStick ? SOAK_CX : SOAK_AX;
+			enum SOAK_AXIS yAxis = showCStick ? SOAK_CY : SOAK_AY;
+			setCursorPos(13, 0);
+			sprintf(strBuffer, "%s rest histogram, +/- %d", showCStick ? "C-Stick" : "Analog Stick", SOAK_REST_RANGE);
+			printStr(strBuffer, currXfb);
+			drawHistogram(xAxis, SCREEN_TIMEPLOT_START, currXfb);
+			drawHistogram(yAxis, SCREEN_TIMEPLOT_START + 260, currXfb);
+
+			setCursorPos(18, 0);
+			sprintf(strBuffer, "Center drift, %llu s per point", stats.driftBucketUs / 1000000);
+			printStr(strBuffer, currXfb);
+			drawDrift(xAxis, SCREEN_TIMEPLOT_START, currXfb);
+			drawDrift(yAxis, SCREEN_TIMEPLOT_START + 260, currXfb);
+
+			setCursorPos(23, 0);
+			printStr("Y: switch stick | X: snapshot now | Start: reset", currXfb);
+
+			if (*pressed & PAD_BUTTON_Y) {
+				showCStick = !showCStick;
+			}
+			if (*pressed & PAD_BUTTON_X) {
+				writeSnapshot();
+			}
+			if (*pressed & PAD_BUTTON_START) {
+				resetSoak();
+			}
+			break;
+	}
+}
+
+void menu_soakTestEnd() {
+	setSamplingRateNormal();
+	PAD_SetSamplingCallback(cb);
+	// keep whatever was collected since the last snapshot
+	if (exportReturnCode == 0) {
+		drainQueue();
+		exportSoakSnapshot(&stats, dropped);
+	}
+	pressed = NULL;
+	held = NULL;
+	state = SOAK_SETUP;
+}
@@ -0,0 +1,15 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_SOAK_H
+#define GTS_SOAK_H
+
+#include <gccore.h>
+
+enum SOAK_MENU_STATE { SOAK_SETUP, SOAK_POST_SETUP };
+
+void menu_soakTest(void *currXfb, u32 *p, u32 *h);
+void menu_soakTestEnd();
+
+#endif //GTS_SOAK_H
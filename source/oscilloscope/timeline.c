@@ -0,0 +1,272 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "timeline.h"
+#include <stdio.h>
+#include <ogc/lwp_watchdog.h>
+#include "../print.h"
+#include "../draw.h"
+#include "../polling.h"
+#include "../input.h"
+#include "../buttonlog.h"
+
+const static u8 SCREEN_TIMEPLOT_START = 70;
+#define TIMELINE_WIDTH 500
+
+// first text row used for the button rows
+#define TIMELINE_ROW_START 4
+
+// buttons shown on the timeline, in display order
+// values are the button ids used by the button log
+#define TIMELINE_BUTTON_LEN 12
+static const u8 TIMELINE_BUTTONS[TIMELINE_BUTTON_LEN] = { 8, 9, 10, 11, 4, 6, 5, 12, 3, 2, 0, 1 };
+
+// names indexed by button id
+static const char* BUTTON_NAMES[BUTTONLOG_BUTTONS] = { "Left", "Right", "Down", "Up", "Z", "R", "L", "?",
+                                                       "A", "B", "X", "Y", "Start", "?", "?", "?" };
+
+// microseconds per pixel for each zoom level
+#define TIMELINE_ZOOM_LEN 5
+static const u32 TIMELINE_ZOOM_US[TIMELINE_ZOOM_LEN] = { 100, 250, 500, 1000, 2000 };
+
+static enum TIMELINE_MENU_STATE state = TIMELINE_SETUP;
+
+static ButtonLog eventLog;
+static char strBuffer[100];
+
+static int zoomLevel = TIMELINE_ZOOM_LEN - 1;
+static bool freeze = false;
+static u64 frozenEndUs = 0;
+static s64 scrollUs = 0;
+
+// full timestamps, since the ones in the log wrap
+static volatile u64 latestTimeUs = 0;
+static volatile u64 lastEventTimeUs = 0;
+
+static u32 *pressed;
+static u32 *held;
+
+static sampling_callback cb;
+static void timelineCallback() {
+	u64 tick = gettime();
+	PAD_ScanPads();
+
+	// queue button changes for the menu code
+	u16 currHeld = input_update();
+
+	u64 timeUs = ticks_to_microsecs(tick);
+	u32 prevCount = eventLog.writeCount;
+	buttonLog_record(&eventLog, currHeld, (u32) timeUs);
+	if (eventLog.writeCount != prevCount) {
+		lastEventTimeUs = timeUs;
+	}
+	latestTimeUs = timeUs;
+}
+
+static void setup(u32 *p, u32 *h) {
+	pressed = p;
+	held = h;
+	PAD_ScanPads();
+	buttonLog_reset(&eventLog, PAD_ButtonsHeld(0));
+	latestTimeUs = ticks_to_microsecs(gettime());
+	lastEventTimeUs = latestTimeUs;
+	freeze = false;
+	scrollUs = 0;
+	setSamplingRateHigh();
+	cb = PAD_SetSamplingCallback(timelineCallback);
+	state = TIMELINE_POST_SETUP;
+}
+
+// convert an absolute time to an x position on the timeline, can be outside of the visible area
+static int timeToX(u64 viewEndUs, u64 timeUs, u32 usPerPixel) {
+	s64 age = ((s64) viewEndUs) - ((s64) timeUs);
+	return TIMELINE_WIDTH - (int) (age / (s64) usPerPixel);
+}
+
+static void drawSpan(int row, int x1, int x2, void *currXfb) {
+	if (x2 < 0 || x1 > TIMELINE_WIDTH) {
+		return;
+	}
+	if (x1 < 0) {
+		x1 = 0;
+	}
+	if (x2 > TIMELINE_WIDTH) {
+		x2 = TIMELINE_WIDTH;
+	}
+	int rowY = PRINT_PADDING_VERTICAL + ((TIMELINE_ROW_START + row) * (15 + LINE_SPACING));
+	DrawFilledBox(SCREEN_TIMEPLOT_START + x1, rowY + 3, SCREEN_TIMEPLOT_START + x2, rowY + 11, COLOR_WHITE, currXfb);
+	// mark the press edge so bounces stand out
+	if (x1 > 0) {
+		DrawVLine(SCREEN_TIMEPLOT_START + x1, rowY, rowY + 14, COLOR_GREEN, currXfb);
+	}
+}
+
+static void drawTimeline(u64 viewEndUs, void *currXfb) {
+	u32 usPerPixel = TIMELINE_ZOOM_US[zoomLevel];
+	// display row for a given button id, -1 if not shown
+	int rowForButton[BUTTONLOG_BUTTONS];
+	// end of the held segment currently being walked, -1 if the button isn't held there
+	int segmentEnd[BUTTONLOG_BUTTONS];
+	for (int i = 0; i < BUTTONLOG_BUTTONS; i++) {
+		rowForButton[i] = -1;
+		segmentEnd[i] = -1;
+	}
+	for (int i = 0; i < TIMELINE_BUTTON_LEN; i++) {
+		rowForButton[TIMELINE_BUTTONS[i]] = i;
+	}
+
+	// anything held right now is held up to the newest poll
+	u16 currHeld = eventLog.prevHeld;
+	int newestX = timeToX(viewEndUs, latestTimeUs, usPerPixel);
+	for (int i = 0; i < BUTTONLOG_BUTTONS; i++) {
+		if (currHeld & (1 << i)) {
+			segmentEnd[i] = newestX;
+		}
+	}
+
+	// walk backwards from the newest event, rebuilding full timestamps from the differences
+	u32 count = buttonLog_count(&eventLog);
+	u64 eventTimeUs = lastEventTimeUs;
+	for (u32 i = count; i > 0; i--) {
+		ButtonEvent event = buttonLog_get(&eventLog, i - 1);
+		if (i != count) {
+			eventTimeUs -= buttonLog_timeDiff(event, buttonLog_get(&eventLog, i));
+		}
+		int x = timeToX(viewEndUs, eventTimeUs, usPerPixel);
+		u8 button = buttonLog_button(event);
+
+		if (buttonLog_isPress(event)) {
+			if (segmentEnd[button] != -1 && rowForButton[button] != -1) {
+				drawSpan(rowForButton[button], x, segmentEnd[button], currXfb);
+			}
+			segmentEnd[button] = -1;
+		} else {
+			segmentEnd[button] = x;
+		}
+
+		// nothing older can be visible
+		if (x < 0) {
+			break;
+		}
+	}
+
+	// anything still open was pressed before the left edge (or before the oldest event we have)
+	for (int i = 0; i < BUTTONLOG_BUTTONS; i++) {
+		if (segmentEnd[i] != -1 && rowForButton[i] != -1) {
+			drawSpan(rowForButton[i], -1, segmentEnd[i], currXfb);
+		}
+	}
+
+	// labels and row separators
+	for (int i = 0; i < TIMELINE_BUTTON_LEN; i++) {
+		setCursorPos(TIMELINE_ROW_START + i, 0);
+		printStr(BUTTON_NAMES[TIMELINE_BUTTONS[i]], currXfb);
+		int rowY = PRINT_PADDING_VERTICAL + ((TIMELINE_ROW_START + i) * (15 + LINE_SPACING));
+		DrawHLine(SCREEN_TIMEPLOT_START, SCREEN_TIMEPLOT_START + TIMELINE_WIDTH, rowY + 15, COLOR_GRAY, currXfb);
+	}
+	int top = PRINT_PADDING_VERTICAL + (TIMELINE_ROW_START * (15 + LINE_SPACING)) - 1;
+	int bottom = PRINT_PADDING_VERTICAL + ((TIMELINE_ROW_START + TIMELINE_BUTTON_LEN) * (15 + LINE_SPACING));
+	DrawBox(SCREEN_TIMEPLOT_START - 1, top, SCREEN_TIMEPLOT_START + TIMELINE_WIDTH + 1, bottom, COLOR_WHITE, currXfb);
+}
+
+static void printStats(void *currXfb) {
+	static ButtonStats stats[BUTTONLOG_BUTTONS];
+	u32 count = buttonLog_count(&eventLog);
+
+	setCursorPos(3, 0);
+	sprintf(strBuffer, "Events: %u | Window: %u ms", eventLog.writeCount, (TIMELINE_ZOOM_US[zoomLevel] * TIMELINE_WIDTH) / 1000);
+	printStr(strBuffer, currXfb);
+	if (freeze) {
+		sprintf(strBuffer, " | Offset: -%0.1f ms", scrollUs / 1000.0);
+		printStr(strBuffer, currXfb);
+	}
+
+	if (count == 0) {
+		setCursorPos(TIMELINE_ROW_START + TIMELINE_BUTTON_LEN + 1, 0);
+		printStr("Press any button.", currXfb);
+		return;
+	}
+
+	buttonLog_analyze(&eventLog, BUTTONLOG_BOUNCE_WINDOW_US, stats);
+
+	// show stats for whichever button was used last
+	u8 button = buttonLog_button(buttonLog_get(&eventLog, count - 1));
+	ButtonStats *curr = &stats[button];
+	setCursorPos(TIMELINE_ROW_START + TIMELINE_BUTTON_LEN + 1, 0);
+	sprintf(strBuffer, "%s: Presses: %u | Bounces: %u\n", BUTTON_NAMES[button], curr->presses, curr->bounces);
+	printStr(strBuffer, currXfb);
+	if (curr->completedPresses != 0) {
+		sprintf(strBuffer, "Held avg: %0.2f ms | Min: %0.2f ms | Max: %0.2f ms\n",
+		        (curr->totalPressUs / (float) curr->completedPresses) / 1000.0,
+		        curr->minPressUs / 1000.0, curr->maxPressUs / 1000.0);
+		printStr(strBuffer, currXfb);
+	} else {
+		printStr("Held: no completed presses\n", currXfb);
+	}
+
+	u8 first, second;
+	u32 timeUs;
+	if (buttonLog_lastInterPress(&eventLog, &first, &second, &timeUs)) {
+		sprintf(strBuffer, "Last press pair: %s -> %s, %0.2f ms (%0.2f frames)",
+		        BUTTON_NAMES[first], BUTTON_NAMES[second], timeUs / 1000.0, (timeUs / 1000.0) / (1000 / 60.0));
+		printStr(strBuffer, currXfb);
+	}
+}
+
+void menu_buttonTimeline(void *currXfb, u32 *p, u32 *h) {
+	switch (state) {
+		case TIMELINE_SETUP:
+			setup(p, h);
+			break;
+		case TIMELINE_POST_SETUP:
+			if (freeze) {
+				setCursorPos(2, 28);
+				printStrColor("LOCKED", currXfb, COLOR_WHITE, COLOR_BLACK);
+			}
+
+			u64 viewEndUs = freeze ? (frozenEndUs - scrollUs) : latestTimeUs;
+			drawTimeline(viewEndUs, currXfb);
+			printStats(currXfb);
+
+			setCursorPos(21, 0);
+			if (freeze) {
+				printStr("Start: unlock | DPAD: scroll/zoom", currXfb);
+			} else {
+				printStr("Press Start to lock the timeline.", currXfb);
+			}
+
+			if (*pressed & PAD_BUTTON_START) {
+				freeze = !freeze;
+				frozenEndUs = latestTimeUs;
+				scrollUs = 0;
+			}
+			if (freeze) {
+				if (*pressed & PAD_BUTTON_UP && zoomLevel > 0) {
+					zoomLevel--;
+				}
+				if (*pressed & PAD_BUTTON_DOWN && zoomLevel < TIMELINE_ZOOM_LEN - 1) {
+					zoomLevel++;
+				}
+				// scroll by a tenth of the visible window
+				s64 step = (TIMELINE_ZOOM_US[zoomLevel] * TIMELINE_WIDTH) / 10;
+				if (*held & PAD_BUTTON_LEFT) {
+					scrollUs += step;
+				} else if (*held & PAD_BUTTON_RIGHT) {
+					scrollUs -= step;
+					if (scrollUs < 0) {
+						scrollUs = 0;
+					}
+				}
+			}
+			break;
+	}
+}
+
+void menu_buttonTimelineEnd() {
+	setSamplingRateNormal();
+	PAD_SetSamplingCallback(cb);
+	pressed = NULL;
+	held = NULL;
+	state = TIMELINE_SETUP;
+}
@@ -0,0 +1,15 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_TIMELINE_H
+#define GTS_TIMELINE_H
+
+#include <gccore.h>
+
+enum TIMELINE_MENU_STATE { TIMELINE_SETUP, TIMELINE_POST_SETUP };
+
+void menu_buttonTimeline(void *currXfb, u32 *p, u32 *h);
+void menu_buttonTimelineEnd();
+
+#endif //GTS_TIMELINE_H
@@ -0,0 +1,393 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "trigger.h"
+#include <stdio.h>
+#include <ogc/lwp_watchdog.h>
+#include "../print.h"
+#include "../draw.h"
+#include "../polling.h"
+#include "../input.h"
+#include "../profiler.h"
+
+// how far past the resting value the trigger has to move before a capture starts
+const static u8 TRIGGER_MOVEMENT_THRESHOLD = 10;
+// how long the trigger needs to be released before a capture stops
+const static u8 TRIGGER_RELEASE_TIME_THRESHOLD_MS = 50;
+const static u8 MEASURE_COOLDOWN_FRAMES = 5;
+
+const static u8 SCREEN_TIMEPLOT_START = 70;
+
+static const uint32_t COLOR_RED_C = 0x846084d7;
+
+// bottom of the plot, analog value of 0 is drawn here
+#define TRIGGER_PLOT_BOTTOM (SCREEN_POS_CENTER_Y + 127)
+
+static enum TRIG_MENU_STATE state = TRIG_SETUP;
+static enum TRIG_STATE tState = TRIG_PRE_INPUT;
+
+static WaveformData data = { .testType = -1 };
+static int dataScrollOffset = 0;
+static char strBuffer[100];
+
+static u8 triggerCooldown = 0;
+static bool recording = false;
+static bool showRTrigger = false;
+
+// resting value of the selected trigger, read when the menu is entered or the trigger is changed
+static int triggerRest = 0;
+static bool readTriggerRest = true;
+
+static u64 prevSampleCallbackTick = 0;
+static u64 sampleCallbackTick = 0;
+static u64 timeReleased = 0;
+
+// results for the current capture, only calculated once per capture
+static bool resultsReady = false;
+static int peakValue = 0;
+static u64 travelTimeUs = 0;
+static bool reachedShield = false;
+static u64 timeToShieldUs = 0;
+static bool digitalPressed = false;
+static u64 timeToDigitalUs = 0;
+static int analogAtDigital = 0;
+static s64 analogDigitalLagUs = 0;
+static u64 digitalHeldUs = 0;
+
+static u32 *pressed;
+static u32 *held;
+
+static sampling_callback cb;
+static void triggerCallback() {
+	// time from last call of this function calculation
+	prevSampleCallbackTick = sampleCallbackTick;
+	sampleCallbackTick = gettime();
+	if (prevSampleCallbackTick == 0) {
+		prevSampleCallbackTick = sampleCallbackTick;
+	}
+
+	PAD_ScanPads();
+
+	// queue button changes for the menu code
+	u16 currHeld = input_update();
+
+	u8 tl = PAD_TriggerL(0);
+	u8 tr = PAD_TriggerR(0);
+	bool dl = (currHeld & PAD_TRIGGER_L) != 0;
+	bool dr = (currHeld & PAD_TRIGGER_R) != 0;
+
+	// values for the trigger being tested
+	int analog = showRTrigger ? tr : tl;
+	bool digital = showRTrigger ? dr : dl;
+
+	if (readTriggerRest) {
+		triggerRest = analog;
+		readTriggerRest = false;
+		return;
+	}
+
+	if (tState == TRIG_POST_INPUT_LOCK) {
+		return;
+	}
+
+	u64 timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
+
+	// we're already recording an input
+	if (recording) {
+		data.data[data.endPoint].tl = tl;
+		data.data[data.endPoint].tr = tr;
+		data.data[data.endPoint].isDigitalLPressed = dl;
+		data.data[data.endPoint].isDigitalRPressed = dr;
+		data.data[data.endPoint].timeDiffUs = timeDiffUs;
+		data.totalTimeUs += timeDiffUs;
+		data.endPoint++;
+
+		// has the trigger been let go?
+		if (analog <= triggerRest + TRIGGER_MOVEMENT_THRESHOLD && !digital) {
+			timeReleased += timeDiffUs;
+		} else {
+			timeReleased = 0;
+		}
+
+		// have we either run out of data, or has the trigger been released for long enough?
+		if (data.endPoint == WAVEFORM_SAMPLES || (timeReleased / 1000) >= TRIGGER_RELEASE_TIME_THRESHOLD_MS) {
+			data.isDataReady = true;
+			recording = false;
+			resultsReady = false;
+			tState = TRIG_POST_INPUT_LOCK;
+			triggerCooldown = MEASURE_COOLDOWN_FRAMES;
+		}
+
+	// we've not recorded an input yet
+	} else {
+		// does the trigger move outside the threshold?
+		if (analog > triggerRest + TRIGGER_MOVEMENT_THRESHOLD || digital) {
+			recording = true;
+			timeReleased = 0;
+			data.data[0].tl = tl;
+			data.data[0].tr = tr;
+			data.data[0].isDigitalLPressed = dl;
+			data.data[0].isDigitalRPressed = dr;
+			data.data[0].timeDiffUs = 0; // doesn't make sense to have diff from a nonexistent previous value
+			data.endPoint = 1;
+			data.totalTimeUs = 0;
+			data.isDataReady = false;
+			tState = TRIG_PRE_INPUT;
+		}
+	}
+}
+
+// go through the capture once, and find the timings for the selected trigger
+// all times are from the first poll outside of the resting position
+static void calculateResults() {
+	int peakIndex = 0;
+	int digitalIndex = -1;
+	int digitalReleaseIndex = -1;
+	int shieldIndex = -1;
+
+	peakValue = 0;
+	for (int i = 0; i < data.endPoint; i++) {
+		int analog = showRTrigger ? data.data[i].tr : data.data[i].tl;
+		bool digital = showRTrigger ? data.data[i].isDigitalRPressed : data.data[i].isDigitalLPressed;
+
+		if (analog > peakValue) {
+			peakValue = analog;
+			peakIndex = i;
+		}
+		if (shieldIndex == -1 && analog >= TRIGGER_SHIELD_THRESHOLD) {
+			shieldIndex = i;
+		}
+		if (digital && digitalIndex == -1) {
+			digitalIndex = i;
+		} else if (!digital && digitalIndex != -1 && digitalReleaseIndex == -1) {
+			digitalReleaseIndex = i;
+		}
+	}
+	if (digitalIndex != -1 && digitalReleaseIndex == -1) {
+		digitalReleaseIndex = data.endPoint - 1;
+	}
+
+	// sum up time between polls for each index we care about
+	u64 timeFromStart = 0;
+	travelTimeUs = 0;
+	timeToShieldUs = 0;
+	timeToDigitalUs = 0;
+	digitalHeldUs = 0;
+	for (int i = 1; i < data.endPoint; i++) {
+		timeFromStart += data.data[i].timeDiffUs;
+		if (i == peakIndex) {
+			travelTimeUs = timeFromStart;
+		}
+		if (i == shieldIndex) {
+			timeToShieldUs = timeFromStart;
+		}
+		if (i == digitalIndex) {
+			timeToDigitalUs = timeFromStart;
+		}
+		if (digitalIndex != -1 && i > digitalIndex && i <= digitalReleaseIndex) {
+			digitalHeldUs += data.data[i].timeDiffUs;
+		}
+	}
+
+	reachedShield = (shieldIndex != -1);
+	digitalPressed = (digitalIndex != -1);
+	if (digitalPressed) {
+		analogAtDigital = showRTrigger ? data.data[digitalIndex].tr : data.data[digitalIndex].tl;
+		// positive means the digital press came after the analog value peaked
+		analogDigitalLagUs = ((s64) timeToDigitalUs) - ((s64) travelTimeUs);
+	}
+
+	resultsReady = true;
+}
+
+static void printInstructions(void *currXfb) {
+	setCursorPos(2, 0);
+	printStr("Press Y to cycle between the L and R trigger. A capture starts\n"
+			 "when the trigger leaves its resting position, and ends when it\n"
+			 "has been released for a short time.\n"
+			 "Use DPAD left/right to scroll waveform when it is\n"
+			 "larger than the displayed area, hold R to move faster.\n\n"
+			 "Travel: time from first movement to the analog peak.\n"
+			 "Shield: time until the analog value reaches 43, where melee\n"
+			 "registers a lightshield.\n"
+			 "Digital: time until the digital click, and the analog value\n"
+			 "at that point.\n"
+			 "Lag: time between the analog peak and the digital click.\n"
+			 "Positive values mean the click registered after the peak.", currXfb);
+	if (*pressed & PAD_TRIGGER_Z) {
+		state = TRIG_POST_SETUP;
+	}
+}
+
+// only run once
+static void setup(u32 *p, u32 *h) {
+	setSamplingRateHigh();
+	pressed = p;
+	held = h;
+	readTriggerRest = true;
+	cb = PAD_SetSamplingCallback(triggerCallback);
+	state = TRIG_POST_SETUP;
+	if (data.isDataReady && tState == TRIG_PRE_INPUT) {
+		tState = TRIG_POST_INPUT_LOCK;
+	}
+}
+
+void menu_triggerOscilloscope(void *currXfb, u32 *p, u32 *h) {
+	switch (state) {
+		case TRIG_SETUP:
+			setup(p, h);
+			break;
+		case TRIG_POST_SETUP:
+			switch (tState) {
+				case TRIG_PRE_INPUT:
+					printStr("Waiting for input.", currXfb);
+					setCursorPos(21, 0);
+					printStr(showRTrigger ? "Current trigger: R" : "Current trigger: L", currXfb);
+					break;
+				case TRIG_POST_INPUT_LOCK:
+					// dont allow new input until cooldown elapses
+					if (triggerCooldown != 0) {
+						triggerCooldown--;
+						if (triggerCooldown == 0) {
+							tState = TRIG_POST_INPUT;
+						}
+					} else {
+						setCursorPos(2, 28);
+						printStrColor("LOCKED", currXfb, COLOR_WHITE, COLOR_BLACK);
+					}
+				case TRIG_POST_INPUT:
+					if (!data.isDataReady) {
+						tState = TRIG_PRE_INPUT;
+						break;
+					}
+					if (!resultsReady) {
+						calculateResults();
+					}
+
+					// draw guidelines
+					DrawBox(SCREEN_TIMEPLOT_START - 1, SCREEN_POS_CENTER_Y - 128, SCREEN_TIMEPLOT_START + 500, SCREEN_POS_CENTER_Y + 128, COLOR_WHITE, currXfb);
+					DrawHLine(SCREEN_TIMEPLOT_START, SCREEN_TIMEPLOT_START + 500, TRIGGER_PLOT_BOTTOM - TRIGGER_SHIELD_THRESHOLD, COLOR_GREEN, currXfb);
+					setCursorPos(16, 0);
+					printStr("+43", currXfb);
+
+					// show all data if it will fit
+					if (data.endPoint < 500) {
+						dataScrollOffset = 0;
+					// move screen to end of data input if it was further from the last capture
+					} else if (dataScrollOffset > (data.endPoint) - 500) {
+						dataScrollOffset = data.endPoint - 501;
+					}
+
+					int prevAnalog = showRTrigger ? data.data[dataScrollOffset].tr : data.data[dataScrollOffset].tl;
+					u64 drawnTicksUs = 0;
+
+					// draw 500 datapoints from the scroll offset
+					PROFILE_BEGIN(PROFILE_WAVEFORM);
+					for (int i = dataScrollOffset + 1; i < dataScrollOffset + 500; i++) {
+						if (i == data.endPoint) {
+							break;
+						}
+						int x = i - dataScrollOffset;
+						int currAnalog = showRTrigger ? data.data[i].tr : data.data[i].tl;
+						bool currDigital = showRTrigger ? data.data[i].isDigitalRPressed : data.data[i].isDigitalLPressed;
+
+						// digital state is drawn as a strip along the bottom of the plot
+						if (currDigital) {
+							DrawVLine(SCREEN_TIMEPLOT_START + x, TRIGGER_PLOT_BOTTOM - 4, TRIGGER_PLOT_BOTTOM, COLOR_BLUE, currXfb);
+						}
+
+						DrawLine(SCREEN_TIMEPLOT_START + x - 1, TRIGGER_PLOT_BOTTOM - prevAnalog,
+								 SCREEN_TIMEPLOT_START + x, TRIGGER_PLOT_BOTTOM - currAnalog,
+								 COLOR_RED_C, currXfb);
+						prevAnalog = currAnalog;
+
+						drawnTicksUs += data.data[i].timeDiffUs;
+					}
+					PROFILE_END(PROFILE_WAVEFORM);
+
+					// do we have enough data to enable scrolling?
+					if (data.endPoint >= 500) {
+						if (*held & PAD_BUTTON_RIGHT) {
+							if (*held & PAD_TRIGGER_R) {
+								if (dataScrollOffset + 510 < data.endPoint) {
+									dataScrollOffset += 10;
+								}
+							} else {
+								if (dataScrollOffset + 501 < data.endPoint) {
+									dataScrollOffset++;
+								}
+							}
+						} else if (*held & PAD_BUTTON_LEFT) {
+							if (*held & PAD_TRIGGER_R) {
+								if (dataScrollOffset - 10 >= 0) {
+									dataScrollOffset -= 10;
+								}
+							} else {
+								if (dataScrollOffset - 1 >= 0) {
+									dataScrollOffset--;
+								}
+							}
+						}
+					}
+
+					setCursorPos(3, 0);
+					sprintf(strBuffer, "Trigger %c total: %u, %0.3f ms | Start: %d, Shown: %0.3f ms\n",
+							showRTrigger ? 'R' : 'L', data.endPoint, (data.totalTimeUs / ((float) 1000)),
+							dataScrollOffset + 1, (drawnTicksUs / ((float) 1000)));
+					printStr(strBuffer, currXfb);
+
+					// print results
+					setCursorPos(20, 0);
+					sprintf(strBuffer, "Travel: %0.2f ms | Peak: %d | ", travelTimeUs / 1000.0, peakValue);
+					printStr(strBuffer, currXfb);
+					if (reachedShield) {
+						sprintf(strBuffer, "Shield: %0.2f ms\n", timeToShieldUs / 1000.0);
+					} else {
+						sprintf(strBuffer, "Shield: Not reached\n");
+					}
+					printStr(strBuffer, currXfb);
+					if (digitalPressed) {
+						sprintf(strBuffer, "Digital: %0.2f ms @ %d, held %0.2f ms | Lag: %0.2f ms",
+								timeToDigitalUs / 1000.0, analogAtDigital, digitalHeldUs / 1000.0, analogDigitalLagUs / 1000.0);
+					} else {
+						sprintf(strBuffer, "Digital: Not pressed");
+					}
+					printStr(strBuffer, currXfb);
+					break;
+				default:
+					printStr("How did we get here?", currXfb);
+					break;
+			}
+			if (*pressed & PAD_BUTTON_A && tState != TRIG_PRE_INPUT) {
+				if (tState == TRIG_POST_INPUT_LOCK && triggerCooldown == 0) {
+					tState = TRIG_POST_INPUT;
+				} else {
+					tState = TRIG_POST_INPUT_LOCK;
+				}
+			}
+			if (*pressed & PAD_BUTTON_Y && !recording) {
+				showRTrigger = !showRTrigger;
+				readTriggerRest = true;
+				resultsReady = false;
+			}
+			if (*pressed & PAD_TRIGGER_Z) {
+				state = TRIG_INSTRUCTIONS;
+			}
+			break;
+		case TRIG_INSTRUCTIONS:
+			printInstructions(currXfb);
+			break;
+		default:
+			printStr("How did we get here?", currXfb);
+			break;
+	}
+}
+
+void menu_triggerOscilloscopeEnd() {
+	setSamplingRateNormal();
+	PAD_SetSamplingCallback(cb);
+	pressed = NULL;
+	held = NULL;
+	state = TRIG_SETUP;
+}
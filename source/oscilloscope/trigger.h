@@ -0,0 +1,20 @@
+//
+// Created on 2026/10/18.
+//
+
+#ifndef GTS_TRIGGER_H
+#define GTS_TRIGGER_H
+
+#include <gccore.h>
+#include "../waveform.h"
+
+// analog value where melee starts registering a (light)shield
+#define TRIGGER_SHIELD_THRESHOLD 43
+
+enum TRIG_MENU_STATE { TRIG_SETUP, TRIG_POST_SETUP, TRIG_INSTRUCTIONS };
+enum TRIG_STATE { TRIG_PRE_INPUT, TRIG_POST_INPUT, TRIG_POST_INPUT_LOCK };
+
+void menu_triggerOscilloscope(void *currXfb, u32 *p, u32 *h);
+void menu_triggerOscilloscopeEnd();
+
+#endif //GTS_TRIGGER_H
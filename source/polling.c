@@ -7,9 +7,7 @@
 #include <ogc/video_types.h>
 #include <ogc/si.h>
 
-#ifdef DEBUGLOG
-#include "gecko.h"
-#endif
+#include "logging.h"
 
 static bool unsupportedMode = false;
 static bool firstRun = true;
@@ -26,25 +24,19 @@ void __setStaticXYValues() {
 		case VI_INTERLACE:
 			xLineCountNormal = 131;
 			xLineCountHigh = 11;
-#ifdef DEBUGLOG
-			sendMessage("Video scan mode is interlaced");
-#endif
+			LOG_INFO("Video scan mode is interlaced");
 			break;
 		case VI_PROGRESSIVE:
 			xLineCountNormal = 263;
 			xLineCountHigh = 22;
-#ifdef DEBUGLOG
-			sendMessage("Video scan mode is progressive");
-#endif
+			LOG_INFO("Video scan mode is progressive");
 			break;
 		case VI_NON_INTERLACE:
 		default:
 			//xLineCountNormal = 240;
 			//xLineCountHigh = 240;
 			unsupportedMode = true;
-#ifdef DEBUGLOG
-			sendMessage("Video scan mode is unsupported");
-#endif
+			LOG_WARN("Video scan mode is unsupported");
 	}
 	firstRun = false;
 }
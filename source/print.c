@@ -13,6 +13,7 @@
 #include "print.h"
 #include "font.h"
 #include "draw.h"
+#include "profiler.h"
 #include <ogc/color.h>
 
 static int currX = 0;
@@ -79,6 +80,7 @@ void drawString(unsigned char bitmap[],
                 const uint32_t bg_color,
 				const uint32_t fg_color,
                 const char string[]) {
+	PROFILE_SCOPE(PROFILE_TEXT);
 	uint16_t i = 0;
 	const char nullChar[] = "";
 	while(string[i] != nullChar[0]) {
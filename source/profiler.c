@@ -0,0 +1,153 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "profiler.h"
+
+#ifdef PROFILE
+
+#include <stdio.h>
+#include <string.h>
+#include <gccore.h>
+#include <ogc/lwp_watchdog.h>
+#include "print.h"
+
+typedef struct ProfileFrame {
+	u32 totalTicks;
+	u32 selfTicks;
+	u32 calls;
+} ProfileFrame;
+
+typedef struct ProfileStackEntry {
+	enum PROFILE_ZONE zone;
+	u64 start;
+	// time spent in zones started inside this one
+	u64 childTicks;
+} ProfileStackEntry;
+
+static const char *ZONE_NAMES[PROFILE_ZONE_LEN] = { "menu", "text", "shapes", "image", "wave", "analysis", "export" };
+
+static ProfileStackEntry stack[PROFILE_MAX_DEPTH];
+static int depth = 0;
+// how many times each zone is running, only the outermost one is timed
+static int running[PROFILE_ZONE_LEN];
+
+static ProfileFrame current[PROFILE_ZONE_LEN];
+static ProfileFrame ring[PROFILE_ZONE_LEN][PROFILE_RING_FRAMES];
+static u32 ringPos = 0;
+static u32 ringFrames = 0;
+static u32 worstTicks[PROFILE_ZONE_LEN];
+
+// set while the profiler draws, so the overlay doesn't time itself
+static bool suspended = false;
+
+int profile_begin(enum PROFILE_ZONE zone) {
+	if (suspended) {
+		return zone;
+	}
+	running[zone]++;
+	if (running[zone] > 1 || depth == PROFILE_MAX_DEPTH) {
+		return zone;
+	}
+	stack[depth].zone = zone;
+	stack[depth].childTicks = 0;
+	stack[depth].start = gettime();
+	depth++;
+	return zone;
+}
+
+void profile_end(enum PROFILE_ZONE zone) {
+	u64 now = gettime();
+	if (suspended || running[zone] == 0) {
+		return;
+	}
+	running[zone]--;
+	if (running[zone] > 0 || depth == 0 || stack[depth - 1].zone != zone) {
+		return;
+	}
+	depth--;
+	u64 total = now - stack[depth].start;
+	current[zone].totalTicks += total;
+	current[zone].selfTicks += total - stack[depth].childTicks;
+	current[zone].calls++;
+	if (depth > 0) {
+		stack[depth - 1].childTicks += total;
+	}
+}
+
+void profile_scopeEnd(int *zone) {
+	profile_end(*zone);
+}
+
+void profile_endFrame() {
+	for (int i = 0; i < PROFILE_ZONE_LEN; i++) {
+		ring[i][ringPos] = current[i];
+		if (current[i].totalTicks > worstTicks[i]) {
+			worstTicks[i] = current[i].totalTicks;
+		}
+	}
+	memset(current, 0, sizeof(current));
+	ringPos = (ringPos + 1) % PROFILE_RING_FRAMES;
+	if (ringFrames < PROFILE_RING_FRAMES) {
+		ringFrames++;
+	}
+}
+
+void profile_drawOverlay(void *currXfb) {
+	if (ringFrames == 0) {
+		return;
+	}
+	suspended = true;
+	char line[64];
+	setCursorPos(14, 34);
+	printStrColor("zone     avg  self worst", currXfb, COLOR_WHITE, COLOR_BLACK);
+	for (int i = 0; i < PROFILE_ZONE_LEN; i++) {
+		u64 total = 0, self = 0;
+		u32 recentWorst = 0;
+		for (int j = 0; j < ringFrames; j++) {
+			total += ring[i][j].totalTicks;
+			self += ring[i][j].selfTicks;
+			if (ring[i][j].totalTicks > recentWorst) {
+				recentWorst = ring[i][j].totalTicks;
+			}
+		}
+		// microseconds, worst is over the frames in the ring
+		snprintf(line, sizeof(line), "%-8s%5u %5u %5u", ZONE_NAMES[i], (u32) ticks_to_microsecs(total / ringFrames),
+		         (u32) ticks_to_microsecs(self / ringFrames), (u32) ticks_to_microsecs(recentWorst));
+		setCursorPos(15 + i, 34);
+		printStrColor(line, currXfb, COLOR_WHITE, COLOR_BLACK);
+	}
+	suspended = false;
+}
+
+int profile_dump(const char *path) {
+	FILE *fptr = fopen(path, "w");
+	if (fptr == NULL) {
+		return 1;
+	}
+	fprintf(fptr, "frame");
+	for (int i = 0; i < PROFILE_ZONE_LEN; i++) {
+		fprintf(fptr, ",%s_us,%s_self_us,%s_calls", ZONE_NAMES[i], ZONE_NAMES[i], ZONE_NAMES[i]);
+	}
+	fprintf(fptr, "\n");
+	// oldest first
+	u32 start = (ringPos + PROFILE_RING_FRAMES - ringFrames) % PROFILE_RING_FRAMES;
+	for (u32 j = 0; j < ringFrames; j++) {
+		u32 pos = (start + j) % PROFILE_RING_FRAMES;
+		fprintf(fptr, "%u", j);
+		for (int i = 0; i < PROFILE_ZONE_LEN; i++) {
+			fprintf(fptr, ",%u,%u,%u", (u32) ticks_to_microsecs(ring[i][pos].totalTicks),
+			        (u32) ticks_to_microsecs(ring[i][pos].selfTicks), ring[i][pos].calls);
+		}
+		fprintf(fptr, "\n");
+	}
+	// worst frame for each zone since boot
+	fprintf(fptr, "worst");
+	for (int i = 0; i < PROFILE_ZONE_LEN; i++) {
+		fprintf(fptr, ",%u,,", (u32) ticks_to_microsecs(worstTicks[i]));
+	}
+	fprintf(fptr, "\n");
+	return fclose(fptr) == 0 ? 0 : 1;
+}
+
+#endif
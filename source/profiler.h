@@ -0,0 +1,53 @@
+//
+// Created on 2026/10/18.
+//
+
+// zone profiler, only built with PROFILE=1 (make profile), otherwise every macro here compiles to nothing
+// zones nest, so each one has a total time and a self time that leaves out the zones inside it
+// a zone that's already running (DrawBox calling DrawHLine) isn't counted again
+// the last PROFILE_RING_FRAMES frames are kept per zone, for the overlay and the dump to the sd card
+// only the main thread should use these, the sampling callback runs in an interrupt
+
+#ifndef GTS_PROFILER_H
+#define GTS_PROFILER_H
+
+enum PROFILE_ZONE { PROFILE_MENU, PROFILE_TEXT, PROFILE_SHAPES, PROFILE_IMAGE, PROFILE_WAVEFORM, PROFILE_ANALYSIS,
+                    PROFILE_EXPORT, PROFILE_ZONE_LEN };
+
+#ifdef PROFILE
+
+#define PROFILE_RING_FRAMES 120
+#define PROFILE_MAX_DEPTH 16
+#define PROFILE_PATH "/GTS/profile.csv"
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// times the rest of the enclosing block
+#define PROFILE_SCOPE(zone) \
+	int PROFILE_CONCAT(profileScope, __LINE__) __attribute__((cleanup(profile_scopeEnd), unused)) = profile_begin(zone)
+#define PROFILE_BEGIN(zone) profile_begin(zone)
+#define PROFILE_END(zone) profile_end(zone)
+
+int profile_begin(enum PROFILE_ZONE zone);
+void profile_end(enum PROFILE_ZONE zone);
+void profile_scopeEnd(int *zone);
+
+// move this frame's times into the rings, call once a frame after the menu has run
+void profile_endFrame();
+
+// rolling average and worst case of each zone, in the bottom right
+void profile_drawOverlay(void *currXfb);
+
+// every frame in the rings as csv, one row a frame, returns 0 on success
+int profile_dump(const char *path);
+
+#else
+
+#define PROFILE_SCOPE(zone)
+#define PROFILE_BEGIN(zone)
+#define PROFILE_END(zone)
+
+#endif
+
+#endif //GTS_PROFILER_H
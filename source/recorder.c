@@ -0,0 +1,181 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "recorder.h"
+#include <string.h>
+
+// big enough for one full block
+static uint8_t ioBuffer[RECORDER_BLOCK_HEADER_BYTES + (RECORDER_BLOCK_SAMPLES * RECORDER_SAMPLE_BYTES)];
+
+static void putU16(uint8_t *buf, uint16_t value) {
+	buf[0] = value & 0xFF;
+	buf[1] = (value >> 8) & 0xFF;
+}
+
+static void putU32(uint8_t *buf, uint32_t value) {
+	buf[0] = value & 0xFF;
+	buf[1] = (value >> 8) & 0xFF;
+	buf[2] = (value >> 16) & 0xFF;
+	buf[3] = (value >> 24) & 0xFF;
+}
+
+static uint16_t getU16(const uint8_t *buf) {
+	return buf[0] | (buf[1] << 8);
+}
+
+static uint32_t getU32(const uint8_t *buf) {
+	return ((uint32_t) buf[0]) | ((uint32_t) buf[1] << 8) | ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+void recorder_init(Recorder *rec) {
+	rec->produced = 0;
+	rec->consumed = 0;
+	rec->droppedPending = 0;
+	rec->droppedTotal = 0;
+	rec->samplesTotal = 0;
+	for (int i = 0; i < RECORDER_BLOCKS; i++) {
+		rec->blocks[i].count = 0;
+	}
+}
+
+bool recorder_push(Recorder *rec, const RecordSample *sample, uint32_t timeUs) {
+	uint32_t produced = rec->produced;
+	if (produced - rec->consumed >= RECORDER_BLOCKS) {
+		rec->droppedPending++;
+		rec->droppedTotal++;
+		return false;
+	}
+
+	RecorderBlock *block = &rec->blocks[produced & (RECORDER_BLOCKS - 1)];
+	if (block->count == 0) {
+		block->sequence = produced;
+		block->dropped = rec->droppedPending;
+		block->firstTimeUs = timeUs;
+		rec->droppedPending = 0;
+	}
+	block->samples[block->count] = *sample;
+	block->count++;
+	rec->samplesTotal++;
+
+	// the block is full, hand it to the writer
+	if (block->count == RECORDER_BLOCK_SAMPLES) {
+		rec->produced = produced + 1;
+	}
+	return true;
+}
+
+void recorder_flushPartial(Recorder *rec) {
+	uint32_t produced = rec->produced;
+	if (produced - rec->consumed >= RECORDER_BLOCKS) {
+		return;
+	}
+	if (rec->blocks[produced & (RECORDER_BLOCKS - 1)].count != 0) {
+		rec->produced = produced + 1;
+	}
+}
+
+RecorderBlock *recorder_nextFull(Recorder *rec) {
+	uint32_t consumed = rec->consumed;
+	if (consumed == rec->produced) {
+		return NULL;
+	}
+	return &rec->blocks[consumed & (RECORDER_BLOCKS - 1)];
+}
+
+void recorder_release(Recorder *rec) {
+	uint32_t consumed = rec->consumed;
+	// reset before handing the block back, the producer uses count == 0 to start a new block
+	rec->blocks[consumed & (RECORDER_BLOCKS - 1)].count = 0;
+	rec->consumed = consumed + 1;
+}
+
+uint32_t recorder_pending(const Recorder *rec) {
+	return rec->produced - rec->consumed;
+}
+
+bool recorder_writeHeader(FILE *fptr) {
+	uint8_t *buf = ioBuffer;
+	memcpy(buf, RECORDER_MAGIC, 4);
+	putU16(buf + 4, RECORDER_VERSION);
+	putU16(buf + 6, RECORDER_SAMPLE_BYTES);
+	putU32(buf + 8, RECORDER_BLOCK_SAMPLES);
+	putU32(buf + 12, 0);
+	return fwrite(buf, 1, RECORDER_FILE_HEADER_BYTES, fptr) == RECORDER_FILE_HEADER_BYTES;
+}
+
+uint32_t recorder_writeBlock(FILE *fptr, const RecorderBlock *block) {
+	uint8_t *buf = ioBuffer;
+	putU32(buf, block->sequence);
+	putU32(buf + 4, block->count);
+	putU32(buf + 8, block->dropped);
+	putU32(buf + 12, block->firstTimeUs);
+	buf += RECORDER_BLOCK_HEADER_BYTES;
+
+	for (uint32_t i = 0; i < block->count; i++) {
+		const RecordSample *sample = &block->samples[i];
+		buf[0] = (uint8_t) sample->ax;
+		buf[1] = (uint8_t) sample->ay;
+		buf[2] = (uint8_t) sample->cx;
+		buf[3] = (uint8_t) sample->cy;
+		buf[4] = sample->tl;
+		buf[5] = sample->tr;
+		putU16(buf + 6, sample->buttons);
+		putU16(buf + 8, sample->intervalUs);
+		buf += RECORDER_SAMPLE_BYTES;
+	}
+
+	// one write per block, small writes are really slow on the sd card
+	uint32_t len = RECORDER_BLOCK_HEADER_BYTES + (block->count * RECORDER_SAMPLE_BYTES);
+	if (fwrite(ioBuffer, 1, len, fptr) != len) {
+		return 0;
+	}
+	return len;
+}
+
+bool recorder_readHeader(FILE *fptr, RecorderFileHeader *header) {
+	uint8_t *buf = ioBuffer;
+	if (fread(buf, 1, RECORDER_FILE_HEADER_BYTES, fptr) != RECORDER_FILE_HEADER_BYTES) {
+		return false;
+	}
+	if (memcmp(buf, RECORDER_MAGIC, 4) != 0) {
+		return false;
+	}
+	header->version = getU16(buf + 4);
+	header->sampleBytes = getU16(buf + 6);
+	header->samplesPerBlock = getU32(buf + 8);
+	return header->version == RECORDER_VERSION && header->sampleBytes == RECORDER_SAMPLE_BYTES &&
+	       header->samplesPerBlock <= RECORDER_BLOCK_SAMPLES;
+}
+
+bool recorder_readBlock(FILE *fptr, RecorderBlock *block) {
+	uint8_t *buf = ioBuffer;
+	if (fread(buf, 1, RECORDER_BLOCK_HEADER_BYTES, fptr) != RECORDER_BLOCK_HEADER_BYTES) {
+		return false;
+	}
+	block->sequence = getU32(buf);
+	block->count = getU32(buf + 4);
+	block->dropped = getU32(buf + 8);
+	block->firstTimeUs = getU32(buf + 12);
+	if (block->count > RECORDER_BLOCK_SAMPLES) {
+		return false;
+	}
+
+	uint32_t len = block->count * RECORDER_SAMPLE_BYTES;
+	if (fread(buf, 1, len, fptr) != len) {
+		return false;
+	}
+	for (uint32_t i = 0; i < block->count; i++) {
+		RecordSample *sample = &block->samples[i];
+		sample->ax = (int8_t) buf[0];
+		sample->ay = (int8_t) buf[1];
+		sample->cx = (int8_t) buf[2];
+		sample->cy = (int8_t) buf[3];
+		sample->tl = buf[4];
+		sample->tr = buf[5];
+		sample->buttons = getU16(buf + 6);
+		sample->intervalUs = getU16(buf + 8);
+		buf += RECORDER_SAMPLE_BYTES;
+	}
+	return true;
+}
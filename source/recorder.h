@@ -0,0 +1,95 @@
+//
+// Created on 2026/10/18.
+//
+
+// block buffers and file format for streaming recordings
+// the sampling callback fills blocks, and a writer thread saves full ones to a file
+// host/recorder.c round-trips a recording through this, with a temporary file standing in for the sd card
+
+#ifndef GTS_RECORDER_H
+#define GTS_RECORDER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// both must be a power of two
+// at ~1400 polls per second, one block is ~3 seconds, so the writer can fall ~9 seconds behind before anything drops
+#define RECORDER_BLOCKS 4
+#define RECORDER_BLOCK_SAMPLES 4096
+
+// file layout, everything little endian:
+// file header:  "GTSR", u16 version, u16 bytes per sample, u32 samples per block, u32 reserved
+// each block:   u32 sequence, u32 sample count, u32 samples dropped before this block, u32 first sample time (us),
+//               then the samples
+// each sample:  s8 ax, s8 ay, s8 cx, s8 cy, u8 tl, u8 tr, u16 buttons held, u16 time from previous poll (us)
+#define RECORDER_MAGIC "GTSR"
+#define RECORDER_VERSION 1
+#define RECORDER_FILE_HEADER_BYTES 16
+#define RECORDER_BLOCK_HEADER_BYTES 16
+#define RECORDER_SAMPLE_BYTES 10
+
+typedef struct RecordSample {
+	int8_t ax;
+	int8_t ay;
+	int8_t cx;
+	int8_t cy;
+	uint8_t tl;
+	uint8_t tr;
+	uint16_t buttons;
+	// clamped to 65535
+	uint16_t intervalUs;
+} RecordSample;
+
+typedef struct RecorderBlock {
+	uint32_t sequence;
+	uint32_t count;
+	uint32_t dropped;
+	uint32_t firstTimeUs;
+	RecordSample samples[RECORDER_BLOCK_SAMPLES];
+} RecorderBlock;
+
+typedef struct Recorder {
+	RecorderBlock blocks[RECORDER_BLOCKS];
+	// blocks handed to the writer, only written by the producer
+	volatile uint32_t produced;
+	// blocks the writer is done with, only written by the consumer
+	volatile uint32_t consumed;
+	// producer side counters
+	uint32_t droppedPending;
+	volatile uint32_t droppedTotal;
+	volatile uint32_t samplesTotal;
+} Recorder;
+
+typedef struct RecorderFileHeader {
+	uint16_t version;
+	uint16_t sampleBytes;
+	uint32_t samplesPerBlock;
+} RecorderFileHeader;
+
+void recorder_init(Recorder *rec);
+
+// producer side, meant to be called from the sampling callback
+// returns false if every block is waiting on the writer, in which case the sample is counted as dropped
+bool recorder_push(Recorder *rec, const RecordSample *sample, uint32_t timeUs);
+
+// hand off a partially filled block, only call this once the producer has stopped
+void recorder_flushPartial(Recorder *rec);
+
+// consumer side, returns NULL if there's no full block waiting
+RecorderBlock *recorder_nextFull(Recorder *rec);
+// mark the block from recorder_nextFull as written, so the producer can reuse it
+void recorder_release(Recorder *rec);
+
+// number of full blocks waiting on the writer
+uint32_t recorder_pending(const Recorder *rec);
+
+// file io, these share a static buffer, so only one thread should use them at a time
+bool recorder_writeHeader(FILE *fptr);
+// returns the number of bytes written, 0 on failure
+uint32_t recorder_writeBlock(FILE *fptr, const RecorderBlock *block);
+bool recorder_readHeader(FILE *fptr, RecorderFileHeader *header);
+// returns false at the end of the file, or if the block is malformed
+bool recorder_readBlock(FILE *fptr, RecorderBlock *block);
+
+#endif //GTS_RECORDER_H
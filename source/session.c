@@ -0,0 +1,165 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "session.h"
+#include <string.h>
+
+static void putU16(uint8_t *buf, uint16_t value) {
+	buf[0] = value & 0xFF;
+	buf[1] = (value >> 8) & 0xFF;
+}
+
+static void putU32(uint8_t *buf, uint32_t value) {
+	buf[0] = value & 0xFF;
+	buf[1] = (value >> 8) & 0xFF;
+	buf[2] = (value >> 16) & 0xFF;
+	buf[3] = (value >> 24) & 0xFF;
+}
+
+static uint16_t getU16(const uint8_t *buf) {
+	return buf[0] | (buf[1] << 8);
+}
+
+static uint32_t getU32(const uint8_t *buf) {
+	return ((uint32_t) buf[0]) | ((uint32_t) buf[1] << 8) | ((uint32_t) buf[2] << 16) | ((uint32_t) buf[3] << 24);
+}
+
+static void encodeEntry(const SessionEntry *entry, uint8_t *buf) {
+	memset(buf, 0, SESSION_ENTRY_BYTES);
+	putU32(buf, entry->frame);
+	putU16(buf + 4, entry->offsetUs);
+	putU16(buf + 6, entry->buttons);
+	buf[8] = (uint8_t) entry->stickX;
+	buf[9] = (uint8_t) entry->stickY;
+	buf[10] = (uint8_t) entry->substickX;
+	buf[11] = (uint8_t) entry->substickY;
+	buf[12] = entry->triggerL;
+	buf[13] = entry->triggerR;
+	buf[14] = entry->connected ? 1 : 0;
+}
+
+static void decodeEntry(const uint8_t *buf, SessionEntry *entry) {
+	entry->frame = getU32(buf);
+	entry->offsetUs = getU16(buf + 4);
+	entry->buttons = getU16(buf + 6);
+	entry->stickX = (int8_t) buf[8];
+	entry->stickY = (int8_t) buf[9];
+	entry->substickX = (int8_t) buf[10];
+	entry->substickY = (int8_t) buf[11];
+	entry->triggerL = buf[12];
+	entry->triggerR = buf[13];
+	entry->connected = buf[14] != 0;
+}
+
+static bool samePad(const SessionEntry *a, const SessionEntry *b) {
+	return a->connected == b->connected && a->buttons == b->buttons && a->stickX == b->stickX &&
+	       a->stickY == b->stickY && a->substickX == b->substickX && a->substickY == b->substickY &&
+	       a->triggerL == b->triggerL && a->triggerR == b->triggerR;
+}
+
+void session_init(Session *session, SessionEntry *entries, uint32_t capacity, uint32_t scanMode,
+                  const SessionEntry *origin) {
+	session->entries = entries;
+	session->capacity = capacity;
+	session->count = 0;
+	session->full = false;
+	session->frames = 0;
+	session->scanMode = scanMode;
+	session->origin = *origin;
+	session->next = 0;
+}
+
+bool session_record(Session *session, const SessionEntry *entry) {
+	if (session->full) {
+		return false;
+	}
+	session_markFrame(session, entry->frame);
+	if (session->count != 0 && samePad(&session->entries[session->count - 1], entry)) {
+		return true;
+	}
+	if (session->count == session->capacity) {
+		session->full = true;
+		return false;
+	}
+	session->entries[session->count++] = *entry;
+	return true;
+}
+
+void session_markFrame(Session *session, uint32_t frame) {
+	if (!session->full && frame + 1 > session->frames) {
+		session->frames = frame + 1;
+	}
+}
+
+const SessionEntry *session_replay(Session *session, uint32_t frame, uint16_t offsetUs) {
+	while (session->next < session->count) {
+		const SessionEntry *entry = &session->entries[session->next];
+		if (entry->frame > frame || (entry->frame == frame && entry->offsetUs > offsetUs)) {
+			break;
+		}
+		session->next++;
+	}
+	if (session->next == 0) {
+		return NULL;
+	}
+	return &session->entries[session->next - 1];
+}
+
+bool session_replayDone(const Session *session, uint32_t frame) {
+	return frame >= session->frames;
+}
+
+int session_write(FILE *fptr, const Session *session) {
+	uint8_t buf[SESSION_HEADER_BYTES];
+	memcpy(buf, SESSION_MAGIC, 4);
+	putU16(buf + 4, SESSION_VERSION);
+	putU16(buf + 6, SESSION_ENTRY_BYTES);
+	putU32(buf + 8, session->scanMode);
+	putU32(buf + 12, session->count);
+	putU32(buf + 16, session->frames);
+	encodeEntry(&session->origin, buf + 20);
+	if (fwrite(buf, 1, SESSION_HEADER_BYTES, fptr) != SESSION_HEADER_BYTES) {
+		return 1;
+	}
+	for (uint32_t i = 0; i < session->count; i++) {
+		encodeEntry(&session->entries[i], buf);
+		if (fwrite(buf, 1, SESSION_ENTRY_BYTES, fptr) != SESSION_ENTRY_BYTES) {
+			return 1;
+		}
+	}
+	return 0;
+}
+
+int session_read(FILE *fptr, Session *session) {
+	uint8_t buf[SESSION_HEADER_BYTES];
+	if (fread(buf, 1, SESSION_HEADER_BYTES, fptr) != SESSION_HEADER_BYTES || memcmp(buf, SESSION_MAGIC, 4) != 0 ||
+	    getU16(buf + 4) != SESSION_VERSION || getU16(buf + 6) != SESSION_ENTRY_BYTES) {
+		return 1;
+	}
+	uint32_t count = getU32(buf + 12);
+	if (count > session->capacity) {
+		return 2;
+	}
+	session->scanMode = getU32(buf + 8);
+	session->frames = getU32(buf + 16);
+	decodeEntry(buf + 20, &session->origin);
+	session->count = 0;
+	session->full = false;
+	session->next = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (fread(buf, 1, SESSION_ENTRY_BYTES, fptr) != SESSION_ENTRY_BYTES) {
+			return 1;
+		}
+		SessionEntry *entry = &session->entries[i];
+		decodeEntry(buf, entry);
+		// entries have to be in time order for replay
+		if (i != 0 && (entry->frame < session->entries[i - 1].frame ||
+		               (entry->frame == session->entries[i - 1].frame &&
+		                entry->offsetUs < session->entries[i - 1].offsetUs))) {
+			return 1;
+		}
+		session->count++;
+	}
+	return 0;
+}
@@ -0,0 +1,79 @@
+//
+// Created on 2026/10/18.
+//
+
+// recorded controller sessions, for replaying the same input through the menus on a later build
+// every PAD_ScanPads is logged, both the menu's once a frame and the sampling callback's, against the frame it
+// happened in and how far into that frame it was
+// only scans that changed something are kept, replay hands back the latest entry at or before the current time,
+// so a still controller costs nothing
+
+#ifndef GTS_SESSION_H
+#define GTS_SESSION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+// file layout, everything little endian:
+// header:  "GTSS", u16 version, u16 bytes per entry, u32 scan mode (VI_INTERLACE or VI_PROGRESSIVE),
+//          u32 entry count, u32 frames recorded, then the controller's origin as an entry with frame and time 0
+// entries: u32 frame, u16 time into the frame (us), u16 buttons held, s8 stick x, s8 stick y,
+//          s8 c-stick x, s8 c-stick y, u8 trigger l, u8 trigger r, u8 connected, u8 reserved
+#define SESSION_MAGIC "GTSS"
+#define SESSION_VERSION 1
+#define SESSION_HEADER_BYTES 36
+#define SESSION_ENTRY_BYTES 16
+
+typedef struct SessionEntry {
+	uint32_t frame;
+	uint16_t offsetUs;
+	uint16_t buttons;
+	int8_t stickX;
+	int8_t stickY;
+	int8_t substickX;
+	int8_t substickY;
+	uint8_t triggerL;
+	uint8_t triggerR;
+	bool connected;
+} SessionEntry;
+
+typedef struct Session {
+	SessionEntry *entries;
+	uint32_t capacity;
+	uint32_t count;
+	// set when an entry didn't fit, recording stops there
+	bool full;
+	// frames covered, replay ends after this
+	uint32_t frames;
+	uint32_t scanMode;
+	// what PAD_GetOrigin gave when recording started, the menus show values relative to it
+	SessionEntry origin;
+	// replay position
+	uint32_t next;
+} Session;
+
+// entries is caller owned, the session never allocates
+void session_init(Session *session, SessionEntry *entries, uint32_t capacity, uint32_t scanMode,
+                  const SessionEntry *origin);
+
+// adds the entry if the pad state differs from the last one
+// returns false once the session is full
+bool session_record(Session *session, const SessionEntry *entry);
+
+// note that this frame happened, even if nothing was recorded in it
+void session_markFrame(Session *session, uint32_t frame);
+
+// the latest entry at or before the given time, or NULL before the first entry
+// time has to move forward between calls, like it does on the console
+const SessionEntry *session_replay(Session *session, uint32_t frame, uint16_t offsetUs);
+
+bool session_replayDone(const Session *session, uint32_t frame);
+
+// returns 0 on success
+int session_write(FILE *fptr, const Session *session);
+
+// reads into the session's entries, returns 0 on success, 1 if the file isn't a session, 2 if it doesn't fit
+int session_read(FILE *fptr, Session *session);
+
+#endif //GTS_SESSION_H
@@ -0,0 +1,254 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "sessionpad.h"
+
+#ifdef SESSION
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ogc/irq.h>
+#include <ogc/lwp_watchdog.h>
+#include <ogc/video.h>
+#include "session.h"
+
+// a still controller logs nothing, so this is minutes of normal use, and ~45 seconds of constant stick movement
+// at the oscilloscope's polling rate
+#define SESSION_MAX_ENTRIES (1 << 16)
+
+enum SESSION_STATE { SESSION_IDLE, SESSION_RECORDING, SESSION_REPLAYING, SESSION_FINISHED };
+
+static enum SESSION_STATE state = SESSION_IDLE;
+static Session session;
+static SessionEntry *entries = NULL;
+
+// frames since recording or replay started, bumped by the retrace callback
+static volatile u32 frame = 0;
+static volatile u64 frameStartTick = 0;
+
+// what the wrapped getters hand back while replaying
+static SessionEntry current;
+static u16 prevButtons = 0;
+
+// the real libogc functions, see the --wrap flags in the makefiles
+u32 __real_PAD_ScanPads(void);
+u16 __real_PAD_ButtonsUp(int chan);
+u16 __real_PAD_ButtonsDown(int chan);
+u16 __real_PAD_ButtonsHeld(int chan);
+s8 __real_PAD_StickX(int chan);
+s8 __real_PAD_StickY(int chan);
+s8 __real_PAD_SubStickX(int chan);
+s8 __real_PAD_SubStickY(int chan);
+u8 __real_PAD_TriggerL(int chan);
+u8 __real_PAD_TriggerR(int chan);
+void __real_PAD_GetOrigin(PADStatus *origin);
+
+void sessionPad_onRetrace() {
+	frame++;
+	frameStartTick = gettime();
+}
+
+static bool allocEntries() {
+	if (entries == NULL) {
+		entries = malloc(sizeof(SessionEntry) * SESSION_MAX_ENTRIES);
+	}
+	return entries != NULL;
+}
+
+static u16 currentOffsetUs() {
+	u32 us = ticks_to_microsecs(gettime() - frameStartTick);
+	return us > 0xFFFF ? 0xFFFF : us;
+}
+
+int sessionPad_startRecording() {
+	if (!allocEntries()) {
+		return 1;
+	}
+	PADStatus origin[PAD_CHANMAX];
+	__real_PAD_GetOrigin(origin);
+	SessionEntry originEntry = { .buttons = origin[0].button, .stickX = origin[0].stickX,
+	                             .stickY = origin[0].stickY, .substickX = origin[0].substickX,
+	                             .substickY = origin[0].substickY, .triggerL = origin[0].triggerL,
+	                             .triggerR = origin[0].triggerR, .connected = true };
+
+	u32 level = IRQ_Disable();
+	session_init(&session, entries, SESSION_MAX_ENTRIES, VIDEO_GetScanMode(), &originEntry);
+	frame = 0;
+	frameStartTick = gettime();
+	state = SESSION_RECORDING;
+	IRQ_Restore(level);
+	return 0;
+}
+
+int sessionPad_startReplay(const char *path) {
+	if (!allocEntries()) {
+		return 4;
+	}
+	FILE *fptr = fopen(path, "rb");
+	if (fptr == NULL) {
+		return 1;
+	}
+	session.entries = entries;
+	session.capacity = SESSION_MAX_ENTRIES;
+	int ret = session_read(fptr, &session);
+	fclose(fptr);
+	if (ret != 0) {
+		return 2;
+	}
+	if (session.scanMode != VIDEO_GetScanMode()) {
+		return 3;
+	}
+
+	u32 level = IRQ_Disable();
+	memset(&current, 0, sizeof(current));
+	current.connected = true;
+	prevButtons = 0;
+	frame = 0;
+	frameStartTick = gettime();
+	state = SESSION_REPLAYING;
+	IRQ_Restore(level);
+	return 0;
+}
+
+int sessionPad_save(const char *path) {
+	if (state != SESSION_RECORDING) {
+		return 1;
+	}
+	state = SESSION_IDLE;
+	FILE *fptr = fopen(path, "wb");
+	if (fptr == NULL) {
+		return 1;
+	}
+	int ret = session_write(fptr, &session);
+	fclose(fptr);
+	return ret;
+}
+
+bool sessionPad_isRecording() {
+	return state == SESSION_RECORDING;
+}
+
+bool sessionPad_isReplaying() {
+	return state == SESSION_REPLAYING;
+}
+
+bool sessionPad_replayFinished() {
+	return state == SESSION_FINISHED;
+}
+
+bool sessionPad_isFull() {
+	return session.full;
+}
+
+// the sampling callback scans from an interrupt, so everything touching the session has interrupts off
+u32 __wrap_PAD_ScanPads(void) {
+	u32 level = IRQ_Disable();
+	if (state == SESSION_REPLAYING) {
+		if (session_replayDone(&session, frame)) {
+			state = SESSION_FINISHED;
+		} else {
+			prevButtons = current.buttons;
+			const SessionEntry *entry = session_replay(&session, frame, currentOffsetUs());
+			if (entry != NULL) {
+				current = *entry;
+			}
+			IRQ_Restore(level);
+			return current.connected ? 1 : 0;
+		}
+	}
+	IRQ_Restore(level);
+
+	u32 connected = __real_PAD_ScanPads();
+
+	level = IRQ_Disable();
+	if (state == SESSION_RECORDING) {
+		SessionEntry entry = { .frame = frame, .offsetUs = currentOffsetUs(), .buttons = __real_PAD_ButtonsHeld(0),
+		                       .stickX = __real_PAD_StickX(0), .stickY = __real_PAD_StickY(0),
+		                       .substickX = __real_PAD_SubStickX(0), .substickY = __real_PAD_SubStickY(0),
+		                       .triggerL = __real_PAD_TriggerL(0), .triggerR = __real_PAD_TriggerR(0),
+		                       .connected = (connected & 1) == 1 };
+		session_record(&session, &entry);
+	}
+	IRQ_Restore(level);
+	return connected;
+}
+
+u16 __wrap_PAD_ButtonsUp(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? (prevButtons & ~current.buttons) : 0;
+	}
+	return __real_PAD_ButtonsUp(chan);
+}
+
+u16 __wrap_PAD_ButtonsDown(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? (current.buttons & ~prevButtons) : 0;
+	}
+	return __real_PAD_ButtonsDown(chan);
+}
+
+u16 __wrap_PAD_ButtonsHeld(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? current.buttons : 0;
+	}
+	return __real_PAD_ButtonsHeld(chan);
+}
+
+s8 __wrap_PAD_StickX(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? current.stickX : 0;
+	}
+	return __real_PAD_StickX(chan);
+}
+
+s8 __wrap_PAD_StickY(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? current.stickY : 0;
+	}
+	return __real_PAD_StickY(chan);
+}
+
+s8 __wrap_PAD_SubStickX(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? current.substickX : 0;
+	}
+	return __real_PAD_SubStickX(chan);
+}
+
+s8 __wrap_PAD_SubStickY(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? current.substickY : 0;
+	}
+	return __real_PAD_SubStickY(chan);
+}
+
+u8 __wrap_PAD_TriggerL(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? current.triggerL : 0;
+	}
+	return __real_PAD_TriggerL(chan);
+}
+
+u8 __wrap_PAD_TriggerR(int chan) {
+	if (state == SESSION_REPLAYING) {
+		return chan == 0 ? current.triggerR : 0;
+	}
+	return __real_PAD_TriggerR(chan);
+}
+
+void __wrap_PAD_GetOrigin(PADStatus *origin) {
+	__real_PAD_GetOrigin(origin);
+	if (state == SESSION_REPLAYING) {
+		origin[0].button = session.origin.buttons;
+		origin[0].stickX = session.origin.stickX;
+		origin[0].stickY = session.origin.stickY;
+		origin[0].substickX = session.origin.substickX;
+		origin[0].substickY = session.origin.substickY;
+		origin[0].triggerL = session.origin.triggerL;
+		origin[0].triggerR = session.origin.triggerR;
+	}
+}
+
+#endif
@@ -0,0 +1,44 @@
+//
+// Created on 2026/10/18.
+//
+
+// session record and replay on the console, only built with SESSION=1 (make session)
+// the PAD_* functions are wrapped at link time, so the menus don't know a replay is happening
+// while recording, every scan is passed through and logged
+// while replaying, scans return the logged state for the current frame instead of the controller,
+// until the log runs out and the real controller takes over again
+
+#ifndef GTS_SESSIONPAD_H
+#define GTS_SESSIONPAD_H
+
+#ifdef SESSION
+
+#include <gccore.h>
+
+#define SESSION_PATH "/GTS/session.gts"
+#define SESSION_REPORT_PATH "/GTS/replay.txt"
+
+// needs to be called from the retrace callback, frames are counted from here
+void sessionPad_onRetrace();
+
+// start logging scans, returns 0 on success, 1 if the buffer couldn't be allocated
+int sessionPad_startRecording();
+
+// load a session and start feeding it to the menus
+// returns 0 on success, 1 if the file couldn't be opened, 2 if it isn't a session, 3 if it was recorded
+// in a different scan mode, 4 if the buffer couldn't be allocated
+int sessionPad_startReplay(const char *path);
+
+// stop recording and write the log, returns 0 on success
+int sessionPad_save(const char *path);
+
+bool sessionPad_isRecording();
+bool sessionPad_isReplaying();
+// true once a replay has reached the end of its log
+bool sessionPad_replayFinished();
+// the recording buffer filled up and later input wasn't logged
+bool sessionPad_isFull();
+
+#endif
+
+#endif //GTS_SESSIONPAD_H
@@ -0,0 +1,242 @@
+//
+// Created on 2026/10/18.
+//
+
+#include "soakstats.h"
+#include <string.h>
+#include <math.h>
+
+void p2_init(P2Quantile *q, float p) {
+	memset(q, 0, sizeof(P2Quantile));
+	q->p = p;
+}
+
+void p2_add(P2Quantile *q, float value) {
+	// the first five values just fill the markers
+	if (q->count < 5) {
+		q->height[q->count] = value;
+		q->count++;
+		if (q->count == 5) {
+			// insertion sort, it's five values
+			for (int i = 1; i < 5; i++) {
+				float curr = q->height[i];
+				int j = i - 1;
+				while (j >= 0 && q->height[j] > curr) {
+					q->height[j + 1] = q->height[j];
+					j--;
+				}
+				q->height[j + 1] = curr;
+			}
+			for (int i = 0; i < 5; i++) {
+				q->pos[i] = i + 1;
+			}
+			q->desired[0] = 1;
+			q->desired[1] = 1 + (2 * q->p);
+			q->desired[2] = 1 + (4 * q->p);
+			q->desired[3] = 3 + (2 * q->p);
+			q->desired[4] = 5;
+			q->increment[0] = 0;
+			q->increment[1] = q->p / 2;
+			q->increment[2] = q->p;
+			q->increment[3] = (1 + q->p) / 2;
+			q->increment[4] = 1;
+		}
+		return;
+	}
+
+	// find the cell the value lands in, extending the outer markers if needed
+	int k;
+	if (value < q->height[0]) {
+		q->height[0] = value;
+		k = 0;
+	} else if (value >= q->height[4]) {
+		q->height[4] = value;
+		k = 3;
+	} else {
+		k = 0;
+		while (k < 3 && value >= q->height[k + 1]) {
+			k++;
+		}
+	}
+
+	for (int i = k + 1; i < 5; i++) {
+		q->pos[i] += 1;
+	}
+	for (int i = 0; i < 5; i++) {
+		q->desired[i] += q->increment[i];
+	}
+
+	// move the middle markers toward where they should be
+	for (int i = 1; i < 4; i++) {
+		double diff = q->desired[i] - q->pos[i];
+		if ((diff >= 1 && q->pos[i + 1] - q->pos[i] > 1) || (diff <= -1 && q->pos[i - 1] - q->pos[i] < -1)) {
+			int dir = (diff >= 0) ? 1 : -1;
+			// piecewise parabolic prediction
+			double newHeight = q->height[i] + (dir / (q->pos[i + 1] - q->pos[i - 1])) *
+			                   ((q->pos[i] - q->pos[i - 1] + dir) * (q->height[i + 1] - q->height[i]) / (q->pos[i + 1] - q->pos[i]) +
+			                    (q->pos[i + 1] - q->pos[i] - dir) * (q->height[i] - q->height[i - 1]) / (q->pos[i] - q->pos[i - 1]));
+			// fall back to linear if the parabola overshoots a neighbor
+			if (newHeight <= q->height[i - 1] || newHeight >= q->height[i + 1]) {
+				newHeight = q->height[i] + dir * (q->height[i + dir] - q->height[i]) / (q->pos[i + dir] - q->pos[i]);
+			}
+			q->height[i] = newHeight;
+			q->pos[i] += dir;
+		}
+	}
+	q->count++;
+}
+
+float p2_get(const P2Quantile *q) {
+	if (q->count >= 5) {
+		return q->height[2];
+	}
+	if (q->count == 0) {
+		return 0;
+	}
+	// not enough values for the markers yet, just sort what we have
+	float sorted[5];
+	memcpy(sorted, q->height, sizeof(sorted));
+	for (int i = 1; i < (int) q->count; i++) {
+		float curr = sorted[i];
+		int j = i - 1;
+		while (j >= 0 && sorted[j] > curr) {
+			sorted[j + 1] = sorted[j];
+			j--;
+		}
+		sorted[j + 1] = curr;
+	}
+	return sorted[(int) (q->p * (q->count - 1) + 0.5f)];
+}
+
+void soakStats_reset(SoakStats *stats) {
+	memset(stats, 0, sizeof(SoakStats));
+	for (int i = 0; i < SOAK_AXES; i++) {
+		stats->axis[i].min = INT8_MAX;
+		stats->axis[i].max = INT8_MIN;
+		for (int j = 0; j < SOAK_QUANTILE_LEN; j++) {
+			p2_init(&stats->axis[i].quantiles[j], SOAK_QUANTILES[j]);
+		}
+	}
+	stats->driftBucketUs = SOAK_DRIFT_START_US;
+	stats->intervalMinUs = UINT32_MAX;
+}
+
+// merge neighboring drift buckets, halving how many are used
+static void compactDrift(SoakStats *stats) {
+	for (uint32_t i = 0; i < SOAK_DRIFT_BUCKETS / 2; i++) {
+		for (int j = 0; j < SOAK_AXES; j++) {
+			stats->drift[i].sum[j] = stats->drift[i * 2].sum[j] + stats->drift[(i * 2) + 1].sum[j];
+			stats->drift[i].count[j] = stats->drift[i * 2].count[j] + stats->drift[(i * 2) + 1].count[j];
+		}
+	}
+	memset(&stats->drift[SOAK_DRIFT_BUCKETS / 2], 0, sizeof(SoakDriftBucket) * (SOAK_DRIFT_BUCKETS - (SOAK_DRIFT_BUCKETS / 2)));
+	stats->driftBucketUs *= 2;
+}
+
+static bool isResting(int8_t x, int8_t y) {
+	return x >= -SOAK_REST_RANGE && x <= SOAK_REST_RANGE && y >= -SOAK_REST_RANGE && y <= SOAK_REST_RANGE;
+}
+
+void soakStats_add(SoakStats *stats, const SoakSample *sample) {
+	// the first sample doesn't have a meaningful interval
+	if (stats->samples != 0) {
+		stats->elapsedUs += sample->intervalUs;
+		if (sample->intervalUs < stats->intervalMinUs) {
+			stats->intervalMinUs = sample->intervalUs;
+		}
+		if (sample->intervalUs > stats->intervalMaxUs) {
+			stats->intervalMaxUs = sample->intervalUs;
+		}
+		stats->intervalSumSquares += ((uint64_t) sample->intervalUs) * sample->intervalUs;
+		if (sample->intervalUs > SOAK_GAP_US) {
+			stats->gaps++;
+		}
+	}
+	stats->samples++;
+
+	uint64_t bucket = stats->elapsedUs / stats->driftBucketUs;
+	while (bucket >= SOAK_DRIFT_BUCKETS) {
+		compactDrift(stats);
+		bucket = stats->elapsedUs / stats->driftBucketUs;
+	}
+	stats->driftUsed = bucket + 1;
+
+	bool resting[SOAK_AXES];
+	resting[SOAK_AX] = resting[SOAK_AY] = isResting(sample->axis[SOAK_AX], sample->axis[SOAK_AY]);
+	resting[SOAK_CX] = resting[SOAK_CY] = isResting(sample->axis[SOAK_CX], sample->axis[SOAK_CY]);
+
+	for (int i = 0; i < SOAK_AXES; i++) {
+		SoakAxisStats *curr = &stats->axis[i];
+		int8_t value = sample->axis[i];
+		if (value < curr->min) {
+			curr->min = value;
+		}
+		if (value > curr->max) {
+			curr->max = value;
+		}
+		for (int j = 0; j < SOAK_QUANTILE_LEN; j++) {
+			p2_add(&curr->quantiles[j], value);
+		}
+
+		if (resting[i]) {
+			curr->restHistogram[value + SOAK_REST_RANGE]++;
+			curr->restCount++;
+			curr->restSum += value;
+			curr->restSumSquares += value * value;
+			stats->drift[bucket].sum[i] += value;
+			stats->drift[bucket].count[i]++;
+		}
+	}
+}
+
+bool soakStats_rest(const SoakStats *stats, enum SOAK_AXIS axis, float *mean, float *stdDev) {
+	const SoakAxisStats *curr = &stats->axis[axis];
+	if (curr->restCount == 0) {
+		return false;
+	}
+	double m = (double) curr->restSum / curr->restCount;
+	double variance = ((double) curr->restSumSquares / curr->restCount) - (m * m);
+	*mean = m;
+	*stdDev = (variance > 0) ? sqrt(variance) : 0;
+	return true;
+}
+
+bool soakStats_driftMean(const SoakStats *stats, uint32_t bucket, enum SOAK_AXIS axis, float *mean) {
+	if (bucket >= stats->driftUsed || stats->drift[bucket].count[axis] == 0) {
+		return false;
+	}
+	*mean = (double) stats->drift[bucket].sum[axis] / stats->drift[bucket].count[axis];
+	return true;
+}
+
+float soakStats_driftRange(const SoakStats *stats, enum SOAK_AXIS axis) {
+	bool found = false;
+	float low = 0, high = 0;
+	for (uint32_t i = 0; i < stats->driftUsed; i++) {
+		float mean;
+		if (!soakStats_driftMean(stats, i, axis, &mean)) {
+			continue;
+		}
+		if (!found || mean < low) {
+			low = mean;
+		}
+		if (!found || mean > high) {
+			high = mean;
+		}
+		found = true;
+	}
+	return high - low;
+}
+
+void soakStats_interval(const SoakStats *stats, float *meanUs, float *stdDevUs) {
+	if (stats->samples < 2) {
+		*meanUs = 0;
+		*stdDevUs = 0;
+		return;
+	}
+	double n = stats->samples - 1;
+	double m = stats->elapsedUs / n;
+	double variance = (stats->intervalSumSquares / n) - (m * m);
+	*meanUs = m;
+	*stdDevUs = (variance > 0) ? sqrt(variance) : 0;
+}
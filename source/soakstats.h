@@ -0,0 +1,99 @@
+//
+// Created on 2026/10/18.
+//
+
+// constant memory statistics for long running (soak) tests
+// every poll gets fed in once, and nothing about the individual samples is kept
+
+#ifndef GTS_SOAKSTATS_H
+#define GTS_SOAKSTATS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+enum SOAK_AXIS { SOAK_AX, SOAK_AY, SOAK_CX, SOAK_CY, SOAK_AXES };
+
+// quantiles tracked for every axis
+#define SOAK_QUANTILE_LEN 3
+static const float SOAK_QUANTILES[SOAK_QUANTILE_LEN] = { 0.01f, 0.5f, 0.99f };
+
+// a stick counts as resting when both of its axes are within this distance of zero
+#define SOAK_REST_RANGE 16
+#define SOAK_REST_BINS ((SOAK_REST_RANGE * 2) + 1)
+
+// drift is tracked as the resting center for each time bucket
+// when the buckets run out, neighbors get merged and the bucket length doubles,
+// so a run of any length fits in the same space
+#define SOAK_DRIFT_BUCKETS 120
+#define SOAK_DRIFT_START_US 10000000ull
+
+// polls further apart than this count as a gap
+#define SOAK_GAP_US 2000
+
+typedef struct SoakSample {
+	int8_t axis[SOAK_AXES];
+	// time from the previous poll
+	uint32_t intervalUs;
+} SoakSample;
+
+// P² quantile estimator (Jain & Chlamtac, 1985), five markers regardless of how many samples are added
+typedef struct P2Quantile {
+	float p;
+	uint32_t count;
+	float height[5];
+	// positions need doubles, a float stops counting up by one after ~16 million samples
+	double pos[5];
+	double desired[5];
+	double increment[5];
+} P2Quantile;
+
+typedef struct SoakAxisStats {
+	int8_t min;
+	int8_t max;
+	P2Quantile quantiles[SOAK_QUANTILE_LEN];
+	// histogram of the axis value while its stick is resting, index 0 is -SOAK_REST_RANGE
+	uint32_t restHistogram[SOAK_REST_BINS];
+	uint64_t restCount;
+	int64_t restSum;
+	uint64_t restSumSquares;
+} SoakAxisStats;
+
+typedef struct SoakDriftBucket {
+	int64_t sum[SOAK_AXES];
+	uint32_t count[SOAK_AXES];
+} SoakDriftBucket;
+
+typedef struct SoakStats {
+	uint64_t samples;
+	uint64_t elapsedUs;
+	SoakAxisStats axis[SOAK_AXES];
+
+	SoakDriftBucket drift[SOAK_DRIFT_BUCKETS];
+	uint32_t driftUsed;
+	uint64_t driftBucketUs;
+
+	uint32_t intervalMinUs;
+	uint32_t intervalMaxUs;
+	uint64_t intervalSumSquares;
+	uint32_t gaps;
+} SoakStats;
+
+void p2_init(P2Quantile *q, float p);
+void p2_add(P2Quantile *q, float value);
+float p2_get(const P2Quantile *q);
+
+void soakStats_reset(SoakStats *stats);
+void soakStats_add(SoakStats *stats, const SoakSample *sample);
+
+// mean and standard deviation of an axis while resting, returns false if it hasn't rested yet
+bool soakStats_rest(const SoakStats *stats, enum SOAK_AXIS axis, float *mean, float *stdDev);
+
+// resting center of an axis during a drift bucket, returns false if the stick never rested in that bucket
+bool soakStats_driftMean(const SoakStats *stats, uint32_t bucket, enum SOAK_AXIS axis, float *mean);
+
+// largest difference between the resting centers of any two drift buckets
+float soakStats_driftRange(const SoakStats *stats, enum SOAK_AXIS axis);
+
+void soakStats_interval(const SoakStats *stats, float *meanUs, float *stdDevUs);
+
+#endif //GTS_SOAKSTATS_H
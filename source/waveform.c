@@ -5,15 +5,9 @@
 #include "waveform.h"
 #include <stdlib.h>
 #include <gccore.h>
-#include <math.h>
 #include <ogc/lwp_watchdog.h>
-#include "gecko.h"
 #include "polling.h"
 
-#ifdef DEBUGLOG
-#include <string.h>
-#endif
-
 #define STICK_MOVEMENT_THRESHOLD 2
 #define STICK_MOVEMENT_TIME_US 250000 // 250 ms
 
@@ -37,12 +31,10 @@ void samplingCallback() {
 }
 
 void measureWaveform(WaveformData *data) {
-	// reset old data
-	for (int i = 0; i < WAVEFORM_SAMPLES; i++) {
-		data->data[i] = (WaveformDatapoint) { .ax = 0, .ay = 0, .cx = 0, .cy = 0, .timeDiffUs = 0,
-						  .isAXNegative = false, .isAYNegative = false, .isCXNegative = false, .isCYNegative = false } ;
-	}
+	// samples past endPoint are left as they were, nothing reads them
+	// every field of the ones before it is written below, the slot can still hold an older capture
 	data->exported = false;
+	data->testType = -1;
 	
 	setSamplingRateHigh();
 	
@@ -105,11 +97,16 @@ void measureWaveform(WaveformData *data) {
 		prevPollDiffY = currPollY - prevPollY;
 
 		// add data
-		data->data[data->endPoint].ax = currPollX;
-		data->data[data->endPoint].ay = currPollY;
-		if (data->endPoint == 0) {
-			data->data[0].timeDiffUs = 0;
-		} else {
+		u32 held = PAD_ButtonsHeld(0);
+		data->data[data->endPoint] = (WaveformDatapoint) {
+			.ax = currPollX, .ay = currPollY,
+			.cx = PAD_SubStickX(0), .cy = PAD_SubStickY(0),
+			.tl = PAD_TriggerL(0), .tr = PAD_TriggerR(0),
+			.isDigitalLPressed = (held & PAD_TRIGGER_L) != 0,
+			.isDigitalRPressed = (held & PAD_TRIGGER_R) != 0,
+			.timeDiffUs = 0
+		};
+		if (data->endPoint != 0) {
 			data->data[data->endPoint].timeDiffUs = ticks_to_microsecs(sampleCallbackTick - prevSampleCallbackTick);
 		}
 		data->endPoint++;
@@ -156,54 +153,3 @@ void measureWaveform(WaveformData *data) {
 	}
 	// polling rate gets reset by main loop, no need to do it here
 }
-
-
-// a lot of this comes from github.com/phobgcc/phobconfigtool
-WaveformDatapoint convertStickValues(WaveformDatapoint *data) {
-	WaveformDatapoint retData;
-
-	retData.ax = data->ax, retData.ay = data->ay;
-	retData.cx = data->cx, retData.cy = data->cy;
-	
-	// store whether x or y are negative
-	retData.isAXNegative = (retData.ax < 0) ? true : false;
-	retData.isAYNegative = (retData.ay < 0) ? true : false;
-	retData.isCXNegative = (retData.cx < 0) ? true : false;
-	retData.isCYNegative = (retData.cy < 0) ? true : false;
-	
-	float floatStickX = retData.ax, floatStickY = retData.ay;
-	float floatCStickX = retData.cx, floatCStickY = retData.cy;
-
-	float stickMagnitude = sqrt((retData.ax * retData.ax) + (retData.ay * retData.ay));
-	float cStickMagnitude = sqrt((retData.cx * retData.cx) + (retData.cy * retData.cy));
-
-	// magnitude must be between 0 and 80
-	if (stickMagnitude > 80) {
-		// scale stick value to be within range
-		floatStickX = (floatStickX / stickMagnitude) * 80;
-		floatStickY = (floatStickY / stickMagnitude) * 80;
-	}
-	if (cStickMagnitude > 80) {
-		// scale stick value to be within range
-		floatCStickX = (floatCStickX / cStickMagnitude) * 80;
-		floatCStickY = (floatCStickY / cStickMagnitude) * 80;
-	}
-	
-	// truncate the floats
-	retData.ax = (int) floatStickX, retData.ay = (int) floatStickY;
-	retData.cx = (int) floatCStickX, retData.cy = (int) floatCStickY;
-
-	// convert to the decimal format for melee
-	retData.ax = (((float) retData.ax) * 0.0125) * 10000;
-	retData.ay = (((float) retData.ay) * 0.0125) * 10000;
-	retData.cx = (((float) retData.cx) * 0.0125) * 10000;
-	retData.cy = (((float) retData.cy) * 0.0125) * 10000;
-
-	// get rid of any negative values
-	retData.ax = abs(retData.ax), retData.ay = abs(retData.ay);
-	retData.cx = abs(retData.cx), retData.cy = abs(retData.cy);
-
-	return retData;
-}
-
-
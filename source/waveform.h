@@ -5,7 +5,9 @@
 #ifndef GTS_WAVEFORM_H
 #define GTS_WAVEFORM_H
 
-#include <gccore.h>
+// kept free of libogc, the analysis code and host tools use these structs too
+#include <stdint.h>
+#include <stdbool.h>
 
 #define WAVEFORM_SAMPLES 3000
 // individual datapoint from polling
@@ -16,8 +18,14 @@ typedef struct WaveformDatapoint {
 	// c stick
 	int cx;
 	int cy;
+	// analog triggers
+	int tl;
+	int tr;
+	// digital trigger state, for comparing against the analog value
+	bool isDigitalLPressed;
+	bool isDigitalRPressed;
 	// time from last datapoint
-	u64 timeDiffUs;
+	uint64_t timeDiffUs;
 	// for converted values
 	bool isAXNegative;
 	bool isAYNegative;
@@ -30,7 +38,7 @@ typedef struct WaveformData {
 	unsigned int endPoint;
 
 	// total time the read took
-	u64 totalTimeUs;
+	uint64_t totalTimeUs;
 	
 	bool isDataReady;
 	
@@ -39,6 +47,9 @@ typedef struct WaveformData {
 	
 	bool exported;
 
+	// enum OSCILLOSCOPE_TEST the capture was made with, -1 if it isn't known
+	int testType;
+
 } WaveformData;
 
 //enum CONTROLLER_STICKS_XY { A_STICK_X, A_STICK_Y, C_STICK_X, C_STICK_Y };
@@ -46,9 +57,6 @@ typedef struct WaveformData {
 // function that reads inputs at a high rate
 void measureWaveform(WaveformData *data);
 
-// converts raw input values to melee coordinates
-WaveformDatapoint convertStickValues(WaveformDatapoint *data);
-
 //char* meleeCoord(WaveformDatapoint data, enum CONTROLLER_STICKS_XY axis);
 //char* meleeCoord(int coord);
 